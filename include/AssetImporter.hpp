@@ -0,0 +1,63 @@
+#pragma once
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Python.hpp"
+
+struct zip_t;
+
+namespace Cinema {
+
+    /// Imports pure Python modules straight from the zips embedded in the mod, without extracting them
+    /// Native modules and everything imported before Install still have to be on disk
+    class AssetImporter {
+        public:
+            /// Makes the modules below pathPrefix in the zip importable, named modulePrefix.<path>
+            static void Register(std::string_view data, std::string_view pathPrefix, std::string_view modulePrefix, std::string_view extractedPath);
+            /// Adds the importer to sys.meta_path, needs the GIL. Call it right after the interpreter started,
+            /// the modules loaded by then are recorded as the ones that have to be extracted
+            static void Install();
+
+            /// Reads the modules the interpreter imported while starting last time, false if there is no record for this runtime
+            static bool LoadBootstrapModules(std::string_view runtimeData, std::string_view path);
+            /// true for entries of the Python runtime zip the importer serves, i.e. the ones that don't need extracting
+            /// Without a record from LoadBootstrapModules nothing is, so the whole runtime gets extracted
+            static bool IsImportable(std::string_view entryName);
+
+            static constexpr const char* STDLIB_PREFIX = "usr/lib/python3.8/";
+
+        private:
+            struct Module {
+                std::size_t archive;
+                std::size_t index;
+                bool isPackage;
+                /// Compiled entry from __pycache__, preferred over the source
+                bool isBytecode;
+                /// Source entry next to the compiled one, used when the bytecode is for another interpreter, -1 if there is none
+                Python::Py_ssize_t sourceIndex;
+                /// Where the package lives on disk, so extracted native submodules are still found
+                std::string location;
+                /// Where the module's source would be in the extracted tree, its __file__
+                std::string origin;
+            };
+
+            static Python::PyObject* Find(Python::PyObject* self, Python::PyObject* args);
+            static Python::PyObject* Read(Python::PyObject* self, Python::PyObject* args);
+
+            static std::vector<zip_t*> archives;
+            static std::unordered_map<std::string, Module> modules;
+            /// zip handles aren't thread safe
+            static std::mutex mutex;
+
+            /// Top level modules imported before Install, nullopt until a matching record was read
+            static std::optional<std::unordered_set<std::string>> bootstrapModules;
+            static std::string bootstrapPath;
+            /// Identifies the runtime the record was written for
+            static std::string bootstrapStamp;
+    };
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "main.hpp"
+#include "UnityEngine/GameObject.hpp"
+#include "UnityEngine/Material.hpp"
+#include "UnityEngine/Renderer.hpp"
+#include "UnityEngine/Shader.hpp"
+#include "UnityEngine/Vector3.hpp"
+
+namespace Cinema {
+
+    /// The screen the video is rendered on, created once and kept across scene transitions
+    class CinemaScreen {
+        public:
+            /// Activates the screen at the given placement and returns its renderer
+            static UnityEngine::Renderer* Show(UnityEngine::Vector3 position, UnityEngine::Vector3 rotation, UnityEngine::Vector3 scale);
+            static void Hide();
+
+        private:
+            static bool IsAlive(UnityEngine::Object* object);
+            /// Returns the screen material, creates a new one if there is none or it was destroyed
+            static UnityEngine::Material* GetMaterial();
+            static void Create();
+
+            static UnityEngine::GameObject* screen;
+            static UnityEngine::Renderer* renderer;
+            static UnityEngine::Material* material;
+            static UnityEngine::Shader* shader;
+    };
+}
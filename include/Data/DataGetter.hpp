@@ -3,8 +3,13 @@
 #include <filesystem>
 #include <fstream>
 #include <future>
+#include <chrono>
 #include <unordered_map>
 #include <istream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace SongDetailsCache {
     class DataGetter {
@@ -16,17 +21,26 @@ namespace SongDetailsCache {
             };
 
             static const std::unordered_map<std::string, std::string> dataSources;
+            /// Turns on delta updates for a data source. The endpoint serves only the maps changed since a scrape, as a SongProtoContainer
+            /// like the full database, and urlFormat gets the unix time of the scrape the client has. None of the public sources has one,
+            /// so updates stay full downloads unless this is called before loading
+            static void SetDeltaSource(std::string_view dataSourceName, std::string urlFormat);
+            static bool HasDeltaSource(std::string_view dataSourceName);
             static std::filesystem::path cachePath();
             static std::filesystem::path cachePathEtag(std::string_view source);
 
             static std::future<std::optional<DownloadedDatabase>> UpdateAndReadDatabase(std::string_view dataSourceName = "Direct");
+            static std::future<std::optional<DownloadedDatabase>> UpdateAndReadDelta(std::chrono::sys_seconds since, std::string_view dataSourceName = "Direct");
             static std::future<void> WriteCachedDatabase(DownloadedDatabase& db);
             static std::optional<std::ifstream> ReadCachedDatabase();
             static bool HasCachedData(int maximumAgeHours = 12);
         private:
             static std::filesystem::path basePath;
+            static std::unordered_map<std::string, std::string> deltaSources;
             friend class SongDetails;
+            friend struct SongDetailsTestAccess;
             static void WriteCachedDatabase_internal(DownloadedDatabase& db);
             static std::optional<DownloadedDatabase> UpdateAndReadDatabase_internal(std::string_view dataSourceName = "Direct");
+            static std::optional<DownloadedDatabase> UpdateAndReadDelta_internal(std::chrono::sys_seconds since, std::string dataSourceName);
     };
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+#include <limits>
+
+namespace SongDetailsCache {
+    /// Range filters over the difficulties, evaluated a column at a time instead of calling a function per difficulty
+    struct DifficultyQuery {
+        /// Inclusive, the default range lets everything through and is skipped
+        template<typename T>
+        struct Range {
+            T min = std::numeric_limits<T>::lowest();
+            T max = std::numeric_limits<T>::max();
+
+            bool active() const noexcept { return min != std::numeric_limits<T>::lowest() || max != std::numeric_limits<T>::max(); }
+        };
+
+        Range<float> stars;
+        Range<float> njs;
+        Range<uint32_t> notes;
+        Range<uint32_t> bombs;
+        /// Bit (1 << value) for every accepted MapCharacteristic and MapDifficulty
+        uint32_t characteristics = std::numeric_limits<uint32_t>::max();
+        uint32_t difficulties = std::numeric_limits<uint32_t>::max();
+    };
+}
@@ -2,12 +2,23 @@
 
 #include "beatsaber-hook/shared/utils/typedefs-wrappers.hpp"
 #include <stdint.h>
+#include <array>
+#include <atomic>
+#include <mutex>
 #include <vector>
 #include <future>
 #include <istream>
 #include <chrono>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string_view>
 
 #include "song-details/shared/Data/Song.hpp"
+#include "Data/DifficultyQuery.hpp"
+#include "Data/StringPool.hpp"
+#include "Data/SongSearchIndex.hpp"
+#include "Data/SongSortKey.hpp"
 
 namespace SongDetailsCache {
     template<typename T>
@@ -17,7 +28,17 @@ namespace SongDetailsCache {
     inline shared_ptr_vector<T> make_shared_vec() { return std::make_shared<std::vector<T>>(); }
     namespace Structs {
         class SongProtoContainer;
+        class SongProto;
+        class SongDifficultyProto;
     }
+    class SongDetailsSnapshot;
+}
+
+namespace google::protobuf::io {
+    class ZeroCopyInputStream;
+}
+
+namespace SongDetailsCache {
     #pragma pack(push, 1)
     struct SongHash {
         public:
@@ -36,9 +57,60 @@ namespace SongDetailsCache {
     #pragma pack(pop)
     static_assert(sizeof(SongHash) == (sizeof(uint8_t) * 20), "SongHashes should be 20 bytes");
 
+    /// Songs found by a query. The list holds on to the database they are in, so the songs stay valid
+    /// for as long as the list exists even if an update replaces the database meanwhile
+    class SongList {
+        public:
+            using const_iterator = std::vector<const Song*>::const_iterator;
+
+            SongList() = default;
+
+            std::size_t size() const noexcept { return songs.size(); }
+            bool empty() const noexcept { return songs.empty(); }
+            const Song& operator[](std::size_t index) const noexcept { return *songs[index]; }
+            const_iterator begin() const noexcept { return songs.begin(); }
+            const_iterator end() const noexcept { return songs.end(); }
+            const std::vector<const Song*>& get_songs() const noexcept { return songs; }
+
+        private:
+            friend class SongDetailsContainer;
+
+            SongList(std::shared_ptr<const void> owner, std::vector<const Song*>&& songs) noexcept : owner(std::move(owner)), songs(std::move(songs)) {}
+
+            std::shared_ptr<const void> owner;
+            std::vector<const Song*> songs;
+    };
+
     class SongDetailsContainer {
         public:
             static std::future<void> Load(bool reload = false, int acceptableAgeHours = 1);
+
+            /// The song with this level hash, an empty list if it isn't in the database.
+            /// The list keeps the database alive, so the song stays valid across updates
+            static SongList FindByHash(const SongHash& hash);
+            /// 40 hex characters, an empty list if it isn't a hash or not in the database
+            static SongList FindByHash(std::string_view hash);
+            static SongList FindByHash(const std::string& hash) { return FindByHash(std::string_view(hash)); }
+            static SongList FindByMapId(uint32_t mapId);
+
+            /// Same as the SongDetails functions taking a DifficultyFilterFunction, but vectorized over the difficulty columns
+            static std::vector<std::size_t> FindSongIndexes(const DifficultyQuery& query);
+            static SongList FindSongs(const DifficultyQuery& query);
+            static std::size_t CountSongs(const DifficultyQuery& query);
+
+            /// Songs with a name, author, mapper or uploader word starting with every word of the query, case and accents ignored.
+            /// Best rated first, then most downloaded
+            static SongList Search(std::string_view query, std::size_t limit = 50);
+
+            /// Up to limit songs with min <= value <= max, from the lowest value up or from the highest down
+            static SongList FindSongsInRange(SongSortKey key, double min, double max, std::size_t limit = std::numeric_limits<std::size_t>::max(), bool descending = false);
+            /// The limit songs with the highest value, or the lowest ones
+            static SongList TopSongs(SongSortKey key, std::size_t limit, bool descending = true);
+
+            /// Same strings as the Song getters, without going through std::string
+            static std::string_view get_songAuthorName(const Song& song) noexcept { return song.songAuthorName(); }
+            static std::string_view get_levelAuthorName(const Song& song) noexcept { return song.levelAuthorName(); }
+            static std::string_view get_uploaderName(const Song& song) noexcept { return song.uploaderName(); }
         private:
             friend struct Song;
             friend struct SongDifficulty;
@@ -47,24 +119,166 @@ namespace SongDetailsCache {
             friend class HexUtil;
             friend class SongArray;
             friend class DiffArray;
+            friend class SongDetailsSnapshot;
+            /// The tests, see test/SongDetailsTestUtils.hpp
+            friend struct SongDetailsTestAccess;
 
             static constexpr const int HASH_SIZE_BYTES = 20;
             static_assert(HASH_SIZE_BYTES == sizeof(SongHash), "Song hashes should be 20 bytes");
-            static shared_ptr_vector<uint32_t> keys;
-            static shared_ptr_vector<SongHash> hashBytes;
-            static shared_ptr_vector<uint32_t> hashBytesLUT;
-            static shared_ptr_vector<std::string> songNames;
-            static shared_ptr_vector<std::string> songAuthorNames;
-            static shared_ptr_vector<std::string> levelAuthorNames;
-            static shared_ptr_vector<std::string> uploaderNames;
-
-            static std::chrono::sys_seconds scrapeEndedTimeUnix;
+
+            /// Open addressing slot, the first 4 hash bytes are kept next to the index so most probes never touch hashBytes
+            struct HashSlot {
+                uint32_t prefix;
+                uint32_t index;
+            };
+            static constexpr const uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+
             static std::chrono::seconds updateThrottle;
 
-            static shared_ptr_vector<Song> songs;
-            static shared_ptr_vector<SongDifficulty> difficulties;
+            static bool get_isDataAvailable() { return !get_state()->columns.songs->empty(); }
+
+            /// The difficulties again with one array per field, what the filter kernels scan.
+            /// Every array is padded with zeros to a multiple of BLOCK_SIZE so the kernels never need a scalar tail
+            struct DifficultyColumns {
+                static constexpr const std::size_t BLOCK_SIZE = 64;
+
+                std::size_t size = 0;
+                std::vector<uint32_t> songIndex;
+                /// Hundredths like in the proto, saturated at 655.35
+                std::vector<uint16_t> starsT100;
+                std::vector<uint16_t> njsT100;
+                std::vector<uint32_t> notes;
+                std::vector<uint32_t> bombs;
+                std::vector<uint32_t> obstacles;
+                std::vector<uint8_t> characteristic;
+                std::vector<uint8_t> difficulty;
+                std::vector<uint8_t> mods;
+
+                float get_stars(std::size_t index) const noexcept { return starsT100[index] / 100.0f; }
+                float get_njs(std::size_t index) const noexcept { return njsT100[index] / 100.0f; }
+                /// Bytes of all arrays, padding included
+                std::size_t get_byteSize() const noexcept;
+
+                explicit DifficultyColumns(const std::vector<SongDifficulty>& difficulties);
+                /// Copies the sections of the snapshot, which are laid out the same way
+                explicit DifficultyColumns(const SongDetailsSnapshot& snapshot);
+                DifficultyColumns() = default;
+            };
+
+            /// What the Song getters used to work out from the difficulties on every call, by song index
+            struct SongAggregates {
+                std::vector<float> minNJS;
+                std::vector<float> maxNJS;
+                std::vector<float> minStar;
+                std::vector<float> maxStar;
+                std::vector<float> minPP;
+                std::vector<float> maxPP;
+                std::vector<float> rating;
+
+                SongAggregates(const std::vector<Song>& songs, const std::vector<SongDifficulty>& difficulties);
+                SongAggregates() = default;
+            };
+
+            /// Song indexes ordered by each SongSortKey, each built on first use. Publish swaps in an empty one
+            struct SortedIndexes {
+                static constexpr const std::size_t KEY_COUNT = static_cast<std::size_t>(SongSortKey::Count);
+
+                /// The columns the orders are about, queries never mix them with newer ones
+                shared_ptr_vector<Song> songs = make_shared_vec<Song>();
+                std::shared_ptr<SongAggregates> aggregates = std::make_shared<SongAggregates>();
+                std::array<std::vector<uint32_t>, KEY_COUNT> orders;
+                std::array<std::once_flag, KEY_COUNT> built;
+
+                double get_value(SongSortKey key, uint32_t index) const noexcept;
+                /// Ascending by value, ties by index
+                const std::vector<uint32_t>& get_order(SongSortKey key);
+            };
+
+            /// One bit per difficulty that passes every active filter of the query
+            static std::vector<uint64_t> Evaluate(const DifficultyColumns& columns, const DifficultyQuery& query);
+
+            /// Every column of one processed database, swapped in together once it is complete
+            struct Columns {
+                shared_ptr_vector<uint32_t> keys = make_shared_vec<uint32_t>();
+                shared_ptr_vector<SongHash> hashBytes = make_shared_vec<SongHash>();
+                shared_ptr_vector<uint32_t> hashBytesLUT = make_shared_vec<uint32_t>();
+                shared_ptr_vector<std::string> songNames = make_shared_vec<std::string>();
+                /// Ids into names, the same mappers and artists show up on thousands of songs
+                shared_ptr_vector<uint32_t> songAuthorNames = make_shared_vec<uint32_t>();
+                shared_ptr_vector<uint32_t> levelAuthorNames = make_shared_vec<uint32_t>();
+                shared_ptr_vector<uint32_t> uploaderNames = make_shared_vec<uint32_t>();
+                std::shared_ptr<StringPool> names = std::make_shared<StringPool>();
+                /// Power of two sized, at most half full
+                shared_ptr_vector<HashSlot> hashTable = make_shared_vec<HashSlot>();
+                shared_ptr_vector<uint32_t> mapIdTable = make_shared_vec<uint32_t>();
+                shared_ptr_vector<Song> songs = make_shared_vec<Song>();
+                shared_ptr_vector<SongDifficulty> difficulties = make_shared_vec<SongDifficulty>();
+                /// Empty until Publish builds them, so queries before the first database find nothing
+                std::shared_ptr<DifficultyColumns> difficultyColumns = std::make_shared<DifficultyColumns>();
+                std::shared_ptr<SongSearchIndex> searchIndex;
+                std::shared_ptr<SongAggregates> songAggregates = std::make_shared<SongAggregates>();
+
+                void reserve(std::size_t songCount, std::size_t difficultyCount);
+            };
+
+            /// One processed database. Publish swaps in a new one as a whole, nothing in it changes afterwards
+            /// except for the sort orders, which are built on first use
+            struct State {
+                Columns columns;
+                std::chrono::sys_seconds scrapeEndedTimeUnix{};
+                std::shared_ptr<SortedIndexes> sortedIndexes = std::make_shared<SortedIndexes>();
+            };
+            /// Only replaced with std::atomic_store. Readers take one snapshot with get_state and read everything through it,
+            /// so they never mix columns of two databases and keep theirs alive while they use it
+            static std::shared_ptr<const State> state;
+            static std::shared_ptr<const State> get_state() noexcept { return std::atomic_load(&state); }
+            /// The same state as a raw pointer for the Song getters, which run far too often for the atomic shared_ptr.
+            /// generations pins it, so it stays valid until the Publish after the one that replaced it
+            static std::atomic<const State*> currentState;
+            /// The state a Song getter reads. That is the older state whose songs the song lies in, if any, else the current one by index
+            /// like the getters always did for copied songs. nullptr for Song::none and indexes past the end
+            static const State* get_songState(const Song& song) noexcept;
+
+            struct Generation {
+                std::weak_ptr<const State> state;
+                /// Held for the current state and the one it replaced, a reader may still have the latter from currentState
+                std::shared_ptr<const State> pinned;
+                /// Where its songs lie, so getters only lock for songs that really are in an older state
+                const Song* songsBegin;
+                const Song* songsEnd;
+
+                explicit Generation(const std::shared_ptr<const State>& state) noexcept;
+            };
+            /// Every state that may still be alive, newest last
+            static std::mutex generationsMutex;
+            static std::vector<Generation> generations;
+            /// Spans the songs of every older generation, a song outside of it is read from currentState without locking
+            static std::atomic<const Song*> olderSongsBegin;
+            static std::atomic<const Song*> olderSongsEnd;
+            /// The columns that are published right now
+            static Columns GetColumns() { return get_state()->columns; }
+
+            /// Consecutive raw song records decoded by one thread, with the position of the first one in the final columns
+            struct Chunk {
+                std::string records;
+                std::vector<uint32_t> lengths;
+                std::size_t songOffset = 0;
+                std::size_t diffOffset = 0;
+                std::size_t diffCount = 0;
+                Columns columns;
+            };
+            static constexpr const std::size_t CHUNK_SONGS = 2048;
+            /// Threads decoding songs in Process, 0 for one per core and 1 to decode everything on the loading thread
+            static unsigned int processThreadCount;
+            static void DecodeChunk(Chunk& chunk);
+            /// Moves a decoded chunk behind the songs already in columns
+            static void AppendChunk(Columns& columns, Columns&& chunk);
 
-            static bool get_isDataAvailable() { return songs && !songs->empty(); }
+            static std::optional<std::size_t> FindHash(const Columns& columns, const SongHash& hash);
+            static std::optional<std::size_t> FindMapId(const Columns& columns, uint32_t mapId);
+            /// Fills hashTable and mapIdTable for the songs in columns
+            static void BuildLookupTables(Columns& columns);
+            static std::shared_ptr<SongSearchIndex> BuildSearchIndex(const Columns& columns);
 
             static UnorderedEventCallback<> dataAvailableOrUpdatedInternal;
             static UnorderedEventCallback<> dataLoadFailedInternal;
@@ -72,5 +286,18 @@ namespace SongDetailsCache {
             static void Process(const std::vector<uint8_t>& data, bool force = true);
             static void Process(std::istream& istream, bool force = true);
             static void Process(const Structs::SongProtoContainer& parsedContainer, bool force = true);
+            /// Decodes the gzip'd database one song at a time straight into the columns, the container is never parsed as a whole
+            static void Process(google::protobuf::io::ZeroCopyInputStream& compressed, bool force);
+            /// Appends one parsed song behind the songs already in columns, the offsets are added to its index and diffOffset
+            static void Append(Columns& columns, const Structs::SongProto& parsedSong, std::size_t songOffset = 0, std::size_t diffOffset = 0);
+            /// Copies an already processed song behind the songs in columns, its index and diffOffset change with it
+            static void AppendExisting(Columns& columns, const Columns& current, std::size_t index, Structs::SongProto& songProto, Structs::SongDifficultyProto& diffProto);
+            /// Merges new or changed songs into the current columns by mapId, false if the full database is needed instead
+            static bool ApplyDelta(const std::vector<uint8_t>& data);
+            static bool ApplyDelta(const Structs::SongProtoContainer& delta);
+            /// Loads the columns straight from a mapped snapshot, no protobuf involved
+            static void Process(const SongDetailsSnapshot& snapshot);
+            /// Builds the lookup tables, difficulty columns, song aggregates and search index if they are missing and replaces the current columns
+            static void Publish(Columns&& columns, std::chrono::sys_seconds scrapeEnded);
     };
 }
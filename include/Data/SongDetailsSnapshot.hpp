@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stdint.h>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+
+namespace SongDetailsCache {
+    /// Columnar copy of the processed database, written after every Process and mapped read only on the next start
+    /// instead of parsing the protobuf again
+    class SongDetailsSnapshot {
+        public:
+            enum class Section : uint32_t {
+                Keys,
+                Hashes,
+                /// Open addressing tables of SongDetailsContainer
+                HashTable,
+                MapIdTable,
+                Bpm,
+                DownloadCount,
+                Upvotes,
+                Downvotes,
+                UploadTime,
+                RankedChange,
+                Duration,
+                RankedState,
+                DiffOffset,
+                DiffCount,
+                DiffSong,
+                Characteristic,
+                Difficulty,
+                StarsT100,
+                NjsT100,
+                Bombs,
+                Notes,
+                Obstacles,
+                Mods,
+                /// songCount + 1 offsets into StringHeap
+                SongNames,
+                /// Ids into NamePool
+                SongAuthorNames,
+                LevelAuthorNames,
+                UploaderNames,
+                /// One more offset into StringHeap than there are distinct names
+                NamePool,
+                /// SongSearchIndex
+                SearchRanks,
+                SearchVocabulary,
+                SearchWordOffsets,
+                SearchSongWordOffsets,
+                SearchSongWords,
+                SearchPostingOffsets,
+                SearchPostings,
+                StringHeap,
+                Count
+            };
+
+            ~SongDetailsSnapshot();
+            SongDetailsSnapshot(const SongDetailsSnapshot&) = delete;
+            SongDetailsSnapshot& operator=(const SongDetailsSnapshot&) = delete;
+
+            static std::filesystem::path path();
+            /// Writes the columns currently in SongDetailsContainer, replaces the old snapshot atomically
+            static bool Write(const std::filesystem::path& path);
+            /// nullptr if there is no snapshot or it was written by another version
+            static std::unique_ptr<SongDetailsSnapshot> Open(const std::filesystem::path& path);
+
+            uint32_t get_songCount() const noexcept { return header->songCount; }
+            uint32_t get_difficultyCount() const noexcept { return header->difficultyCount; }
+            uint64_t get_scrapeEndedTimeUnix() const noexcept { return header->scrapeEndedTimeUnix; }
+
+            template<typename T>
+            std::span<const T> get_section(Section section) const noexcept {
+                auto& info = header->sections[static_cast<uint32_t>(section)];
+                return { reinterpret_cast<const T*>(base + info.offset), info.size / sizeof(T) };
+            }
+            /// Entry index of one of the name sections
+            std::string_view get_string(Section section, std::size_t index) const noexcept;
+
+        private:
+            friend struct SongDetailsTestAccess;
+
+            struct SectionInfo {
+                uint64_t offset;
+                uint64_t size;
+            };
+
+            struct Header {
+                uint32_t magic;
+                uint32_t version;
+                uint32_t songCount;
+                uint32_t difficultyCount;
+                uint64_t scrapeEndedTimeUnix;
+                SectionInfo sections[static_cast<uint32_t>(Section::Count)];
+            };
+
+            static constexpr const uint32_t MAGIC = 0x53434453; // SDCS
+            static constexpr const uint32_t VERSION = 4;
+            /// Every section starts on a cache line
+            static constexpr const uint64_t ALIGNMENT = 64;
+
+            SongDetailsSnapshot(const uint8_t* base, std::size_t size) noexcept;
+            bool IsValid() const noexcept;
+
+            const uint8_t* base;
+            std::size_t size;
+            const Header* header;
+    };
+}
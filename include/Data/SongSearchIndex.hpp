@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SongDetailsCache {
+    class SongDetailsSnapshot;
+
+    /// Word prefix index over the song, author, mapper and uploader names, built whenever new columns are published.
+    /// Songs are kept in rank order (rating, then downloads), so the first matches found are the best ones
+    class SongSearchIndex {
+        public:
+            /// Lower case with diacritics stripped, everything that isn't a letter or digit turns into a space
+            static std::string Normalize(std::string_view text);
+
+            SongSearchIndex() = default;
+            /// Copies the search sections of the snapshot
+            explicit SongSearchIndex(const SongDetailsSnapshot& snapshot);
+
+            /// Indexes of up to limit songs with a word starting with every word of the query, best ranked first
+            std::vector<uint32_t> Search(std::string_view query, std::size_t limit) const;
+
+            std::size_t get_songCount() const noexcept { return byRank.size(); }
+            std::size_t get_wordCount() const noexcept { return wordOffsets.empty() ? 0 : wordOffsets.size() - 1; }
+            /// Bytes of all arrays
+            std::size_t get_byteSize() const noexcept;
+
+        private:
+            friend class SongDetailsContainer;
+            friend class SongDetailsSnapshot;
+            friend struct SongDetailsTestAccess;
+
+            /// Word ids starting with prefix, they are sorted so that is one range
+            struct WordRange {
+                uint32_t begin;
+                uint32_t end;
+            };
+            WordRange FindPrefix(std::string_view prefix) const noexcept;
+            std::string_view get_word(uint32_t id) const noexcept { return std::string_view(vocabulary).substr(wordOffsets[id], wordOffsets[id + 1] - wordOffsets[id]); }
+            /// Whether the song at rank has a word in every range
+            bool Matches(uint32_t rank, const std::vector<WordRange>& ranges) const noexcept;
+
+            /// Song index at each rank
+            std::vector<uint32_t> byRank;
+            /// Every distinct word once, sorted, back to back
+            std::string vocabulary;
+            std::vector<uint32_t> wordOffsets;
+            /// Sorted word ids of each song, by rank
+            std::vector<uint32_t> songWordOffsets;
+            std::vector<uint32_t> songWords;
+            /// Ascending ranks of the songs containing each word
+            std::vector<uint32_t> postingOffsets;
+            std::vector<uint32_t> postings;
+    };
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace SongDetailsCache {
+    /// Song values SongDetailsContainer keeps a sorted index for
+    enum class SongSortKey : uint8_t {
+        UploadTime,
+        RankedChange,
+        Rating,
+        DownloadCount,
+        Bpm,
+        Duration,
+        Count
+    };
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SongDetailsCache {
+    /// Every distinct string once, songs keep a uint32 id instead of their own copy.
+    /// The entries stay std::strings since Song hands out const std::string&, names short enough for SSO live inside the array
+    class StringPool {
+        public:
+            /// Id of the equal entry, adding it if there is none
+            uint32_t Intern(std::string_view string);
+            uint32_t Intern(std::string&& string);
+
+            const std::string& get(uint32_t id) const noexcept { return strings[id]; }
+            std::size_t size() const noexcept { return strings.size(); }
+            /// Bytes of the entries, their heap buffers and the lookup table
+            std::size_t get_byteSize() const noexcept;
+
+            void reserve(std::size_t count);
+
+        private:
+            static constexpr const uint32_t EMPTY_SLOT = UINT32_MAX;
+
+            /// Slot of string, or the empty one it would go into
+            std::size_t Find(std::string_view string, std::size_t hash) const noexcept;
+            /// Sizes the table for count entries and inserts the current ones again
+            void Rehash(std::size_t count);
+
+            std::vector<std::string> strings;
+            /// Open addressing over the ids, power of two sized and at most half full
+            std::vector<uint32_t> table;
+    };
+}
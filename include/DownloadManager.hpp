@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Python.hpp"
+
+namespace Cinema {
+
+    /// Schedules yt-dlp downloads onto the PythonWorker from a single worker thread, never on the Unity main thread.
+    /// The PythonWorker runs one command at a time, so downloads run one after the other in priority order
+    /// Progress and completion callbacks are delivered on the main thread
+    class DownloadManager {
+        public:
+            enum class Status {
+                Queued,
+                Downloading,
+                Finished,
+                Failed,
+                Cancelled
+            };
+
+            /// Byte counts and speed come from the yt-dlp progress hook, they stay 0 if only the text output could be parsed
+            struct Progress {
+                double downloadedBytes = 0.0;
+                double totalBytes = 0.0;
+                /// Bytes per second
+                double speed = 0.0;
+                /// Seconds remaining
+                double eta = 0.0;
+                float percentage = 0.0f;
+            };
+
+            using ProgressCallback = std::function<void(const Progress&)>;
+            using CompletionCallback = std::function<void(Status)>;
+
+            /// Queues a download, higher priorities are started first
+            /// @return the id of the download, used to cancel it
+            static int Enqueue(std::string_view url, int priority = 0, ProgressCallback progress = nullptr, CompletionCallback completion = nullptr);
+            /// Removes a queued download or interrupts a running one, never blocks on the interpreter
+            static bool Cancel(int id);
+            static Status GetStatus(int id);
+
+            static void set_maxRetries(int retries) { maxRetries = retries; }
+
+        private:
+            struct Job {
+                int id;
+                std::string url;
+                int priority;
+                uint64_t sequence;
+                int attempt = 0;
+                std::chrono::steady_clock::time_point notBefore;
+                ProgressCallback progress;
+                CompletionCallback completion;
+                std::atomic<Status> status = Status::Queued;
+                std::atomic<bool> cancelled = false;
+                /// Python thread id while running, used to interrupt it
+                std::atomic<unsigned long> pythonThread = 0;
+                /// When progress was last handed to the main thread, the first update always is
+                std::chrono::steady_clock::time_point lastProgress;
+                /// Set once the progress hook fired, the text output is ignored from then on
+                bool structuredProgress = false;
+                /// Time spent handling progress, logged to compare the hook with the text parser
+                std::chrono::nanoseconds hookTime = std::chrono::nanoseconds::zero();
+                std::chrono::nanoseconds textTime = std::chrono::nanoseconds::zero();
+                int hookCalls = 0;
+                int textCalls = 0;
+            };
+            using JobPtr = std::shared_ptr<Job>;
+
+            struct JobOrder {
+                bool operator()(const JobPtr& a, const JobPtr& b) const {
+                    if(a->priority != b->priority)
+                        return a->priority < b->priority;
+                    return a->sequence > b->sequence;
+                }
+            };
+
+            static void EnsureWorker();
+            static void WorkerLoop();
+            static JobPtr NextJob();
+            static bool Run(const JobPtr& job);
+            static void Complete(const JobPtr& job, Status status);
+            static void ReportProgress(Job* job, const Progress& progress);
+            static void RegisterProgressModule();
+            static Python::PyObject* ProgressHook(Python::PyObject* self, Python::PyObject* args);
+
+            static std::mutex mutex;
+            static std::condition_variable condition;
+            static std::priority_queue<JobPtr, std::vector<JobPtr>, JobOrder> queue;
+            /// Failed jobs waiting for their backoff to pass
+            static std::vector<JobPtr> retries;
+            static std::unordered_map<int, JobPtr> jobs;
+            static bool workerStarted;
+            static int maxRetries;
+            static int nextId;
+            static uint64_t nextSequence;
+            /// Python output is written on the thread running the download, this tells the handlers which job it belongs to
+            static thread_local Job* currentJob;
+            static Python::PyObject* cancelledException;
+
+            static constexpr const auto RETRY_BASE_DELAY = std::chrono::seconds(2);
+            /// Minimum time between two progress callbacks of a download, the last one is always delivered
+            static constexpr const auto PROGRESS_INTERVAL = std::chrono::milliseconds(250);
+            /// How often a worker checks whether the download it waits on was cancelled
+            static constexpr const auto CANCEL_POLL_INTERVAL = std::chrono::milliseconds(100);
+    };
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Cinema {
+
+    /// Fixed pool of three pitch-aligned frame slots shared between one decode thread and one render thread.
+    /// The decoder always owns one slot, the renderer one, and the third is handed between them with an atomic exchange.
+    /// A frame that is replaced before the renderer picked it up is dropped instead of queued.
+    class FrameRing {
+        public:
+            static constexpr const int SLOT_COUNT = 3;
+            static constexpr const std::size_t PITCH_ALIGNMENT = 64;
+
+            struct Stats {
+                uint64_t publishedFrames;
+                uint64_t presentedFrames;
+                uint64_t droppedFrames;
+                /// Writes that overwrote a dropped frame, one behind droppedFrames at most
+                uint64_t reusedSlots;
+                /// Most slots in use at once: the one being written, a published frame not presented yet and the one being uploaded.
+                /// 3 means the third slot was needed, a double buffer would have stalled the decoder
+                uint32_t peakOccupancy;
+            };
+
+            FrameRing() = default;
+            FrameRing(const FrameRing&) = delete;
+            FrameRing& operator=(const FrameRing&) = delete;
+
+            static std::size_t AlignPitch(std::size_t rowBytes) {
+                return (rowBytes + PITCH_ALIGNMENT - 1) & ~(PITCH_ALIGNMENT - 1);
+            }
+
+            /// Sizes the slots for the given format, only allocates if the pool is too small
+            /// Must not be called while either thread holds a slot
+            void Configure(std::size_t pitch, std::size_t lines);
+
+            std::size_t get_pitch() const { return pitch; }
+            std::size_t get_slotSize() const { return slotSize; }
+
+            /// Decode thread: the slot to write the next frame into
+            uint8_t* BeginWrite();
+            /// Decode thread: publishes the slot returned by BeginWrite
+            void EndWrite();
+
+            /// Render thread: acquires the newest published frame, nullptr if nothing new arrived since the last call
+            /// The returned slot stays valid until the next call to AcquireLatest
+            const uint8_t* AcquireLatest();
+            /// Render thread: done reading the frame from AcquireLatest, only used for peakOccupancy
+            void EndRead();
+
+            Stats get_stats() const;
+            void ResetStats();
+
+        private:
+            static constexpr const uint8_t INDEX_MASK = 0x3;
+            static constexpr const uint8_t FRESH_BIT = 0x4;
+
+            uint8_t* Slot(uint8_t index) const { return pool.get() + index * slotSize; }
+            void UpdatePeak(uint32_t occupancy);
+
+            struct AlignedDelete {
+                void operator()(uint8_t* ptr) const;
+            };
+            std::unique_ptr<uint8_t[], AlignedDelete> pool;
+            std::size_t capacity = 0;
+            std::size_t pitch = 0;
+            std::size_t slotSize = 0;
+
+            // Only used by the decode thread
+            uint8_t writeIndex = 0;
+            // The write slot holds a frame that was replaced before the render thread saw it
+            bool writeSlotDropped = false;
+            std::atomic<bool> writing = false;
+            // Only used by the render thread, which keeps its slot until the next AcquireLatest
+            uint8_t readIndex = 1;
+            std::atomic<bool> reading = false;
+            // Handoff slot, FRESH_BIT marks a frame the render thread hasn't seen yet
+            std::atomic<uint8_t> middle = 2;
+
+            std::atomic<uint64_t> publishedFrames = 0;
+            std::atomic<uint64_t> presentedFrames = 0;
+            std::atomic<uint64_t> droppedFrames = 0;
+            std::atomic<uint64_t> reusedSlots = 0;
+            std::atomic<uint32_t> peakOccupancy = 0;
+    };
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace Cinema {
+
+    /// Unbounded multi producer, single consumer queue
+    /// Push never blocks and may be called from any thread, Pop must only be called from one thread at a time
+    template<typename T>
+    class LockFreeQueue {
+        public:
+            LockFreeQueue() : head(&stub), tail(&stub) {}
+
+            ~LockFreeQueue() {
+                while(Pop().has_value());
+            }
+
+            LockFreeQueue(const LockFreeQueue&) = delete;
+            LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+            void Push(T value) {
+                auto node = new Node(std::move(value));
+                auto previous = head.exchange(node, std::memory_order_acq_rel);
+                previous->next.store(node, std::memory_order_release);
+            }
+
+            std::optional<T> Pop() {
+                auto current = tail;
+                auto next = current->next.load(std::memory_order_acquire);
+                if(current == &stub) {
+                    // The stub only marks the empty queue, skip over it
+                    if(!next)
+                        return std::nullopt;
+                    tail = next;
+                    current = next;
+                    next = next->next.load(std::memory_order_acquire);
+                }
+                if(next) {
+                    tail = next;
+                    return Take(current);
+                }
+                // current is the last node, a producer might still be linking a new one behind it
+                if(current != head.load(std::memory_order_acquire))
+                    return std::nullopt;
+                stub.next.store(nullptr, std::memory_order_relaxed);
+                auto previous = head.exchange(&stub, std::memory_order_acq_rel);
+                previous->next.store(&stub, std::memory_order_release);
+                next = current->next.load(std::memory_order_acquire);
+                if(!next)
+                    return std::nullopt;
+                tail = next;
+                return Take(current);
+            }
+
+        private:
+            struct Node {
+                Node() = default;
+                explicit Node(T value) : value(std::move(value)) {}
+
+                std::atomic<Node*> next = nullptr;
+                std::optional<T> value;
+            };
+
+            static std::optional<T> Take(Node* node) {
+                auto value = std::move(node->value);
+                delete node;
+                return value;
+            }
+
+            std::atomic<Node*> head;
+            Node* tail;
+            Node stub;
+    };
+}
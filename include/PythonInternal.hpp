@@ -22,6 +22,12 @@ if(name##Error) { \
 #define DEFINE_DLSYM_TYPE(name) \
 PyTypeObject* name;
 
+#define DLSYM_REQUIRED(name) \
+DlsymBinding{ #name, reinterpret_cast<void**>(&name), false }
+
+#define DLSYM_OPTIONAL(name) \
+DlsymBinding{ #name, reinterpret_cast<void**>(&name), true }
+
 #define LOAD_DLSYM_TYPE(handle, name) \
 dlerror(); \
 name = reinterpret_cast<PyTypeObject*>(dlsym(handle, #name)); \
@@ -51,6 +57,13 @@ namespace Python {
         struct android_namespace_t* library_namespace;
     };
     
+    /// Symbol resolved by Load_Dlsym, missing optional ones are left null
+    struct DlsymBinding {
+        const char* name;
+        void** address;
+        bool optional;
+    };
+
     DECLARE_DLSYM_INLINE(android_namespace_t*, __loader_android_create_namespace, const char* name, const char* ld_library_path, const char* default_library_path, uint64_t type, const char* permitted_when_isolated_path, struct android_namespace_t* parent);
     DECLARE_DLSYM_INLINE(void*, __loader_android_dlopen_ext, const char* filename, int flag, const android_dlextinfo* extinfo);
     
@@ -0,0 +1,884 @@
+#pragma once
+
+/// Every libpython symbol Load_Dlsym resolves, expanded once into the pointer definitions and once into the binding table
+/// FUNCTION(binding, retval, name, args...) for functions, TYPE(binding, name) for type objects
+/// binding is REQUIRED for everything the mod itself calls, OPTIONAL for what other libpython builds may not export
+#define PYTHON_SYMBOLS(FUNCTION, TYPE) \
+    FUNCTION(OPTIONAL, PyObject *, PyMarshal_WriteObjectToString, PyObject *, int) \
+    FUNCTION(OPTIONAL, void, PyThread_release_lock, PyThread_type_lock) \
+    FUNCTION(OPTIONAL, void *, PyObject_Realloc, void *ptr, size_t new_size) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Xor, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, PyObject *, PyBytes_DecodeEscape, const char *, Py_ssize_t,const char *, Py_ssize_t,const char *) \
+    FUNCTION(REQUIRED, PyObject *, PyImport_AddModule,const char *name            /* UTF-8 encoded string */) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicodeTranslateError_GetObject, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicodeDecodeError_GetEncoding, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Negative, PyObject *o) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyList_Size, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyModule_AddFunctions, PyObject *, PyMethodDef *) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_FloorDivide, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, void, PyErr_Restore, PyObject *, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, void, PyObject_CallFinalizer, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PySequence_Tuple, PyObject *o) \
+    FUNCTION(OPTIONAL, int, PyCapsule_SetContext, PyObject *capsule, void *context) \
+    FUNCTION(OPTIONAL, int, PySlice_Unpack, PyObject *slice,Py_ssize_t *start, Py_ssize_t *stop, Py_ssize_t *step) \
+    FUNCTION(OPTIONAL, int, PyErr_BadArgument, void) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_Format, PyObject *obj,PyObject *format_spec) \
+    FUNCTION(OPTIONAL, int, PyUnicodeDecodeError_GetEnd, PyObject *, Py_ssize_t *) \
+    TYPE(OPTIONAL, PyLongRangeIter_Type) \
+    FUNCTION(OPTIONAL, int, PyNumber_Check, PyObject *o) \
+    FUNCTION(OPTIONAL, long, PyOS_strtol, const char *, char **, int) \
+    FUNCTION(OPTIONAL, PyObject *, PyFile_OpenCodeObject, PyObject *path) \
+    FUNCTION(OPTIONAL, int, PyUnicode_FSConverter, PyObject*, void*) \
+    FUNCTION(OPTIONAL, void, PyMarshal_WriteObjectToFile, PyObject *, FILE *, int) \
+    FUNCTION(OPTIONAL, void, PyPreConfig_InitIsolatedConfig, PyPreConfig *config) \
+    FUNCTION(OPTIONAL, PyCapsule_Destructor, PyCapsule_GetDestructor, PyObject *capsule) \
+    FUNCTION(OPTIONAL, PyObject *, PyImport_Import, PyObject *name) \
+    FUNCTION(OPTIONAL, PyStatus, PyStatus_Ok, void) \
+    FUNCTION(OPTIONAL, int, PyOS_mystrnicmp, const char *, const char *, Py_ssize_t) \
+    FUNCTION(OPTIONAL, const Py_buffer *, PyPickleBuffer_GetBuffer, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyThread_GetInfo, void) \
+    FUNCTION(OPTIONAL, int, PyFile_WriteString, const char *, PyObject *) \
+    FUNCTION(OPTIONAL, size_t, PyThread_get_stacksize, void) \
+    FUNCTION(OPTIONAL, int, PyToken_TwoChars, int, int) \
+    FUNCTION(OPTIONAL, void, Py_SetPath, const wchar_t *) \
+    TYPE(OPTIONAL, PyMethodDescr_Type) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PySequence_Length, PyObject *o) \
+    FUNCTION(OPTIONAL, PyObject *, PyType_GenericNew, PyTypeObject *,PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyTuple_GetItem, PyObject *, Py_ssize_t) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_Split,PyObject *s,                /* String to split */PyObject *sep,              /* String separator */Py_ssize_t maxsplit         /* Maxsplit count */) \
+    FUNCTION(OPTIONAL, PyObject *, PyLong_FromSize_t, size_t) \
+    FUNCTION(OPTIONAL, int, PyBuffer_IsContiguous, const Py_buffer *view, char fort) \
+    FUNCTION(OPTIONAL, PyStatus, Py_InitializeFromConfig,const PyConfig *config) \
+    FUNCTION(OPTIONAL, PyStatus, PyWideStringList_Append, PyWideStringList *list,const wchar_t *item) \
+    FUNCTION(OPTIONAL, char *, PyOS_Readline, FILE *, FILE *, const char *) \
+    FUNCTION(OPTIONAL, PyObject *, PyDict_GetItem, PyObject *mp, PyObject *key) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_EncodeLocale,PyObject *unicode,const char *errors) \
+    FUNCTION(OPTIONAL, PyObject *, PyErr_SetFromErrnoWithFilenameObjects,PyObject *, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicode_InternFromString,const char *u              /* UTF-8 encoded string */) \
+    FUNCTION(OPTIONAL, void, PyErr_PrintEx, int) \
+    FUNCTION(OPTIONAL, int, PyErr_ExceptionMatches, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_FromWideChar,const wchar_t *w,           /* wchar_t buffer */Py_ssize_t size             /* size of buffer */) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_LookupError, const char *name) \
+    FUNCTION(OPTIONAL, PyObject *, PyComplex_FromCComplex, Py_complex) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyUnicode_Tailmatch,PyObject *str,              /* String */PyObject *substr,           /* Prefix or Suffix string */Py_ssize_t start,           /* Start index */Py_ssize_t end,             /* Stop index */int direction               /* Tail end: -1 prefix, +1 suffix */) \
+    FUNCTION(REQUIRED, char *, PyBytes_AsString, PyObject *) \
+    FUNCTION(OPTIONAL, void *, PyCapsule_Import,const char *name,           /* UTF-8 encoded string */int no_block) \
+    TYPE(OPTIONAL, PyMemoryView_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyMarshal_ReadObjectFromString, const char *,Py_ssize_t) \
+    FUNCTION(OPTIONAL, PyObject *, PyLong_FromUnicodeObject, PyObject *u, int base) \
+    FUNCTION(OPTIONAL, PyStatus, PyConfig_SetArgv, PyConfig *config,Py_ssize_t argc,wchar_t * const *argv) \
+    FUNCTION(OPTIONAL, PyStatus, Py_PreInitializeFromArgs,const PyPreConfig *src_config,Py_ssize_t argc,wchar_t **argv) \
+    FUNCTION(OPTIONAL, int, PyToken_ThreeChars, int, int, int) \
+    FUNCTION(OPTIONAL, int, PyUnicodeTranslateError_GetStart, PyObject *, Py_ssize_t *) \
+    FUNCTION(OPTIONAL, int, PyUnicode_Contains,PyObject *container,        /* Container string */PyObject *element           /* Element string */) \
+    FUNCTION(OPTIONAL, PyObject *, PyRun_StringFlags, const char *, int, PyObject *,PyObject *, PyCompilerFlags *) \
+    FUNCTION(OPTIONAL, void, PySys_FormatStdout, const char *format, ...) \
+    FUNCTION(OPTIONAL, int, PyImport_ImportFrozenModuleObject,PyObject *name) \
+    FUNCTION(OPTIONAL, int, PyRun_AnyFileFlags, FILE *, const char *, PyCompilerFlags *) \
+    FUNCTION(OPTIONAL, PyObject *, PyDictProxy_New, PyObject *) \
+    TYPE(OPTIONAL, PyDictIterKey_Type) \
+    TYPE(OPTIONAL, PyODictKeys_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyFloat_FromString, PyObject*) \
+    FUNCTION(OPTIONAL, int, PyList_Insert, PyObject *, Py_ssize_t, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyPickleBuffer_Release, PyObject *) \
+    FUNCTION(OPTIONAL, const char *, PyEval_GetFuncDesc, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyTraceBack_Print, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, void, PySys_AddXOption, const wchar_t *) \
+    FUNCTION(OPTIONAL, PyObject *, PyBytes_Repr, PyObject *, int) \
+    FUNCTION(REQUIRED, PyObject *, Py_BuildValue, const char *, ...) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Lshift, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, void, PyConfig_InitPythonConfig, PyConfig *config) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeUTF8Stateful,const char *string,         /* UTF-8 encoded string */Py_ssize_t length,          /* size of string */const char *errors,         /* error handling */Py_ssize_t *consumed        /* bytes consumed */) \
+    FUNCTION(OPTIONAL, int, PyBuffer_FromContiguous, Py_buffer *view, void *buf,Py_ssize_t len, char order) \
+    FUNCTION(OPTIONAL, int, PyUnicodeDecodeError_SetReason,PyObject *exc,const char *reason          /* UTF-8 encoded string */) \
+    FUNCTION(OPTIONAL, void, PyOS_AfterFork_Parent, void) \
+    FUNCTION(OPTIONAL, int, PyDict_DelItemString, PyObject *dp, const char *key) \
+    FUNCTION(OPTIONAL, PyObject *, PySequence_Repeat, PyObject *o, Py_ssize_t count) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyTuple_Size, PyObject *) \
+    FUNCTION(OPTIONAL, void, PyMem_SetAllocator, PyMemAllocatorDomain domain,PyMemAllocatorEx *allocator) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_EncodeUTF7,PyObject *unicode,          /* Unicode object */int base64SetO,             /* Encode RFC2152 Set O characters in base64 */int base64WhiteSpace,       /* Encode whitespace (sp, ht, nl, cr) in base64 */const char *errors          /* error handling */) \
+    FUNCTION(OPTIONAL, PyObject *, PyEval_EvalCode, PyObject *, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_InPlaceFloorDivide, PyObject *o1,PyObject *o2) \
+    FUNCTION(OPTIONAL, int, PySet_Add, PyObject *set, PyObject *key) \
+    FUNCTION(OPTIONAL, PyThread_type_lock, PyThread_allocate_lock, void) \
+    FUNCTION(OPTIONAL, void, Py_ReprLeave, PyObject *) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyUnicode_Fill,PyObject *unicode,Py_ssize_t start,Py_ssize_t length,Py_UCS4 fill_char) \
+    FUNCTION(OPTIONAL, int, Py_AtExit, void (*func)(void)) \
+    FUNCTION(OPTIONAL, PyObject *, PyDict_New, void) \
+    FUNCTION(OPTIONAL, int, PyCodec_RegisterError, const char *name, PyObject *error) \
+    FUNCTION(OPTIONAL, int, PyIndex_Check, PyObject *) \
+    FUNCTION(OPTIONAL, PyThreadState *, PyThreadState_New, PyInterpreterState *) \
+    FUNCTION(OPTIONAL, int, PyUnicode_IsIdentifier, PyObject *s) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicode_RichCompare,PyObject *left,             /* Left string */PyObject *right,            /* Right string */int op                      /* Operation: Py_EQ, Py_NE, Py_GT, etc. */) \
+    FUNCTION(OPTIONAL, PyObject *, PyImport_ImportModuleLevelObject,PyObject *name,PyObject *globals,PyObject *locals,PyObject *fromlist,int level) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_GetAttr, PyObject *, PyObject *) \
+    TYPE(OPTIONAL, PyUnicode_Type) \
+    FUNCTION(OPTIONAL, PyStatus, PyStatus_Error, const char *err_msg) \
+    FUNCTION(OPTIONAL, int, PyList_Sort, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyUnicodeDecodeError_SetEnd, PyObject *, Py_ssize_t) \
+    FUNCTION(OPTIONAL, PyObject *, PyModule_FromDefAndSpec2, PyModuleDef *def,PyObject *spec,int module_api_version) \
+    FUNCTION(OPTIONAL, int, PyRun_InteractiveOneFlags,FILE *fp,const char *filename,       /* decoded from the filesystem encoding */PyCompilerFlags *flags) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_InPlaceAnd, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_CallMethod, PyObject *obj,const char *name,const char *format, ...) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_Dir, PyObject *) \
+    FUNCTION(OPTIONAL, void, PyThread_free_lock, PyThread_type_lock) \
+    FUNCTION(OPTIONAL, int, PyObject_AsReadBuffer, PyObject *obj,const void **buffer,Py_ssize_t *buffer_len) \
+    FUNCTION(OPTIONAL, const char *, PyCapsule_GetName, PyObject *capsule) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_StreamWriter,const char *encoding,PyObject *stream,const char *errors) \
+    FUNCTION(OPTIONAL, int, PyArg_VaParse, PyObject *, const char *, va_list) \
+    FUNCTION(REQUIRED, PyObject *, PyBytes_FromStringAndSize, const char *, Py_ssize_t) \
+    FUNCTION(OPTIONAL, PyObject *, PyLong_FromLong, long) \
+    FUNCTION(REQUIRED, PyObject *, PyList_New, Py_ssize_t size) \
+    TYPE(OPTIONAL, PyContextToken_Type) \
+    FUNCTION(OPTIONAL, void, Py_Exit, int) \
+    FUNCTION(OPTIONAL, void, PyUnicode_AppendAndDel,PyObject **pleft,           /* Pointer to left string */PyObject *right             /* Right string */) \
+    FUNCTION(OPTIONAL, int, PySequence_In, PyObject *o, PyObject *value) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicodeEncodeError_GetEncoding, PyObject *) \
+    TYPE(OPTIONAL, PyCoro_Type) \
+    FUNCTION(REQUIRED, int, PyList_SetItem, PyObject *, Py_ssize_t, PyObject *) \
+    FUNCTION(OPTIONAL, PyStatus, PyStatus_Exit, int exitcode) \
+    TYPE(OPTIONAL, PyCFunction_Type) \
+    FUNCTION(OPTIONAL, int, PyObject_GenericSetAttr, PyObject *, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, int, PySys_Audit,const char *event,const char *argFormat,...) \
+    FUNCTION(OPTIONAL, PyHash_FuncDef*, PyHash_GetFuncDef, void) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyMapping_Length, PyObject *o) \
+    TYPE(OPTIONAL, PyODictIter_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_Init, PyObject *, PyTypeObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeLatin1,const char *string,         /* Latin-1 encoded string */Py_ssize_t length,          /* size of string */const char *errors          /* error handling */) \
+    FUNCTION(OPTIONAL, int, PyArg_VaParseTupleAndKeywords, PyObject *, PyObject *,const char *, char **, va_list) \
+    FUNCTION(OPTIONAL, PyThreadState *, PyInterpreterState_ThreadHead, PyInterpreterState *) \
+    TYPE(OPTIONAL, PyFloat_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyWrapper_New, PyObject *, PyObject *) \
+    TYPE(OPTIONAL, PyClassMethod_Type) \
+    FUNCTION(OPTIONAL, void, PyThreadState_Clear, PyThreadState *) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyUnicode_Find,PyObject *str,              /* String */PyObject *substr,           /* Substring to find */Py_ssize_t start,           /* Start index */Py_ssize_t end,             /* Stop index */int direction               /* Find direction: +1 forward, -1 backward */) \
+    FUNCTION(OPTIONAL, int, PyStructSequence_InitType2, PyTypeObject *type,PyStructSequence_Desc *desc) \
+    FUNCTION(OPTIONAL, void, PyErr_GetExcInfo, PyObject **, PyObject **, PyObject **) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_ToBase, PyObject *n, int base) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Subtract, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, void, PySys_SetArgv, int, wchar_t **) \
+    FUNCTION(OPTIONAL, PyObject *, PyType_GenericAlloc, PyTypeObject *, Py_ssize_t) \
+    TYPE(OPTIONAL, PyFrozenSet_Type) \
+    TYPE(OPTIONAL, PyListRevIter_Type) \
+    TYPE(OPTIONAL, PySetIter_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyImport_ExecCodeModuleEx,const char *name,           /* UTF-8 encoded string */PyObject *co,const char *pathname        /* decoded from the filesystem encoding */) \
+    FUNCTION(OPTIONAL, int, PyErr_WarnExplicitObject,PyObject *category,PyObject *message,PyObject *filename,int lineno,PyObject *module,PyObject *registry) \
+    TYPE(OPTIONAL, PyStringIO_Type) \
+    FUNCTION(OPTIONAL, int, PySequence_DelSlice, PyObject *o, Py_ssize_t i1, Py_ssize_t i2) \
+    FUNCTION(OPTIONAL, int, PySequence_Contains, PyObject *seq, PyObject *ob) \
+    FUNCTION(OPTIONAL, int, PyDict_Update, PyObject *mp, PyObject *other) \
+    FUNCTION(OPTIONAL, const char *, Py_GetCopyright, void) \
+    TYPE(OPTIONAL, PySuper_Type) \
+    TYPE(OPTIONAL, PyModuleDef_Type) \
+    FUNCTION(OPTIONAL, void, PySys_ResetWarnOptions, void) \
+    FUNCTION(OPTIONAL, const char *, PyUnicode_AsUTF8AndSize,PyObject *unicode,Py_ssize_t *size) \
+    FUNCTION(OPTIONAL, int, PyObject_RichCompareBool, PyObject *, PyObject *, int) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_Bytes, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyInstanceMethod_New, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyContext_Enter, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_AsRawUnicodeEscapeString,PyObject *unicode           /* Unicode object */) \
+    FUNCTION(OPTIONAL, PyStatus, PyConfig_SetBytesString,PyConfig *config,wchar_t **config_str,const char *str) \
+    TYPE(OPTIONAL, PyModule_Type) \
+    FUNCTION(OPTIONAL, PyCodeObject *, PyCode_NewWithPosOnlyArgs,int, int, int, int, int, int, PyObject *, PyObject *,PyObject *, PyObject *, PyObject *, PyObject *,PyObject *, PyObject *, int, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_EncodeCharmap,PyObject *unicode,          /* Unicode object */PyObject *mapping,          /* encoding mapping */const char *errors          /* error handling */) \
+    FUNCTION(OPTIONAL, PyObject *, PyTuple_New, Py_ssize_t size) \
+    FUNCTION(OPTIONAL, int, PyFile_WriteObject, PyObject *, PyObject *, int) \
+    FUNCTION(OPTIONAL, int, PyCapsule_SetDestructor, PyObject *capsule, PyCapsule_Destructor destructor) \
+    FUNCTION(OPTIONAL, int, PyStatus_Exception, PyStatus err) \
+    FUNCTION(OPTIONAL, int, PyThread_set_stacksize, size_t) \
+    TYPE(OPTIONAL, PyBufferedIOBase_Type) \
+    FUNCTION(OPTIONAL, double, PyLong_AsDouble, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyFunction_GetGlobals, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyLong_GetInfo, void) \
+    FUNCTION(OPTIONAL, int, PyMarshal_ReadShortFromFile, FILE *) \
+    FUNCTION(OPTIONAL, int, PySlice_GetIndices, PyObject *r, Py_ssize_t length,Py_ssize_t *start, Py_ssize_t *stop, Py_ssize_t *step) \
+    FUNCTION(OPTIONAL, PyObject *, PyModule_GetNameObject, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyRun_FileEx, FILE *fp, const char *p, int s, PyObject *g, PyObject *l, int c) \
+    TYPE(OPTIONAL, PyClassMethodDescr_Type) \
+    TYPE(OPTIONAL, PyFunction_Type) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_AsLatin1String,PyObject *unicode           /* Unicode object */) \
+    FUNCTION(OPTIONAL, void, PyInterpreterState_Delete, PyInterpreterState *) \
+    FUNCTION(REQUIRED, void, PyEval_RestoreThread, PyThreadState *) \
+    FUNCTION(OPTIONAL, PyObject *, PyODict_New, void) \
+    FUNCTION(OPTIONAL, int, PyUnicode_CompareWithASCIIString,PyObject *left,const char *right           /* ASCII-encoded string */) \
+    FUNCTION(OPTIONAL, void, Py_SetPythonHome, const wchar_t *) \
+    FUNCTION(OPTIONAL, const char *, PyEval_GetFuncName, PyObject *) \
+    FUNCTION(OPTIONAL, Py_complex, PyComplex_AsCComplex, PyObject *op) \
+    FUNCTION(OPTIONAL, wchar_t *, Py_GetProgramName, void) \
+    FUNCTION(OPTIONAL, int, PyContextVar_Get,PyObject *var, PyObject *default_value, PyObject **value) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Multiply, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, void *, PyObject_Calloc, size_t nelem, size_t elsize) \
+    FUNCTION(OPTIONAL, void *, PyMem_Calloc, size_t nelem, size_t elsize) \
+    FUNCTION(OPTIONAL, PyObject *, PyCFunction_GetSelf, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_Splitlines,PyObject *s,                /* String to split */int keepends                /* If true, line end markers are included */) \
+    FUNCTION(OPTIONAL, int, PySequence_DelItem, PyObject *o, Py_ssize_t i) \
+    TYPE(OPTIONAL, PyGen_Type) \
+    FUNCTION(OPTIONAL, void, PyConfig_Clear, PyConfig *) \
+    FUNCTION(OPTIONAL, void *, PyCapsule_GetContext, PyObject *capsule) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_StrictErrors, PyObject *exc) \
+    TYPE(OPTIONAL, PyLong_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PySys_GetXOptions, void) \
+    FUNCTION(OPTIONAL, Py_UCS4, PyUnicode_ReadChar,PyObject *unicode,Py_ssize_t index) \
+    FUNCTION(OPTIONAL, int, PyErr_WarnFormat,PyObject *category,Py_ssize_t stack_level,const char *format,         /* ASCII-encoded string  */...) \
+    FUNCTION(OPTIONAL, int, Py_FrozenMain, int argc, char **argv) \
+    FUNCTION(OPTIONAL, PyObject *, PyDict_Items, PyObject *mp) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicodeTranslateError_Create,PyObject *object,Py_ssize_t start,Py_ssize_t end,const char *reason          /* UTF-8 encoded string */) \
+    FUNCTION(OPTIONAL, int, PyList_SetSlice, PyObject *, Py_ssize_t, Py_ssize_t, PyObject *) \
+    FUNCTION(OPTIONAL, PyInterpreterState *, PyInterpreterState_New, void) \
+    FUNCTION(OPTIONAL, int, PyCodec_Register,PyObject *search_function) \
+    FUNCTION(OPTIONAL, int, PyObject_AsWriteBuffer, PyObject *obj,void **buffer,Py_ssize_t *buffer_len) \
+    FUNCTION(OPTIONAL, PyObject *, PyWeakref_NewRef, PyObject *ob,PyObject *callback) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_EncodeFSDefault,PyObject *unicode) \
+    FUNCTION(OPTIONAL, PyObject *, PyContext_CopyCurrent, void) \
+    FUNCTION(OPTIONAL, const char *, PyExceptionClass_Name, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PySys_GetObject, const char *) \
+    FUNCTION(OPTIONAL, int, PyUnicodeEncodeError_SetReason,PyObject *exc,const char *reason          /* UTF-8 encoded string */) \
+    FUNCTION(OPTIONAL, int, PyUnicode_Resize,PyObject **unicode,         /* Pointer to the Unicode object */Py_ssize_t length           /* New length */) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PySequence_Index, PyObject *o, PyObject *value) \
+    FUNCTION(OPTIONAL, unsigned long, PyType_GetFlags, PyTypeObject*) \
+    FUNCTION(OPTIONAL, PyObject *, PyDict_Keys, PyObject *mp) \
+    TYPE(OPTIONAL, PyCell_Type) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeLocaleAndSize,const char *str,Py_ssize_t len,const char *errors) \
+    FUNCTION(OPTIONAL, int, PyErr_WarnExplicit,PyObject *category,const char *message,        /* UTF-8 encoded string */const char *filename,       /* decoded from the filesystem encoding */int lineno,const char *module,         /* UTF-8 encoded string */PyObject *registry) \
+    FUNCTION(OPTIONAL, long, PyImport_GetMagicNumber, void) \
+    FUNCTION(OPTIONAL, int, PyCapsule_IsValid, PyObject *capsule, const char *name) \
+    FUNCTION(OPTIONAL, PyObject *, PyFile_FromFd, int, const char *, const char *, int,const char *, const char *,const char *, int) \
+    TYPE(OPTIONAL, PyInstanceMethod_Type) \
+    TYPE(OPTIONAL, PyZip_Type) \
+    FUNCTION(OPTIONAL, void, Py_Finalize, void) \
+    FUNCTION(OPTIONAL, double, PyFloat_GetMax, void) \
+    FUNCTION(REQUIRED, PyGILState_STATE, PyGILState_Ensure, void) \
+    FUNCTION(OPTIONAL, PyObject *, PySequence_List, PyObject *o) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_IncrementalDecoder,const char *encoding,const char *errors) \
+    FUNCTION(REQUIRED, void, PyErr_Clear, void) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyObject_Length, PyObject *o) \
+    FUNCTION(OPTIONAL, PyObject *, PyCapsule_New,void *pointer,const char *name,PyCapsule_Destructor destructor) \
+    FUNCTION(OPTIONAL, PyObject *, PyLong_FromSsize_t, Py_ssize_t) \
+    TYPE(OPTIONAL, PyByteArray_Type) \
+    FUNCTION(OPTIONAL, void, PyThreadState_Delete, PyThreadState *) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_GenericGetDict, PyObject *, void *) \
+    FUNCTION(OPTIONAL, PyObject *, PyContext_New, void) \
+    FUNCTION(OPTIONAL, PyStatus, PyConfig_Read, PyConfig *config) \
+    FUNCTION(OPTIONAL, void, PyThreadState_DeleteCurrent, void) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeASCII,const char *string,         /* ASCII encoded string */Py_ssize_t length,          /* size of string */const char *errors          /* error handling */) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicodeTranslateError_GetReason, PyObject *) \
+    TYPE(OPTIONAL, PyTraceBack_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_InPlaceMultiply, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, int, PyArg_ValidateKeywordArguments, PyObject *) \
+    FUNCTION(OPTIONAL, void*, PyModule_GetState, PyObject*) \
+    TYPE(OPTIONAL, PyWrapperDescr_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyLong_FromVoidPtr, void *) \
+    FUNCTION(OPTIONAL, int, PyModule_SetDocString, PyObject *, const char *) \
+    FUNCTION(OPTIONAL, PyObject *, PyErr_NewExceptionWithDoc,const char *name, const char *doc, PyObject *base, PyObject *dict) \
+    FUNCTION(OPTIONAL, void, PyErr_SyntaxLocationEx,const char *filename,       /* decoded from the filesystem encoding */int lineno,int col_offset) \
+    FUNCTION(OPTIONAL, void *, PyObject_Malloc, size_t size) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_InPlaceRemainder, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, void *, PyThread_tss_get, Py_tss_t *key) \
+    FUNCTION(OPTIONAL, void, PyOS_AfterFork_Child, void) \
+    TYPE(OPTIONAL, PyDictIterItem_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PySet_Pop, PyObject *set) \
+    FUNCTION(OPTIONAL, int, PyObject_DelItem, PyObject *o, PyObject *key) \
+    FUNCTION(OPTIONAL, PyObject *, PySeqIter_New, PyObject *) \
+    TYPE(OPTIONAL, PyBufferedReader_Type) \
+    FUNCTION(OPTIONAL, int, PySequence_SetSlice, PyObject *o, Py_ssize_t i1, Py_ssize_t i2,PyObject *v) \
+    FUNCTION(OPTIONAL, char *, PyOS_double_to_string, double val,char format_code,int precision,int flags,int *type) \
+    FUNCTION(OPTIONAL, int, PyObject_IsTrue, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyImport_GetModule, PyObject *name) \
+    FUNCTION(OPTIONAL, int, PyStatus_IsError, PyStatus err) \
+    FUNCTION(OPTIONAL, PyObject *, PyFloat_GetInfo, void) \
+    FUNCTION(REQUIRED, int, PyRun_SimpleString, const char *s) \
+    FUNCTION(OPTIONAL, int, PyCapsule_SetPointer, PyObject *capsule, void *pointer) \
+    FUNCTION(OPTIONAL, void, PyObject_GetArenaAllocator, PyObjectArenaAllocator *allocator) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicode_FromFormat,const char *format,   /* ASCII-encoded string  */...) \
+    FUNCTION(OPTIONAL, unsigned long long, PyLong_AsUnsignedLongLong, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_Str, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_CallMethodObjArgs,PyObject *obj,PyObject *name,...) \
+    FUNCTION(OPTIONAL, PyObject *, PyException_GetCause, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_AsUTF32String,PyObject *unicode           /* Unicode object */) \
+    FUNCTION(REQUIRED, void, Py_IncRef, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeUTF16Stateful,const char *string,         /* UTF-16 encoded string */Py_ssize_t length,          /* size of string */const char *errors,         /* error handling */int *byteorder,             /* pointer to byteorder to use0=native;-1=LE,1=BE; updated onexit */Py_ssize_t *consumed        /* bytes consumed */) \
+    FUNCTION(OPTIONAL, int, PySequence_SetItem, PyObject *o, Py_ssize_t i, PyObject *v) \
+    FUNCTION(REQUIRED, PyObject *, PyTuple_Pack, Py_ssize_t, ...) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyUnicode_CopyCharacters,PyObject *to,Py_ssize_t to_start,PyObject *from,Py_ssize_t from_start,Py_ssize_t how_many) \
+    TYPE(OPTIONAL, PyStaticMethod_Type) \
+    FUNCTION(OPTIONAL, Py_UCS4*, PyUnicode_AsUCS4,PyObject *unicode,Py_UCS4* buffer,Py_ssize_t buflen,int copy_null) \
+    FUNCTION(OPTIONAL, PyObject *, PyCell_New, PyObject *) \
+    TYPE(OPTIONAL, PyEllipsis_Type) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyDict_Size, PyObject *mp) \
+    FUNCTION(OPTIONAL, void, Py_SetRecursionLimit, int) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Add, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, double, PyComplex_ImagAsDouble, PyObject *op) \
+    FUNCTION(OPTIONAL, wchar_t *, Py_GetExecPrefix, void) \
+    FUNCTION(OPTIONAL, int, PyUnicodeDecodeError_GetStart, PyObject *, Py_ssize_t *) \
+    FUNCTION(OPTIONAL, PyObject *, PyMemoryView_FromBuffer, Py_buffer *info) \
+    FUNCTION(OPTIONAL, PyObject *, PyComplex_FromDoubles, double real, double imag) \
+    FUNCTION(OPTIONAL, int, PyTraceMalloc_Untrack,unsigned int domain,uintptr_t ptr) \
+    FUNCTION(OPTIONAL, PyObject *, PyDescr_NewMethod, PyTypeObject *, PyMethodDef *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_AsASCIIString,PyObject *unicode           /* Unicode object */) \
+    FUNCTION(REQUIRED, int, PyThreadState_SetAsyncExc, unsigned long, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_Concat,PyObject *left,             /* Left string */PyObject *right             /* Right string */) \
+    FUNCTION(OPTIONAL, PyObject *, Py_CompileStringExFlags,const char *str,const char *filename,       /* decoded from the filesystem encoding */int start,PyCompilerFlags *flags,int optimize) \
+    FUNCTION(OPTIONAL, PyObject *, PyGen_New, PyFrameObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyRun_FileExFlags,FILE *fp,const char *filename,       /* decoded from the filesystem encoding */int start,PyObject *globals,PyObject *locals,int closeit,PyCompilerFlags *flags) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_BackslashReplaceErrors, PyObject *exc) \
+    FUNCTION(REQUIRED, int, PyArg_ParseTuple, PyObject *, const char *, ...) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeUTF7Stateful,const char *string,         /* UTF-7 encoded string */Py_ssize_t length,          /* size of string */const char *errors,         /* error handling */Py_ssize_t *consumed        /* bytes consumed */) \
+    FUNCTION(REQUIRED, PyObject *, PyObject_Call, PyObject *callable,PyObject *args, PyObject *kwargs) \
+    TYPE(OPTIONAL, PyMap_Type) \
+    FUNCTION(OPTIONAL, int, PyRun_AnyFile, FILE *fp, const char *name) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_CallFunction, PyObject *callable,const char *format, ...) \
+    FUNCTION(OPTIONAL, void, Py_FatalError, const char *message) \
+    FUNCTION(OPTIONAL, void *, PyMem_Realloc, void *ptr, size_t new_size) \
+    FUNCTION(OPTIONAL, PyObject *, PyFunction_GetKwDefaults, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_New,Py_ssize_t size,            /* Number of code points in the new string */Py_UCS4 maxchar             /* maximum code point value in the string */) \
+    TYPE(OPTIONAL, PyListIter_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicode_Format,PyObject *format,           /* Format string */PyObject *args              /* Argument tuple or dictionary */) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PySet_Size, PyObject *anyset) \
+    FUNCTION(OPTIONAL, int, PyObject_SetAttr, PyObject *, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyUnicodeEncodeError_SetStart, PyObject *, Py_ssize_t) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_NameReplaceErrors, PyObject *exc) \
+    FUNCTION(OPTIONAL, Py_tss_t *, PyThread_tss_alloc, void) \
+    FUNCTION(OPTIONAL, Py_hash_t, PyObject_HashNotImplemented, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyObject_IsSubclass, PyObject *object, PyObject *typeorclass) \
+    FUNCTION(OPTIONAL, PyObject *, PyErr_SetFromErrno, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyFunction_GetCode, PyObject *) \
+    FUNCTION(OPTIONAL, PyThreadState *, Py_NewInterpreter, void) \
+    FUNCTION(OPTIONAL, PyObject *, PyModule_New,const char *name            /* UTF-8 encoded string */) \
+    FUNCTION(OPTIONAL, void, PyBuffer_FillContiguousStrides, int ndims,Py_ssize_t *shape,Py_ssize_t *strides,int itemsize,char fort) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_SelfIter, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyMemoryView_GetContiguous, PyObject *base,int buffertype,char order) \
+    FUNCTION(OPTIONAL, const char *, PyModule_GetName, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyPickleBuffer_FromObject, PyObject *) \
+    FUNCTION(OPTIONAL, wchar_t *, Py_GetPythonHome, void) \
+    FUNCTION(OPTIONAL, int, PyCapsule_SetName, PyObject *capsule, const char *name) \
+    TYPE(OPTIONAL, PyReversed_Type) \
+    FUNCTION(OPTIONAL, PyCFunction, PyCFunction_GetFunction, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyCFunction_GetFlags, PyObject *) \
+    TYPE(OPTIONAL, PyPickleBuffer_Type) \
+    FUNCTION(OPTIONAL, void, PyEval_SetProfile, Py_tracefunc, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyObject_HasAttr, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, int, PySys_AddAuditHook, Py_AuditHookFunction, void*) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_Type, PyObject *o) \
+    FUNCTION(OPTIONAL, PyObject *, PyImport_ExecCodeModuleWithPathnames,const char *name,           /* UTF-8 encoded string */PyObject *co,const char *pathname,       /* decoded from the filesystem encoding */const char *cpathname       /* decoded from the filesystem encoding */) \
+    FUNCTION(OPTIONAL, PyObject *, PySequence_GetItem, PyObject *o, Py_ssize_t i) \
+    FUNCTION(OPTIONAL, PyObject *, PyMember_GetOne, const char *, struct PyMemberDef *) \
+    FUNCTION(OPTIONAL, void, PySys_FormatStderr, const char *format, ...) \
+    FUNCTION(OPTIONAL, void, PyStructSequence_InitType, PyTypeObject *type,PyStructSequence_Desc *desc) \
+    FUNCTION(OPTIONAL, int, PyUnicode_FSDecoder, PyObject*, void*) \
+    FUNCTION(OPTIONAL, int, PyType_Ready, PyTypeObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_InPlacePower, PyObject *o1, PyObject *o2,PyObject *o3) \
+    FUNCTION(OPTIONAL, unsigned int, PyType_ClearCache, void) \
+    FUNCTION(OPTIONAL, const char *, Py_GetPlatform, void) \
+    FUNCTION(OPTIONAL, int, PyRun_InteractiveLoop, FILE *f, const char *p) \
+    FUNCTION(OPTIONAL, PyObject *, PyDict_Values, PyObject *mp) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Long, PyObject *o) \
+    FUNCTION(OPTIONAL, void, PyErr_SetString,PyObject *exception,const char *string   /* decoded from utf-8 */) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_InPlaceTrueDivide, PyObject *o1,PyObject *o2) \
+    FUNCTION(OPTIONAL, PyObject *, PyInterpreterState_GetDict, PyInterpreterState *) \
+    FUNCTION(OPTIONAL, void, PyDict_Clear, PyObject *mp) \
+    FUNCTION(OPTIONAL, int, PyState_RemoveModule, struct PyModuleDef*) \
+    FUNCTION(OPTIONAL, void, PyException_SetContext, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_InPlaceLshift, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, PyObject *, PyBool_FromLong, long) \
+    FUNCTION(OPTIONAL, PyObject *, PyMemoryView_FromObject, PyObject *base) \
+    FUNCTION(OPTIONAL, PyObject*, PyStructSequence_GetItem, PyObject*, Py_ssize_t) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_Partition,PyObject *s,                /* String to partition */PyObject *sep               /* String separator */) \
+    FUNCTION(OPTIONAL, PyObject*, PyCode_Optimize, PyObject *code, PyObject* consts,PyObject *names, PyObject *lnotab) \
+    FUNCTION(OPTIONAL, PyTryBlock *, PyFrame_BlockPop, PyFrameObject *) \
+    FUNCTION(OPTIONAL, void, PyThread_tss_delete, Py_tss_t *key) \
+    FUNCTION(OPTIONAL, PyObject *, PyMapping_Values, PyObject *o) \
+    FUNCTION(OPTIONAL, int, PyBuffer_ToContiguous, void *buf, Py_buffer *view,Py_ssize_t len, char order) \
+    FUNCTION(OPTIONAL, PyInterpreterState *, PyInterpreterState_Next, PyInterpreterState *) \
+    FUNCTION(OPTIONAL, PyObject *, PyErr_Occurred, void) \
+    FUNCTION(OPTIONAL, int, Py_AddPendingCall, int (*func)(void *), void *arg) \
+    FUNCTION(OPTIONAL, PyObject *, PyFrozenSet_New, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyModule_AddObject, PyObject *mod, const char *, PyObject *value) \
+    FUNCTION(OPTIONAL, int, PyThread_tss_is_created, Py_tss_t *key) \
+    FUNCTION(OPTIONAL, wchar_t *, Py_DecodeLocale,const char *arg,size_t *size) \
+    FUNCTION(OPTIONAL, int, PyErr_GivenExceptionMatches, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, unsigned long, PyThread_start_new_thread, void (*)(void *), void *) \
+    FUNCTION(OPTIONAL, int, PyRun_InteractiveLoopFlags,FILE *fp,const char *filename,       /* decoded from the filesystem encoding */PyCompilerFlags *flags) \
+    FUNCTION(OPTIONAL, void, PyInterpreterState_Clear, PyInterpreterState *) \
+    TYPE(OPTIONAL, PyBytesIO_Type) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_BuildEncodingMap,PyObject* string            /* 256 character map */) \
+    FUNCTION(OPTIONAL, wchar_t *, Py_GetPrefix, void) \
+    TYPE(OPTIONAL, PyList_Type) \
+    FUNCTION(OPTIONAL, int, PyObject_CallFinalizerFromDealloc, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyMarshal_ReadLastObjectFromFile, FILE *) \
+    FUNCTION(OPTIONAL, int, PyErr_ResourceWarning,PyObject *source,Py_ssize_t stack_level,const char *format,         /* ASCII-encoded string  */...) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_Decoder,const char *encoding) \
+    FUNCTION(OPTIONAL, void, PySys_SetPath, const wchar_t *) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Rshift, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_AsCharmapString,PyObject *unicode,          /* Unicode object */PyObject *mapping           /* encoding mapping */) \
+    FUNCTION(OPTIONAL, PyOS_sighandler_t, PyOS_getsig, int) \
+    FUNCTION(OPTIONAL, PyObject *, PyByteArray_FromStringAndSize, const char *, Py_ssize_t) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_InPlaceXor, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, void *, PyBuffer_GetPointer, Py_buffer *view, Py_ssize_t *indices) \
+    FUNCTION(OPTIONAL, PyObject *, PyByteArray_FromObject, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyLong_FromDouble, double) \
+    FUNCTION(OPTIONAL, void, Py_InitializeEx, int) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Positive, PyObject *o) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyBytes_Size, PyObject *) \
+    TYPE(OPTIONAL, PyDictProxy_Type) \
+    TYPE(OPTIONAL, PyBufferedRandom_Type) \
+    FUNCTION(OPTIONAL, char *, Py_UniversalNewlineFgets, char *, int, FILE*, PyObject *) \
+    FUNCTION(REQUIRED, void, PyErr_Print, void) \
+    FUNCTION(OPTIONAL, PyObject *, PySequence_InPlaceConcat, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, int, PyStatus_IsExit, PyStatus err) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_InPlaceRshift, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PySequence_Size, PyObject *o) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_GetItem, PyObject *o, PyObject *key) \
+    TYPE(OPTIONAL, PyDictValues_Type) \
+    TYPE(OPTIONAL, PyBytesIter_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_GetIter, PyObject *) \
+    TYPE(OPTIONAL, PyTextIOBase_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyWeakref_GetObject, PyObject *ref) \
+    FUNCTION(OPTIONAL, Py_UCS4*, PyUnicode_AsUCS4Copy, PyObject *unicode) \
+    FUNCTION(OPTIONAL, unsigned long, PyThread_get_thread_native_id, void) \
+    FUNCTION(OPTIONAL, PyObject *, PyMemoryView_FromMemory, char *mem, Py_ssize_t size,int flags) \
+    FUNCTION(OPTIONAL, long, PyMarshal_ReadLongFromFile, FILE *) \
+    FUNCTION(OPTIONAL, void, PyOS_BeforeFork, void) \
+    FUNCTION(OPTIONAL, PyVarObject *, PyObject_InitVar, PyVarObject *,PyTypeObject *, Py_ssize_t) \
+    FUNCTION(OPTIONAL, int, PyList_Append, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, PyThreadState *, PyThreadState_Swap, PyThreadState *) \
+    FUNCTION(OPTIONAL, int, PyObject_GetBuffer, PyObject *obj, Py_buffer *view,int flags) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyNumber_AsSsize_t, PyObject *o, PyObject *exc) \
+    FUNCTION(REQUIRED, unsigned long, PyThread_get_thread_ident, void) \
+    FUNCTION(OPTIONAL, int, PyMember_SetOne, char *, struct PyMemberDef *, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyErr_FormatV,PyObject *exception,const char *format,va_list vargs) \
+    FUNCTION(OPTIONAL, void, Py_ExitStatusException, PyStatus err) \
+    FUNCTION(OPTIONAL, void, PyErr_SyntaxLocationObject,PyObject *filename,int lineno,int col_offset) \
+    FUNCTION(OPTIONAL, PyObject *, PyEval_GetGlobals, void) \
+    FUNCTION(OPTIONAL, int, PyMapping_Check, PyObject *o) \
+    FUNCTION(OPTIONAL, int, PyObject_DelItemString, PyObject *o, const char *key) \
+    FUNCTION(OPTIONAL, void, PyUnicode_Append,PyObject **pleft,           /* Pointer to left string */PyObject *right             /* Right string */) \
+    FUNCTION(OPTIONAL, int, Py_ReprEnter, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyMapping_HasKeyString, PyObject *o, const char *key) \
+    FUNCTION(OPTIONAL, void, Py_GetArgcArgv, int *argc, wchar_t ***argv) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_CallFunctionObjArgs, PyObject *callable,...) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeCharmap,const char *string,         /* Encoded string */Py_ssize_t length,          /* size of string */PyObject *mapping,          /* decoding mapping */const char *errors          /* error handling */) \
+    FUNCTION(OPTIONAL, PyObject *, PyImport_ImportModuleNoBlock,const char *name            /* UTF-8 encoded string */) \
+    TYPE(OPTIONAL, PyGetSetDescr_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyModule_NewObject,PyObject *name) \
+    FUNCTION(OPTIONAL, double, PyFloat_GetMin, void) \
+    FUNCTION(OPTIONAL, wchar_t*, PyUnicode_AsWideCharString,PyObject *unicode,          /* Unicode object */Py_ssize_t *size            /* number of characters of the result */) \
+    FUNCTION(OPTIONAL, int, PySequence_Check, PyObject *o) \
+    FUNCTION(OPTIONAL, void, PyBytes_Concat, PyObject **, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyDescr_NewClassMethod, PyTypeObject *, PyMethodDef *) \
+    TYPE(OPTIONAL, PyFileIO_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicodeDecodeError_GetObject, PyObject *) \
+    FUNCTION(OPTIONAL, void, PyEval_AcquireThread, PyThreadState *tstate) \
+    FUNCTION(OPTIONAL, PyStatus, PyStatus_NoMemory, void) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Power, PyObject *o1, PyObject *o2,PyObject *o3) \
+    FUNCTION(OPTIONAL, PyObject *, PyErr_SetFromErrnoWithFilename,PyObject *exc,const char *filename   /* decoded from the filesystem encoding */) \
+    TYPE(OPTIONAL, PyTuple_Type) \
+    FUNCTION(OPTIONAL, void *, PyCapsule_GetPointer, PyObject *capsule, const char *name) \
+    FUNCTION(OPTIONAL, int, PyUnicodeEncodeError_GetEnd, PyObject *, Py_ssize_t *) \
+    FUNCTION(OPTIONAL, PyObject *, PyErr_ProgramText,const char *filename,       /* decoded from the filesystem encoding */int lineno) \
+    FUNCTION(OPTIONAL, PyObject *, PyDict_GetItemString, PyObject *dp, const char *key) \
+    FUNCTION(OPTIONAL, void, PyFrame_LocalsToFast, PyFrameObject *, int) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_TrueDivide, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, int, PyFunction_SetKwDefaults, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, void, PyObject_GC_UnTrack, void *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_EncodeUTF16,PyObject* unicode,          /* Unicode object */const char *errors,         /* error handling */int byteorder               /* byteorder to use 0=BOM+native;-1=LE,1=BE */) \
+    FUNCTION(OPTIONAL, void, PyFrame_FastToLocals, PyFrameObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Absolute, PyObject *o) \
+    FUNCTION(OPTIONAL, int64_t, PyInterpreterState_GetID, PyInterpreterState *) \
+    FUNCTION(OPTIONAL, int, PyFunction_SetClosure, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, int, PySys_SetObject, const char *, PyObject *) \
+    FUNCTION(OPTIONAL, PyOS_sighandler_t, PyOS_setsig, int, PyOS_sighandler_t) \
+    FUNCTION(OPTIONAL, int, PyFrame_GetLineNumber, PyFrameObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyGen_NewWithQualName, PyFrameObject *,PyObject *name, PyObject *qualname) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeRawUnicodeEscape,const char *string,         /* Raw-Unicode-Escape encoded string */Py_ssize_t length,          /* size of string */const char *errors          /* error handling */) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Divmod, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_FromStringAndSize,const char *u,             /* UTF-8 encoded string */Py_ssize_t size            /* size of buffer */) \
+    FUNCTION(OPTIONAL, int, PyObject_GenericSetDict, PyObject *, PyObject *, void *) \
+    FUNCTION(OPTIONAL, void, PyEval_SetTrace, Py_tracefunc, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyCallable_Check, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_InPlaceSubtract, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, unsigned long, PyLong_AsUnsignedLongMask, PyObject *) \
+    FUNCTION(OPTIONAL, PyInterpreterState *, PyInterpreterState_Head, void) \
+    TYPE(OPTIONAL, PyEnum_Type) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeUTF7,const char *string,         /* UTF-7 encoded string */Py_ssize_t length,          /* size of string */const char *errors          /* error handling */) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeUTF8,const char *string,         /* UTF-8 encoded string */Py_ssize_t length,          /* size of string */const char *errors          /* error handling */) \
+    FUNCTION(OPTIONAL, int, PyObject_SetAttrString, PyObject *, const char *, PyObject *) \
+    FUNCTION(OPTIONAL, int, Py_SetStandardStreamEncoding, const char *encoding,const char *errors) \
+    FUNCTION(OPTIONAL, int, PyContextVar_Reset, PyObject *var, PyObject *token) \
+    FUNCTION(OPTIONAL, int, PyImport_AppendInittab,const char *name,           /* ASCII encoded string */PyObject* (*initfunc)(void)) \
+    FUNCTION(OPTIONAL, void, PyThread_tss_free, Py_tss_t *key) \
+    FUNCTION(OPTIONAL, int, PySet_Clear, PyObject *set) \
+    FUNCTION(OPTIONAL, int, PyThread_acquire_lock, PyThread_type_lock, int) \
+    FUNCTION(OPTIONAL, int, PyUnicode_Compare,PyObject *left,             /* Left string */PyObject *right             /* Right string */) \
+    FUNCTION(OPTIONAL, PyObject *, PyFunction_GetAnnotations, PyObject *) \
+    FUNCTION(OPTIONAL, const Py_UNICODE *, PyUnicode_AsUnicode,PyObject *unicode           /* Unicode object */) \
+    FUNCTION(OPTIONAL, PyCodeObject *, PyCode_New,int, int, int, int, int, PyObject *, PyObject *,PyObject *, PyObject *, PyObject *, PyObject *,PyObject *, PyObject *, int, PyObject *) \
+    TYPE(OPTIONAL, PyCallIter_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyErr_SetFromErrnoWithFilenameObject,PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, int, PySet_Contains, PyObject *anyset, PyObject *key) \
+    FUNCTION(OPTIONAL, int, PySlice_GetIndicesEx, PyObject *r, Py_ssize_t length,Py_ssize_t *start, Py_ssize_t *stop,Py_ssize_t *step,Py_ssize_t *slicelength) \
+    FUNCTION(OPTIONAL, const char *, Py_GetCompiler, void) \
+    FUNCTION(OPTIONAL, PyObject *, Py_CompileString, const char *, const char *, int) \
+    FUNCTION(REQUIRED, PyObject*, PyUnicode_FromString,const char *u              /* UTF-8 encoded string */) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_Repr, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyState_FindModule, struct PyModuleDef*) \
+    FUNCTION(OPTIONAL, PyObject *, PyMethod_Function, PyObject *) \
+    FUNCTION(OPTIONAL, void, PyErr_SetObject, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyEval_MergeCompilerFlags, PyCompilerFlags *cf) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_CallObject, PyObject *callable,PyObject *args) \
+    TYPE(OPTIONAL, PyStdPrinter_Type) \
+    TYPE(OPTIONAL, PyDictIterValue_Type) \
+    TYPE(OPTIONAL, PyIOBase_Type) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_FromKindAndData,int kind,const void *buffer,Py_ssize_t size) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_StreamReader,const char *encoding,PyObject *stream,const char *errors) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeFSDefaultAndSize,const char *s,               /* encoded string */Py_ssize_t size              /* size */) \
+    FUNCTION(OPTIONAL, int, PyDict_Contains, PyObject *mp, PyObject *key) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_Substring,PyObject *str,Py_ssize_t start,Py_ssize_t end) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Or, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_RSplit,PyObject *s,                /* String to split */PyObject *sep,              /* String separator */Py_ssize_t maxsplit         /* Maxsplit count */) \
+    FUNCTION(OPTIONAL, int, PyRun_InteractiveOneObject,FILE *fp,PyObject *filename,PyCompilerFlags *flags) \
+    TYPE(OPTIONAL, PyMemberDescr_Type) \
+    TYPE(OPTIONAL, PyDictRevIterValue_Type) \
+    FUNCTION(REQUIRED, void, Py_DecRef, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeUTF32Stateful,const char *string,         /* UTF-32 encoded string */Py_ssize_t length,          /* size of string */const char *errors,         /* error handling */int *byteorder,             /* pointer to byteorder to use0=native;-1=LE,1=BE; updated onexit */Py_ssize_t *consumed        /* bytes consumed */) \
+    FUNCTION(OPTIONAL, int, PyRun_SimpleFileExFlags,FILE *fp,const char *filename,       /* decoded from the filesystem encoding */int closeit,PyCompilerFlags *flags) \
+    FUNCTION(OPTIONAL, PyObject *, PyMethod_New, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyType_FromSpec, PyType_Spec*) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_EncodeUTF32,PyObject *object,           /* Unicode object */const char *errors,         /* error handling */int byteorder               /* byteorder to use 0=BOM+native;-1=LE,1=BE */) \
+    FUNCTION(OPTIONAL, void, PyConfig_InitIsolatedConfig, PyConfig *config) \
+    FUNCTION(OPTIONAL, void, Py_SetProgramName, const wchar_t *) \
+    FUNCTION(OPTIONAL, int, PyUnicodeTranslateError_GetEnd, PyObject *, Py_ssize_t *) \
+    FUNCTION(OPTIONAL, PyObject *, PyBytes_FromString, const char *) \
+    FUNCTION(OPTIONAL, int, PyUnicodeTranslateError_SetStart, PyObject *, Py_ssize_t) \
+    FUNCTION(OPTIONAL, int, Py_FinalizeEx, void) \
+    FUNCTION(REQUIRED, PyObject *, PyImport_GetModuleDict, void) \
+    FUNCTION(OPTIONAL, int, PySys_HasWarnOptions, void) \
+    FUNCTION(OPTIONAL, void, PyUnicode_InternInPlace, PyObject **) \
+    FUNCTION(OPTIONAL, int, PyModule_AddIntConstant, PyObject *, const char *, long) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyObject_LengthHint, PyObject *o, Py_ssize_t) \
+    TYPE(OPTIONAL, PyCapsule_Type) \
+    FUNCTION(OPTIONAL, int, PyContext_Exit, PyObject *) \
+    FUNCTION(OPTIONAL, PyStatus, PyConfig_SetString,PyConfig *config,wchar_t **config_str,const wchar_t *str) \
+    FUNCTION(OPTIONAL, PyStatus, PyConfig_SetBytesArgv,PyConfig *config,Py_ssize_t argc,char * const *argv) \
+    FUNCTION(OPTIONAL, PyObject *, PyEval_EvalFrameEx, PyFrameObject *f, int exc) \
+    FUNCTION(OPTIONAL, int, PyUnicodeEncodeError_SetEnd, PyObject *, Py_ssize_t) \
+    FUNCTION(OPTIONAL, int, PyIter_Check, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyState_AddModule, PyObject*, struct PyModuleDef*) \
+    FUNCTION(OPTIONAL, void, PySys_AddWarnOptionUnicode, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyContext_Copy, PyObject *) \
+    TYPE(OPTIONAL, PyByteArrayIter_Type) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeFSDefault,const char *s               /* encoded string */) \
+    FUNCTION(OPTIONAL, PyObject *, PyStaticMethod_New, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyCell_Set, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyContextVar_New,const char *name, PyObject *default_value) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_MatrixMultiply, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, PyObject *, PyCoro_New, PyFrameObject *,PyObject *name, PyObject *qualname) \
+    FUNCTION(OPTIONAL, int, PyRun_SimpleStringFlags, const char *, PyCompilerFlags *) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyUnicode_GetLength,PyObject *unicode) \
+    FUNCTION(OPTIONAL, int, PyModule_AddStringConstant, PyObject *, const char *, const char *) \
+    FUNCTION(OPTIONAL, PyObject *, PyAsyncGen_New, PyFrameObject *,PyObject *name, PyObject *qualname) \
+    FUNCTION(OPTIONAL, PyStatus, PyWideStringList_Insert, PyWideStringList *list,Py_ssize_t index,const wchar_t *item) \
+    TYPE(OPTIONAL, PyCode_Type) \
+    TYPE(OPTIONAL, PyProperty_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyException_GetContext, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyEval_GetBuiltins, void) \
+    FUNCTION(OPTIONAL, int, PyMapping_HasKey, PyObject *o, PyObject *key) \
+    FUNCTION(OPTIONAL, PyObject *, PyImport_ImportModuleLevel,const char *name,           /* UTF-8 encoded string */PyObject *globals,PyObject *locals,PyObject *fromlist,int level) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyGC_Collect, void) \
+    TYPE(OPTIONAL, PyRange_Type) \
+    FUNCTION(OPTIONAL, PyTypeObject*, PyStructSequence_NewType, PyStructSequence_Desc *desc) \
+    FUNCTION(OPTIONAL, void, PyThread_exit_thread, void) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyUnicode_Count,PyObject *str,              /* String */PyObject *substr,           /* Substring to count */Py_ssize_t start,           /* Start index */Py_ssize_t end              /* Stop index */) \
+    FUNCTION(OPTIONAL, void, PyThread_init_thread, void) \
+    FUNCTION(OPTIONAL, PyObject *, PyErr_SetImportError, PyObject *, PyObject *,PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_FromEncodedObject,PyObject *obj,              /* Object */const char *encoding,       /* encoding */const char *errors          /* error handling */) \
+    FUNCTION(OPTIONAL, PyFrameObject *, PyEval_GetFrame, void) \
+    FUNCTION(OPTIONAL, PyObject *, PyLong_FromUnsignedLong, unsigned long) \
+    FUNCTION(OPTIONAL, void *, PyMem_RawMalloc, size_t size) \
+    TYPE(OPTIONAL, PyBool_Type) \
+    FUNCTION(OPTIONAL, void, PyFrame_BlockSetup, PyFrameObject *, int, int, int) \
+    TYPE(OPTIONAL, PyDictItems_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyEval_EvalCodeEx, PyObject *co,PyObject *globals,PyObject *locals,PyObject *const *args, int argc,PyObject *const *kwds, int kwdc,PyObject *const *defs, int defc,PyObject *kwdefs, PyObject *closure) \
+    FUNCTION(OPTIONAL, wchar_t *, Py_GetProgramFullPath, void) \
+    FUNCTION(OPTIONAL, int, PyArg_Parse, PyObject *, const char *, ...) \
+    FUNCTION(OPTIONAL, PyObject *, PyInstanceMethod_Function, PyObject *) \
+    FUNCTION(OPTIONAL, void, PyObject_Free, void *ptr) \
+    FUNCTION(OPTIONAL, PyThreadState *, PyGILState_GetThisThreadState, void) \
+    TYPE(OPTIONAL, PyUnicodeIter_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicodeDecodeError_Create,const char *encoding,       /* UTF-8 encoded string */const char *object,Py_ssize_t length,Py_ssize_t start,Py_ssize_t end,const char *reason          /* UTF-8 encoded string */) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyLong_AsSsize_t, PyObject *) \
+    TYPE(OPTIONAL, PyComplex_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_And, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, void, PyErr_SyntaxLocation,const char *filename,       /* decoded from the filesystem encoding */int lineno) \
+    FUNCTION(OPTIONAL, PyObject*, PyType_FromSpecWithBases, PyType_Spec*, PyObject*) \
+    FUNCTION(OPTIONAL, void, PyObject_GC_Del, void *) \
+    FUNCTION(OPTIONAL, int, PyCode_Addr2Line, PyCodeObject *, int) \
+    FUNCTION(OPTIONAL, long long, PyLong_AsLongLongAndOverflow, PyObject *, int *) \
+    FUNCTION(OPTIONAL, int, PyRun_AnyFileExFlags,FILE *fp,const char *filename,       /* decoded from the filesystem encoding */int closeit,PyCompilerFlags *flags) \
+    TYPE(OPTIONAL, PyTextIOWrapper_Type) \
+    FUNCTION(OPTIONAL, unsigned long, PyOS_strtoul, const char *, char **, int) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_ASCII, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyImport_ReloadModule, PyObject *m) \
+    FUNCTION(OPTIONAL, PyObject *, PyMapping_Items, PyObject *o) \
+    FUNCTION(OPTIONAL, PyObject *, PySequence_Fast, PyObject *o, const char* m) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_RichCompare, PyObject *, PyObject *, int) \
+    FUNCTION(OPTIONAL, void, PyObject_GC_Track, void *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_AsEncodedString,PyObject *unicode,          /* Unicode object */const char *encoding,       /* encoding */const char *errors          /* error handling */) \
+    FUNCTION(OPTIONAL, PyObject *, PyDict_Copy, PyObject *mp) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicodeEncodeError_GetObject, PyObject *) \
+    FUNCTION(OPTIONAL, int, Py_Main, int argc, wchar_t **argv) \
+    FUNCTION(OPTIONAL, PyObject *, PyModule_GetFilenameObject, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyFunction_SetDefaults, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, void *, PyLong_AsVoidPtr, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyUnicodeTranslateError_SetEnd, PyObject *, Py_ssize_t) \
+    FUNCTION(OPTIONAL, char*, Py_EncodeLocale,const wchar_t *text,size_t *error_pos) \
+    FUNCTION(REQUIRED, int, PyDict_SetItemString, PyObject *dp, const char *key, PyObject *item) \
+    FUNCTION(OPTIONAL, PyObject *, PyCFunction_NewEx, PyMethodDef *, PyObject *,PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_ReplaceErrors, PyObject *exc) \
+    FUNCTION(REQUIRED, PyObject *, PyErr_NewException,const char *name, PyObject *base, PyObject *dict) \
+    FUNCTION(OPTIONAL, PyObject *, PyDict_GetItemWithError, PyObject *mp, PyObject *key) \
+    TYPE(OPTIONAL, PyODict_Type) \
+    FUNCTION(OPTIONAL, void, PyStructSequence_SetItem, PyObject*, Py_ssize_t, PyObject*) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicode_Replace,PyObject *str,              /* String */PyObject *substr,           /* Substring to find */PyObject *replstr,          /* Substring to replace */Py_ssize_t maxcount         /* Max. number of replacements to apply;-1 = all */) \
+    FUNCTION(OPTIONAL, long long, PyLong_AsLongLong, PyObject *) \
+    FUNCTION(OPTIONAL, void, PyErr_NormalizeException, PyObject**, PyObject**, PyObject**) \
+    FUNCTION(OPTIONAL, PyObject *, PyList_GetSlice, PyObject *, Py_ssize_t, Py_ssize_t) \
+    FUNCTION(OPTIONAL, unsigned long, PyLong_AsUnsignedLong, PyObject *) \
+    FUNCTION(OPTIONAL, PyThreadState *, PyThreadState_Get, void) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_AsUTF8String,PyObject *unicode           /* Unicode object */) \
+    TYPE(OPTIONAL, PyFilter_Type) \
+    FUNCTION(OPTIONAL, void, PyErr_WriteUnraisable, PyObject *) \
+    TYPE(OPTIONAL, PyODictItems_Type) \
+    TYPE(OPTIONAL, PyBaseObject_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PySlice_New, PyObject* start, PyObject* stop,PyObject* step) \
+    FUNCTION(OPTIONAL, PyObject *, PyFunction_GetDefaults, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyFrame_FastToLocalsWithError, PyFrameObject *f) \
+    FUNCTION(OPTIONAL, PyObject *, PyMethod_Self, PyObject *) \
+    FUNCTION(OPTIONAL, void*, PyType_GetSlot, PyTypeObject*, int) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyUnicode_AsWideChar,PyObject *unicode,          /* Unicode object */wchar_t *w,                 /* wchar_t buffer */Py_ssize_t size             /* size of buffer */) \
+    FUNCTION(OPTIONAL, int, PyObject_AsCharBuffer, PyObject *obj,const char **buffer,Py_ssize_t *buffer_len) \
+    FUNCTION(OPTIONAL, void, PyBuffer_Release, Py_buffer *view) \
+    FUNCTION(REQUIRED, PyObject *, PyObject_GetAttrString, PyObject *, const char *) \
+    FUNCTION(OPTIONAL, PyObject *, PyDescr_NewMember, PyTypeObject *,struct PyMemberDef *) \
+    FUNCTION(OPTIONAL, int, PyList_Reverse, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyEval_EvalFrame, PyFrameObject *) \
+    TYPE(OPTIONAL, PyContext_Type) \
+    FUNCTION(OPTIONAL, int, PyCodec_KnownEncoding,const char *encoding) \
+    FUNCTION(OPTIONAL, PyObject *, PyDict_SetDefault,PyObject *mp, PyObject *key, PyObject *defaultobj) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_FromObject,PyObject *obj      /* Object */) \
+    FUNCTION(OPTIONAL, PyObject *, PyMarshal_ReadObjectFromFile, FILE *) \
+    FUNCTION(OPTIONAL, double, PyOS_string_to_double, const char *str,char **endptr,PyObject *overflow_exception) \
+    FUNCTION(OPTIONAL, void, PyMarshal_WriteLongToFile, long, FILE *, int) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_Decode,const char *s,              /* encoded string */Py_ssize_t size,            /* size of buffer */const char *encoding,       /* encoding */const char *errors          /* error handling */) \
+    FUNCTION(OPTIONAL, int, PyObject_SetItem, PyObject *o, PyObject *key, PyObject *v) \
+    FUNCTION(OPTIONAL, void, PySys_SetArgvEx, int, wchar_t **, int) \
+    FUNCTION(OPTIONAL, int, PyType_IsSubtype, PyTypeObject *, PyTypeObject *) \
+    FUNCTION(OPTIONAL, int, PyRun_SimpleFile, FILE *f, const char *p) \
+    FUNCTION(OPTIONAL, const char *, Py_GetVersion, void) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Float, PyObject *o) \
+    FUNCTION(OPTIONAL, PyObject *, PyCallIter_New, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, int, Py_MakePendingCalls, void) \
+    FUNCTION(OPTIONAL, void, PyEval_ReleaseThread, PyThreadState *tstate) \
+    FUNCTION(OPTIONAL, PyObject *, PyFloat_FromDouble, double) \
+    FUNCTION(OPTIONAL, PyObject *, PyFunction_GetClosure, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyCompile_OpcodeStackEffectWithJump, int opcode, int oparg, int jump) \
+    FUNCTION(OPTIONAL, PyObject *, PyErr_SetImportErrorSubclass, PyObject *, PyObject *,PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyBytes_FromObject, PyObject *) \
+    FUNCTION(OPTIONAL, int, Py_RunMain, void) \
+    FUNCTION(OPTIONAL, PyStatus, Py_PreInitialize,const PyPreConfig *src_config) \
+    FUNCTION(OPTIONAL, PyObject *, PyFunction_New, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyBuffer_FillInfo, Py_buffer *view, PyObject *o, void *buf,Py_ssize_t len, int readonly,int flags) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Index, PyObject *o) \
+    FUNCTION(OPTIONAL, PyObject *, PyList_AsTuple, PyObject *) \
+    TYPE(OPTIONAL, PyDictRevIterKey_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_Encoder,const char *encoding) \
+    FUNCTION(REQUIRED, PyThreadState *, PyEval_SaveThread, void) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_Join,PyObject *separator,        /* Separator string */PyObject *seq               /* Sequence object */) \
+    FUNCTION(OPTIONAL, wchar_t *, Py_GetPath, void) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PySequence_Count, PyObject *o, PyObject *value) \
+    FUNCTION(OPTIONAL, int, PyOS_InterruptOccurred, void) \
+    FUNCTION(OPTIONAL, int, PyException_SetTraceback, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PySequence_GetSlice, PyObject *o, Py_ssize_t i1, Py_ssize_t i2) \
+    TYPE(OPTIONAL, PyDictKeys_Type) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyUnicode_FindChar,PyObject *str,Py_UCS4 ch,Py_ssize_t start,Py_ssize_t end,int direction) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_AsUnicodeEscapeString,PyObject *unicode           /* Unicode object */) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeUTF16,const char *string,         /* UTF-16 encoded string */Py_ssize_t length,          /* size of string */const char *errors,         /* error handling */int *byteorder              /* pointer to byteorder to use0=native;-1=LE,1=BE; updated onexit */) \
+    FUNCTION(OPTIONAL, PyObject *, PyLong_FromString, const char *, char **, int) \
+    FUNCTION(OPTIONAL, void, PyType_Modified, PyTypeObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeUnicodeEscape,const char *string,         /* Unicode-Escape encoded string */Py_ssize_t length,          /* size of string */const char *errors          /* error handling */) \
+    FUNCTION(OPTIONAL, PyObject *, PySequence_InPlaceRepeat, PyObject *o, Py_ssize_t count) \
+    FUNCTION(OPTIONAL, PyObject *, PySequence_Concat, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_InPlaceOr, PyObject *o1, PyObject *o2) \
+    TYPE(OPTIONAL, PyDict_Type) \
+    FUNCTION(OPTIONAL, size_t, PyLong_AsSize_t, PyObject *) \
+    FUNCTION(OPTIONAL, int, Py_FdIsInteractive, FILE *, const char *) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicodeDecodeError_GetReason, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Remainder, PyObject *o1, PyObject *o2) \
+    TYPE(OPTIONAL, PySTEntry_Type) \
+    FUNCTION(OPTIONAL, int, PyOS_mystricmp, const char *, const char *) \
+    FUNCTION(OPTIONAL, PyObject *, PyMapping_GetItemString, PyObject *o,const char *key) \
+    FUNCTION(OPTIONAL, int, PyDict_Next,PyObject *mp, Py_ssize_t *pos, PyObject **key, PyObject **value) \
+    FUNCTION(OPTIONAL, void, PyObject_SetArenaAllocator, PyObjectArenaAllocator *allocator) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_InPlaceAdd, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, void, Py_Initialize, void) \
+    FUNCTION(OPTIONAL, int, PyBytes_AsStringAndSize,PyObject *obj,      /* bytes object */char **s,           /* pointer to buffer variable */Py_ssize_t *len     /* pointer to length variable or NULL */) \
+    FUNCTION(OPTIONAL, int, PyToken_OneChar, int) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_Decode,PyObject *object,const char *encoding,const char *errors) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeLocale,const char *str,const char *errors) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_InPlaceMatrixMultiply, PyObject *o1, PyObject *o2) \
+    FUNCTION(OPTIONAL, int, PyODict_DelItem, PyObject *od, PyObject *key) \
+    FUNCTION(OPTIONAL, int, PyObject_CopyData, PyObject *dest, PyObject *src) \
+    TYPE(OPTIONAL, PySet_Type) \
+    FUNCTION(OPTIONAL, double, PyFloat_AsDouble, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicode_Translate,PyObject *str,              /* String */PyObject *table,            /* Translate table */const char *errors          /* error handling */) \
+    FUNCTION(OPTIONAL, PyObject *, PyLong_FromLongLong, long long) \
+    FUNCTION(OPTIONAL, void, PyErr_SetInterrupt, void) \
+    TYPE(OPTIONAL, PyRangeIter_Type) \
+    FUNCTION(OPTIONAL, void, PyMem_SetupDebugHooks, void) \
+    FUNCTION(OPTIONAL, int, PyErr_WarnEx,PyObject *category,const char *message,        /* UTF-8 encoded string */Py_ssize_t stack_level) \
+    FUNCTION(OPTIONAL, double, PyComplex_RealAsDouble, PyObject *op) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_AsUTF16String,PyObject *unicode           /* Unicode object */) \
+    TYPE(OPTIONAL, PyMethod_Type) \
+    TYPE(OPTIONAL, PyContextVar_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyDescr_NewGetSet, PyTypeObject *,struct PyGetSetDef *) \
+    FUNCTION(OPTIONAL, unsigned long long, PyLong_AsUnsignedLongLongMask, PyObject *) \
+    FUNCTION(OPTIONAL, int, PySet_Discard, PyObject *set, PyObject *key) \
+    FUNCTION(OPTIONAL, PyObject *, PyFile_OpenCode, const char *utf8path) \
+    FUNCTION(OPTIONAL, PyLockStatus, PyThread_acquire_lock_timed, PyThread_type_lock,PY_TIMEOUT_T microseconds,int intr_flag) \
+    FUNCTION(OPTIONAL, void, PyErr_Display, PyObject *, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_DecodeUTF32,const char *string,         /* UTF-32 encoded string */Py_ssize_t length,          /* size of string */const char *errors,         /* error handling */int *byteorder              /* pointer to byteorder to use0=native;-1=LE,1=BE; updated onexit */) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_FromOrdinal, int ordinal) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyByteArray_Size, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_XMLCharRefReplaceErrors, PyObject *exc) \
+    FUNCTION(OPTIONAL, PyObject *, PyMapping_Keys, PyObject *o) \
+    FUNCTION(OPTIONAL, int, PyUnicodeEncodeError_GetStart, PyObject *, Py_ssize_t *) \
+    FUNCTION(OPTIONAL, PyObject *, PyImport_ExecCodeModule,const char *name,           /* UTF-8 encoded string */PyObject *co) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_Encode,PyObject *object,const char *encoding,const char *errors) \
+    TYPE(OPTIONAL, PyType_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyErr_ProgramTextObject,PyObject *filename,int lineno) \
+    FUNCTION(OPTIONAL, void, PyErr_SetNone, PyObject *) \
+    FUNCTION(OPTIONAL, void, PyException_SetCause, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyRun_String, const char *str, int s, PyObject *g, PyObject *l) \
+    FUNCTION(OPTIONAL, PyObject *, PyCFunction_New, PyMethodDef *, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyClassMethod_New, PyObject *) \
+    TYPE(OPTIONAL, PyODictValues_Type) \
+    FUNCTION(OPTIONAL, int, PyModule_ExecDef, PyObject *module, PyModuleDef *def) \
+    FUNCTION(OPTIONAL, int, PyTraceMalloc_Track,unsigned int domain,uintptr_t ptr,size_t size) \
+    FUNCTION(OPTIONAL, int, PyByteArray_Resize, PyObject *, Py_ssize_t) \
+    FUNCTION(OPTIONAL, PyObject *, PyList_GetItem, PyObject *, Py_ssize_t) \
+    FUNCTION(OPTIONAL, PyObject *, Py_VaBuildValue, const char *, va_list) \
+    FUNCTION(OPTIONAL, int, PyObject_Print, PyObject *, FILE *, int) \
+    FUNCTION(OPTIONAL, char *, PyByteArray_AsString, PyObject *) \
+    FUNCTION(REQUIRED, long, PyLong_AsLong, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyFile_SetOpenCodeHook, Py_OpenCodeHookFunction hook, void *userData) \
+    FUNCTION(OPTIONAL, PyObject *, PyObject_GenericGetAttr, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, Py_hash_t, PyObject_Hash, PyObject *) \
+    FUNCTION(OPTIONAL, int, Py_GetRecursionLimit, void) \
+    FUNCTION(OPTIONAL, void, PyPreConfig_InitPythonConfig, PyPreConfig *config) \
+    FUNCTION(OPTIONAL, PyInterpreterState *, PyInterpreterState_Main, void) \
+    FUNCTION(OPTIONAL, PyObject *, PyImport_ImportModule,const char *name            /* UTF-8 encoded string */) \
+    FUNCTION(OPTIONAL, int, Py_BytesMain, int argc, char **argv) \
+    FUNCTION(OPTIONAL, PyObject *, PyDescr_NewWrapper, PyTypeObject *,struct wrapperbase *, void *) \
+    FUNCTION(OPTIONAL, PyObject *, PyImport_ExecCodeModuleObject,PyObject *name,PyObject *co,PyObject *pathname,PyObject *cpathname) \
+    FUNCTION(OPTIONAL, PyObject *, PyErr_Format,PyObject *exception,const char *format,   /* ASCII-encoded string  */...) \
+    FUNCTION(OPTIONAL, PyObject *, PySet_New, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyObject_Not, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyDict_DelItem, PyObject *mp, PyObject *key) \
+    TYPE(OPTIONAL, PyRawIOBase_Type) \
+    FUNCTION(OPTIONAL, PyStatus, PyConfig_SetWideStringList, PyConfig *config,PyWideStringList *list,Py_ssize_t length, wchar_t **items) \
+    FUNCTION(OPTIONAL, int, PyUnicodeDecodeError_SetStart, PyObject *, Py_ssize_t) \
+    FUNCTION(OPTIONAL, PyObject *, PyFunction_GetModule, PyObject *) \
+    FUNCTION(OPTIONAL, const char *, PyUnicode_AsUTF8, PyObject *unicode) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_RPartition,PyObject *s,                /* String to partition */PyObject *sep               /* String separator */) \
+    FUNCTION(OPTIONAL, PyObject *, PyNumber_Invert, PyObject *o) \
+    FUNCTION(OPTIONAL, void, PyObject_ClearWeakRefs, PyObject *) \
+    TYPE(OPTIONAL, PyBufferedWriter_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyFile_NewStdPrinter, int) \
+    FUNCTION(OPTIONAL, PyObject *, PyVectorcall_Call, PyObject *callable, PyObject *tuple, PyObject *dict) \
+    TYPE(OPTIONAL, PyContextTokenMissing_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyContextVar_Set, PyObject *var, PyObject *value) \
+    TYPE(OPTIONAL, PyBytes_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicode_FromFormatV,const char *format,   /* ASCII-encoded string  */va_list vargs) \
+    FUNCTION(OPTIONAL, void, PyErr_BadInternalCall, void) \
+    FUNCTION(OPTIONAL, int, PyUnicodeTranslateError_SetReason,PyObject *exc,const char *reason          /* UTF-8 encoded string */) \
+    FUNCTION(OPTIONAL, int, PyDict_MergeFromSeq2, PyObject *d,PyObject *seq2,int override) \
+    FUNCTION(OPTIONAL, PyFrameObject *, PyFrame_New, PyThreadState *, PyCodeObject *,PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyFunction_NewWithQualName, PyObject *, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, void *, PyMem_RawCalloc, size_t nelem, size_t elsize) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_IncrementalEncoder,const char *encoding,const char *errors) \
+    FUNCTION(OPTIONAL, PyObject *, PyStructSequence_New, PyTypeObject* type) \
+    FUNCTION(OPTIONAL, int, PyODict_SetItem, PyObject *od, PyObject *key, PyObject *item) \
+    FUNCTION(OPTIONAL, PyObject*, PyUnicode_TransformDecimalToASCII,Py_UNICODE *s,              /* Unicode buffer */Py_ssize_t length           /* Number of Py_UNICODE chars to transform */) \
+    FUNCTION(OPTIONAL, const char *, PyImport_GetMagicTag, void) \
+    FUNCTION(OPTIONAL, PyObject *, PyEval_GetLocals, void) \
+    FUNCTION(OPTIONAL, int, PyImport_ExtendInittab, struct _inittab *newtab) \
+    FUNCTION(OPTIONAL, PyObject *, PyRun_File, FILE *fp, const char *p, int s, PyObject *g, PyObject *l) \
+    FUNCTION(OPTIONAL, PyObject *, PyRun_FileFlags, FILE *fp, const char *p, int s, PyObject *g, PyObject *l, PyCompilerFlags *flags) \
+    FUNCTION(OPTIONAL, void, PyMem_Free, void *ptr) \
+    FUNCTION(OPTIONAL, PyObject *, PyErr_NoMemory, void) \
+    FUNCTION(OPTIONAL, int, PyCompile_OpcodeStackEffect, int opcode, int oparg) \
+    FUNCTION(OPTIONAL, int, PyFunction_SetAnnotations, PyObject *, PyObject *) \
+    TYPE(OPTIONAL, PyBufferedRWPair_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyThreadState_GetDict, void) \
+    FUNCTION(OPTIONAL, PyObject *, PyWeakref_NewProxy, PyObject *ob,PyObject *callback) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PySlice_AdjustIndices, Py_ssize_t length,Py_ssize_t *start, Py_ssize_t *stop,Py_ssize_t step) \
+    FUNCTION(OPTIONAL, PyObject *, PyModuleDef_Init, struct PyModuleDef*) \
+    FUNCTION(REQUIRED, PyObject *, PyModule_Create2, struct PyModuleDef*,int apiver) \
+    FUNCTION(OPTIONAL, void, PyMem_RawFree, void *ptr) \
+    FUNCTION(OPTIONAL, long, PyLong_AsLongAndOverflow, PyObject *, int *) \
+    FUNCTION(OPTIONAL, PyThreadState *, PyThreadState_Next, PyThreadState *) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyMapping_Size, PyObject *o) \
+    TYPE(OPTIONAL, PyTupleIter_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyTuple_GetSlice, PyObject *, Py_ssize_t, Py_ssize_t) \
+    TYPE(OPTIONAL, PyDictRevIterItem_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyCodec_IgnoreErrors, PyObject *exc) \
+    FUNCTION(OPTIONAL, PyObject *, PyFile_GetLine, PyObject *, int) \
+    FUNCTION(OPTIONAL, void, PyMem_GetAllocator, PyMemAllocatorDomain domain,PyMemAllocatorEx *allocator) \
+    FUNCTION(OPTIONAL, void, PyErr_SetExcInfo, PyObject *, PyObject *, PyObject *) \
+    TYPE(OPTIONAL, PyFrame_Type) \
+    FUNCTION(OPTIONAL, int, PyTraceBack_Here, PyFrameObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyImport_AddModuleObject,PyObject *name) \
+    FUNCTION(OPTIONAL, void, PySys_AddWarnOption, const wchar_t *) \
+    TYPE(OPTIONAL, PySlice_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyCell_Get, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyGILState_Check, void) \
+    FUNCTION(OPTIONAL, int, PyArg_UnpackTuple, PyObject *, const char *, Py_ssize_t, Py_ssize_t, ...) \
+    FUNCTION(OPTIONAL, PyObject *, PyUnicodeEncodeError_GetReason, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyRun_InteractiveOne, FILE *f, const char *p) \
+    FUNCTION(OPTIONAL, int, PyMapping_SetItemString, PyObject *o, const char *key,PyObject *value) \
+    FUNCTION(OPTIONAL, PyObject *, Py_CompileStringObject,const char *str,PyObject *filename, int start,PyCompilerFlags *flags,int optimize) \
+    FUNCTION(OPTIONAL, PyObject *, PyLong_FromUnsignedLongLong, unsigned long long) \
+    FUNCTION(OPTIONAL, int, PyThread_tss_create, Py_tss_t *key) \
+    FUNCTION(OPTIONAL, int, PyObject_AsFileDescriptor, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyImport_ImportFrozenModule,const char *name            /* UTF-8 encoded string */) \
+    FUNCTION(OPTIONAL, PyObject *, PyException_GetTraceback, PyObject *) \
+    FUNCTION(OPTIONAL, Py_ssize_t, PyObject_Size, PyObject *o) \
+    FUNCTION(OPTIONAL, void, PyErr_Fetch, PyObject **, PyObject **, PyObject **) \
+    TYPE(OPTIONAL, PySeqIter_Type) \
+    FUNCTION(OPTIONAL, PyObject *, PyModule_GetDict, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyArg_ParseTupleAndKeywords, PyObject *, PyObject *,const char *, char **, ...) \
+    FUNCTION(OPTIONAL, int, PyDict_Merge, PyObject *mp,PyObject *other,int override) \
+    FUNCTION(OPTIONAL, void *, PyMem_Malloc, size_t size) \
+    FUNCTION(OPTIONAL, void, PyBytes_ConcatAndDel, PyObject **, PyObject *) \
+    FUNCTION(OPTIONAL, PyObject *, PyByteArray_Concat, PyObject *, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyUnicode_WriteChar,PyObject *unicode,Py_ssize_t index,Py_UCS4 character) \
+    FUNCTION(OPTIONAL, int, PyThread_tss_set, Py_tss_t *key, void *value) \
+    TYPE(OPTIONAL, PyIncrementalNewlineDecoder_Type) \
+    FUNCTION(OPTIONAL, struct PyModuleDef*, PyModule_GetDef, PyObject*) \
+    FUNCTION(OPTIONAL, int, PyTuple_SetItem, PyObject *, Py_ssize_t, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyRun_AnyFileEx, FILE *fp, const char *name, int closeit) \
+    FUNCTION(OPTIONAL, PyStatus, Py_PreInitializeFromBytesArgs,const PyPreConfig *src_config,Py_ssize_t argc,char **argv) \
+    FUNCTION(OPTIONAL, int, PyDict_SetItem, PyObject *mp, PyObject *key, PyObject *item) \
+    FUNCTION(OPTIONAL, PyObject *, PyOS_FSPath, PyObject *path) \
+    FUNCTION(OPTIONAL, const char *, Py_GetBuildInfo, void) \
+    FUNCTION(OPTIONAL, PyObject *, PyIter_Next, PyObject *) \
+    FUNCTION(OPTIONAL, int, PyObject_IsInstance, PyObject *object, PyObject *typeorclass) \
+    FUNCTION(OPTIONAL, void *, PyMem_RawRealloc, void *ptr, size_t new_size) \
+    FUNCTION(OPTIONAL, int, Py_IsInitialized, void) \
+    FUNCTION(OPTIONAL, const char*, PyUnicode_GetDefaultEncoding, void) \
+    TYPE(OPTIONAL, PyAsyncGen_Type) \
+    FUNCTION(OPTIONAL, void, Py_EndInterpreter, PyThreadState *) \
+    FUNCTION(OPTIONAL, int, PyErr_CheckSignals, void) \
+    FUNCTION(OPTIONAL, int, PyObject_HasAttrString, PyObject *, const char *) \
+    FUNCTION(OPTIONAL, PyObject *, PyImport_GetImporter, PyObject *path) \
+    FUNCTION(OPTIONAL, int, PyRun_SimpleFileEx, FILE *f, const char *p, int c) \
+    FUNCTION(REQUIRED, void, PyGILState_Release, PyGILState_STATE)
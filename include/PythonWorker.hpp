@@ -0,0 +1,79 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Python.hpp"
+#include "LockFreeQueue.hpp"
+
+namespace Cinema {
+
+    /// Latency histogram with power of two millisecond buckets
+    class LatencyHistogram {
+        public:
+            static constexpr const int BUCKET_COUNT = 16;
+
+            void Add(std::chrono::nanoseconds latency);
+            /// Writes the non empty buckets to the log
+            void Log(const char* name) const;
+
+        private:
+            std::array<int, BUCKET_COUNT> buckets = {};
+            int count = 0;
+            std::chrono::nanoseconds total = std::chrono::nanoseconds::zero();
+            std::chrono::nanoseconds max = std::chrono::nanoseconds::zero();
+    };
+
+    /// Long lived thread that keeps yt-dlp imported and runs its commands
+    class PythonWorker {
+        public:
+            struct Command {
+                std::string url;
+                /// yt-dlp command line options, an empty value passes the option as a flag
+                std::vector<std::pair<std::string, std::string>> options;
+                /// Called on the worker thread with the GIL held right before yt-dlp runs, returning false skips the command
+                std::function<bool()> started;
+                /// Called on the worker thread with the GIL held and the exit code of yt-dlp, -1 if it raised or was skipped
+                /// If Python couldn't be loaded it is called with -1 and without the GIL
+                std::function<void(int)> finished;
+                std::chrono::steady_clock::time_point submitted;
+            };
+
+            /// Queues a command without blocking, starts the worker on first use
+            static void Submit(Command command);
+
+        private:
+            /// How often the worker writes the latency histograms to the log
+            static constexpr const auto LATENCY_LOG_INTERVAL = std::chrono::minutes(5);
+
+            static void ThreadLoop();
+            /// Fails every queued command once Python couldn't be loaded and stops the worker
+            static void FailQueued();
+            static bool Import();
+            static std::string AssetStamp();
+            /// Compiles the shipped yt-dlp into a zip of .pyc files, reused until the asset changes
+            static bool BuildBundle(const std::string& bundle);
+            static Python::PyObject* BuildArguments(const Command& command);
+            static int Execute(const Command& command);
+
+            static LockFreeQueue<Command> commands;
+            /// Bumped on every submit, the worker sleeps on it while the queue is empty
+            static std::atomic<uint32_t> submitted;
+            static std::atomic<bool> started;
+            static Python::PyObject* runFunction;
+
+            /// Set while the first command since LoadPython hasn't succeeded yet
+            static std::optional<std::chrono::steady_clock::time_point> loadStart;
+            /// true if this session had to build the bundle or extract yt-dlp
+            static bool coldStart;
+
+            static LatencyHistogram queueLatency;
+            static LatencyHistogram runLatency;
+    };
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include "main.hpp"
+#include "FrameRing.hpp"
+#include "vlcpp/vlc.hpp"
+#include "UnityEngine/Renderer.hpp"
+#include "UnityEngine/Texture2D.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+
+namespace Cinema {
+
+    enum class VideoBackend {
+        Unity,
+        VLC
+    };
+
+    /// Decodes a video with libvlc into a FrameRing and uploads the newest frame to the screen material
+    class VLCPlayer {
+        public:
+            VLCPlayer();
+            ~VLCPlayer();
+
+            void set_url(std::string_view url);
+            void set_renderer(UnityEngine::Renderer* renderer);
+            void set_isLooping(bool value);
+            /// @param time the time in seconds, the same unit the unity VideoPlayer uses
+            void set_time(double time);
+            /// @return the time in seconds
+            double get_time();
+            /// @return the length in seconds, 0 or less until libvlc parsed the media
+            double get_length();
+            void set_playbackSpeed(float speed);
+            bool get_isPrepared() const;
+
+            /// Opens the media on the control thread, returns right away
+            void Prepare();
+            void Play();
+            void Pause();
+            /// Stops on the control thread, returns right away
+            void Stop();
+
+            /// Uploads the newest decoded frame to the screen texture, has to be called on the main thread
+            /// @return true if a new frame was uploaded
+            bool UploadFrame();
+
+            FrameRing::Stats get_frameStats() const { return frames.get_stats(); }
+
+        private:
+            uint32_t FormatSetup(char* chroma, uint32_t* width, uint32_t* height, uint32_t* pitches, uint32_t* lines);
+            void* Lock(void** planes);
+            void Display(void* picture);
+            /// Main thread: resizes the ring and the texture for a format FormatSetup is waiting on
+            void ApplyFormat();
+            /// Releases a FormatSetup waiting on the main thread, the vout then fails instead of blocking stop()
+            void CancelFormat();
+            /// Queues a task for the control thread
+            void Post(std::function<void()> task);
+            void ControlLoop();
+
+            VLC::Instance instance;
+            VLC::MediaPlayer mediaPlayer;
+            std::string url;
+            bool isLooping = false;
+
+            UnityEngine::Renderer* renderer = nullptr;
+            UnityEngine::Texture2D* texture = nullptr;
+
+            // Size of the texture, only used on the main thread
+            uint32_t width = 0;
+            uint32_t height = 0;
+
+            FrameRing frames;
+
+            /// The decode thread posts a new format and waits until the main thread isn't holding a slot anymore
+            /// and has resized the ring and the texture, so no frame of the new size reaches the old texture
+            enum class FormatState {
+                Idle,
+                Requested,
+                Applied,
+                Cancelled
+            };
+            std::mutex formatMutex;
+            std::condition_variable formatApplied;
+            FormatState formatState = FormatState::Idle;
+            uint32_t requestedWidth = 0;
+            uint32_t requestedHeight = 0;
+            std::atomic<bool> formatRequested = false;
+
+            std::atomic<bool> prepared = false;
+            bool playRequested = false;
+
+            std::chrono::steady_clock::time_point playStart;
+
+            /// Runs the libvlc calls that block until the decoder threads are joined, in order, off the main thread
+            std::mutex controlMutex;
+            std::condition_variable controlCondition;
+            std::queue<std::function<void()>> controlTasks;
+            bool controlExit = false;
+            /// Last member, it is started once everything it uses is constructed
+            std::thread controlThread;
+    };
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <array>
+#include <cstring>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Cinema {
+
+    #pragma pack(push, 1)
+    /// Per-map video configuration as read from the cinema-video.json next to the level
+    struct VideoConfig {
+        static constexpr const int VIDEO_ID_SIZE = 24;
+        /// Values of backend, a map without one follows the backend chosen in the mod config
+        static constexpr const uint8_t BACKEND_DEFAULT = 0;
+        static constexpr const uint8_t BACKEND_UNITY = 1;
+        static constexpr const uint8_t BACKEND_VLC = 2;
+
+        char videoId[VIDEO_ID_SIZE] = {};
+        /// Milliseconds the video is ahead of the song
+        float offset = 0.0f;
+        float position[3] = { 0.0f, 12.4f, 67.8f };
+        float rotation[3] = { 90.0f, 270.0f, 90.0f };
+        float scale[3] = { 5.11f, 1.0f, 3.0f };
+        /// Trim in seconds of video time, an end of 0 plays until the end of the video
+        float startTime = 0.0f;
+        float endTime = 0.0f;
+        uint8_t loop = 1;
+        /// Backend the map asks for, one of the BACKEND_ values
+        uint8_t backend = BACKEND_DEFAULT;
+
+        std::string_view get_videoId() const { return { videoId, strnlen(videoId, VIDEO_ID_SIZE) }; }
+    };
+    #pragma pack(pop)
+
+    /// Binary index of all parsed cinema-video.json files, keyed by level hash and memory-mapped for O(1) lookups
+    class VideoConfigIndex {
+        public:
+            using LevelHash = std::array<uint8_t, 20>;
+
+            static constexpr const char* CONFIG_FILE_NAME = "cinema-video.json";
+
+            /// Parses a 40 character level hash or a custom level id
+            static std::optional<LevelHash> ParseLevelHash(std::string_view levelId);
+
+            /// Re-parses the level's cinema-video.json if it changed since it was indexed
+            static void Update(const LevelHash& hash, const std::filesystem::path& levelPath);
+            static std::optional<VideoConfig> Get(const LevelHash& hash);
+
+        private:
+            struct Header {
+                uint32_t magic;
+                uint32_t version;
+                uint32_t capacity;
+                uint32_t count;
+            };
+
+            #pragma pack(push, 1)
+            struct Entry {
+                LevelHash hash;
+                uint8_t used;
+                uint8_t hasConfig;
+                int64_t mtime;
+                VideoConfig config;
+            };
+            #pragma pack(pop)
+
+            static constexpr const uint32_t MAGIC = 0x56444943; // CIDV
+            /// Version 2 dropped levels without a config and videoIDs that aren't plain ids,
+            /// version 3 tells a map asking for the Unity backend apart from one that doesn't ask
+            static constexpr const uint32_t VERSION = 3;
+            static constexpr const uint32_t INITIAL_CAPACITY = 1024;
+
+            static std::filesystem::path IndexPath();
+            static bool Map(uint32_t capacity);
+            static void Unmap();
+            static bool Grow();
+            static Entry* Find(const LevelHash& hash, bool insert);
+            static std::optional<VideoConfig> Parse(const std::filesystem::path& path);
+
+            static Header* header;
+            static Entry* entries;
+            static std::size_t mappedSize;
+            static int fd;
+    };
+}
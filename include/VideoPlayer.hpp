@@ -18,6 +18,22 @@ namespace Cinema {
             setTime(this, time);
         }
 
+        double get_time() {
+            static auto getTime = reinterpret_cast<function_ptr_t<double, Video::VideoPlayer*>>(il2cpp_functions::resolve_icall("UnityEngine.Video.VideoPlayer::get_time"));
+            return getTime(this);
+        }
+
+        /// @return the length in seconds, 0 until the video is prepared
+        double get_length() {
+            static auto getLength = reinterpret_cast<function_ptr_t<double, Video::VideoPlayer*>>(il2cpp_functions::resolve_icall("UnityEngine.Video.VideoPlayer::get_length"));
+            return getLength(this);
+        }
+
+        void set_playbackSpeed(float speed) {
+            static auto playbackSpeed = reinterpret_cast<function_ptr_t<void, Video::VideoPlayer*, float>>(il2cpp_functions::resolve_icall("UnityEngine.Video.VideoPlayer::set_playbackSpeed"));
+            playbackSpeed(this, speed);
+        }
+
         void set_aspectRatio(Video::VideoAspectRatio ratio) {
             static auto aspectRatio = reinterpret_cast<function_ptr_t<void, Video::VideoPlayer*, Video::VideoAspectRatio>>(il2cpp_functions::resolve_icall("UnityEngine.Video.VideoPlayer::set_aspectRatio"));
             aspectRatio(this, ratio);
@@ -0,0 +1,64 @@
+#pragma once
+#include "main.hpp"
+#include "VideoPlayer.hpp"
+#include "VLCPlayer.hpp"
+#include "custom-types/shared/coroutine.hpp"
+#include <chrono>
+#include <optional>
+#include <string>
+
+namespace Cinema {
+
+    /// Opens and pre-rolls the video of the selected level while the player is still in the menu
+    /// and hands the warm player over when the song starts
+    class VideoPreloader {
+        public:
+            struct Players {
+                Cinema::VideoPlayer* unity = nullptr;
+                VLCPlayer* vlc = nullptr;
+                /// true if the player was already prepared for this level
+                bool warm = false;
+            };
+
+            /// Starts preparing the video for levelId, cancels any other preload
+            static void Preload(std::string_view levelId, VideoBackend backend, std::string_view url, double offset, bool loop);
+            /// Stops the current preload, e.g. because the selection changed
+            static void Cancel();
+            /// Hands over the player for levelId, prepares it now if it wasn't preloaded
+            /// A player that already played this level is rewound first, e.g. on a restart
+            static Players Acquire(std::string_view levelId, VideoBackend backend, std::string_view url, double offset, bool loop);
+            /// Takes back the player after its song stopped and rewinds it, so playing the level again starts warm
+            static void Release();
+
+            static const std::string& get_selectedLevelId() { return selectedLevelId; }
+            static void set_selectedLevelId(std::string_view levelId) { selectedLevelId = levelId; }
+
+            /// Time from the song start to the first decoded frame of the last song
+            static std::optional<std::chrono::milliseconds> get_lastTimeToFirstFrame() { return lastTimeToFirstFrame; }
+
+        private:
+            static Cinema::VideoPlayer* GetUnityPlayer();
+            static VLCPlayer* GetVLCPlayer();
+            static bool IsPrepared();
+            static void Prepare(std::string_view levelId, VideoBackend backend, std::string_view url, double offset, bool loop);
+            /// Seeks the prepared player back to where the video starts relative to the song
+            static void Rewind(double offset);
+            static custom_types::Helpers::Coroutine WaitForFirstFrame(int generation, double offset, bool rewind);
+
+            static Cinema::VideoPlayer* unityPlayer;
+            static std::unique_ptr<VLCPlayer> vlcPlayer;
+
+            static std::string selectedLevelId;
+            static std::string preparedLevelId;
+            static std::string preparedUrl;
+            static VideoBackend preparedBackend;
+            static int generation;
+            static bool firstFrameReady;
+            /// Set from Acquire until Release, the player isn't at its pre-roll position anymore
+            static bool acquired;
+            static double preparedOffset;
+
+            static std::optional<std::chrono::steady_clock::time_point> songStart;
+            static std::optional<std::chrono::milliseconds> lastTimeToFirstFrame;
+    };
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+namespace Cinema {
+
+    /// Keeps the video clock locked to the song clock
+    /// Small drift is corrected by nudging the playback speed, large drift by seeking
+    class SyncController {
+        public:
+            struct Settings {
+                /// Video time = song time + offset, in seconds
+                double offset = 0.0;
+                /// Drift at which speed correction starts
+                double nudgeThreshold = 0.030;
+                /// Drift at which speed correction stops again, lower than nudgeThreshold for hysteresis
+                double settleThreshold = 0.010;
+                /// Drift above which the video seeks instead of catching up
+                double seekThreshold = 0.400;
+                /// Maximum deviation from normal speed while nudging
+                float maxNudge = 0.08f;
+                /// Speed deviation per second of drift
+                float nudgeGain = 1.0f;
+                /// Weight of a new drift sample in the smoothed drift, filters out clock jitter
+                double smoothing = 0.2;
+                /// Time to ignore samples after a seek while the decoder catches up
+                double seekCooldown = 0.25;
+                /// Whether the video starts over at loopStart once it reaches its end
+                bool loop = true;
+                /// Video time a loop starts over at, in seconds
+                double loopStart = 0.0;
+                /// End of the video in seconds, 0 while the player doesn't know it yet
+                double length = 0.0;
+            };
+
+            enum class Action {
+                None,
+                SetSpeed,
+                Seek
+            };
+
+            struct Correction {
+                Action action = Action::None;
+                float speed = 1.0f;
+                double seekTime = 0.0;
+            };
+
+            SyncController() = default;
+            explicit SyncController(const Settings& settings) : settings(settings) {}
+
+            const Settings& get_settings() const { return settings; }
+            void set_offset(double offset) { settings.offset = offset; }
+            void set_length(double length) { settings.length = length; }
+
+            /// Forgets all previous samples, e.g. after a pause or a restart
+            void Reset();
+
+            /// Compares both clocks, has to be called once per frame
+            /// Nothing is corrected while the song is at a part the video can't show, before its start or after its end
+            /// @param songTime the song time in seconds
+            /// @param videoTime the video time in seconds
+            /// @param deltaTime the time since the last update in seconds
+            Correction Update(double songTime, double videoTime, double deltaTime);
+
+            double get_drift() const { return drift; }
+            float get_speed() const { return speed; }
+
+        private:
+            Settings settings;
+            double drift = 0.0;
+            bool hasDrift = false;
+            bool nudging = false;
+            float speed = 1.0f;
+            double cooldown = 0.0;
+    };
+}
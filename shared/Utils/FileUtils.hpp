@@ -1,10 +1,16 @@
 #pragma once
+#include <functional>
 #include <string>
+#include <string_view>
 
 namespace FileUtils {
 
     const std::string& getPythonPath();
     const std::string& getScriptsPath();
-    int ExtractZip(std::string_view data, std::string_view path);
+    /// Extracts the zip across threadCount workers, 0 uses one per core
+    /// Extracted entries are recorded with their size and CRC in a manifest, calling it again only writes
+    /// entries that changed or are missing and removes the ones that left the zip
+    /// Entries the filter rejects are treated as if they weren't in the zip
+    int ExtractZip(std::string_view data, std::string_view path, const std::function<bool(std::string_view)>& filter = nullptr, int threadCount = 0);
     
 }
\ No newline at end of file
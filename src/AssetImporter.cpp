@@ -0,0 +1,274 @@
+#include "AssetImporter.hpp"
+#include "main.hpp"
+#include "PythonInternal.hpp"
+#include "CustomLogger.hpp"
+#include "zip.h"
+
+#include <algorithm>
+#include <fstream>
+#include <optional>
+#include <sstream>
+
+namespace Cinema {
+
+    std::vector<zip_t*> AssetImporter::archives;
+    std::unordered_map<std::string, AssetImporter::Module> AssetImporter::modules;
+    std::mutex AssetImporter::mutex;
+    std::optional<std::unordered_set<std::string>> AssetImporter::bootstrapModules;
+    std::string AssetImporter::bootstrapPath;
+    std::string AssetImporter::bootstrapStamp;
+
+    static constexpr std::string_view SOURCE_SUFFIX = ".py";
+    static constexpr std::string_view BYTECODE_SUFFIX = ".cpython-38.pyc";
+    static constexpr std::string_view CACHE_DIRECTORY = "__pycache__/";
+    static constexpr std::string_view PACKAGE_INIT = "__init__";
+
+    /// Module path for a .py or __pycache__ .pyc entry, e.g. "json/decoder", nullopt for anything else
+    static std::optional<std::string> ModulePath(std::string_view path, bool& isPackage, bool& isBytecode) {
+        std::string result;
+        if(path.ends_with(BYTECODE_SUFFIX)) {
+            auto cache = path.rfind(CACHE_DIRECTORY);
+            if(cache == std::string_view::npos || path.find('/', cache + CACHE_DIRECTORY.size()) != std::string_view::npos)
+                return std::nullopt;
+            result = std::string(path.substr(0, cache)) + std::string(path.substr(cache + CACHE_DIRECTORY.size(), path.size() - cache - CACHE_DIRECTORY.size() - BYTECODE_SUFFIX.size()));
+            isBytecode = true;
+        } else if(path.ends_with(SOURCE_SUFFIX)) {
+            result = path.substr(0, path.size() - SOURCE_SUFFIX.size());
+            isBytecode = false;
+        } else
+            return std::nullopt;
+        isPackage = result == PACKAGE_INIT || result.ends_with("/" + std::string(PACKAGE_INIT));
+        if(isPackage)
+            result.resize(result.size() - std::min(result.size(), PACKAGE_INIT.size() + 1));
+        // Directories like site-packages or lib-dynload aren't packages
+        if(result.find_first_of("-. ") != std::string::npos)
+            return std::nullopt;
+        return result;
+    }
+
+    static std::string ModuleName(const std::string& modulePath, std::string_view modulePrefix) {
+        std::string name = modulePath;
+        std::replace(name.begin(), name.end(), '/', '.');
+        if(modulePrefix.empty())
+            return name;
+        if(name.empty())
+            return std::string(modulePrefix);
+        return std::string(modulePrefix) + "." + name;
+    }
+
+    bool AssetImporter::IsImportable(std::string_view entryName) {
+        if(!entryName.starts_with(STDLIB_PREFIX))
+            return false;
+        bool isPackage, isBytecode;
+        auto modulePath = ModulePath(entryName.substr(std::string_view(STDLIB_PREFIX).size()), isPackage, isBytecode);
+        if(!modulePath || modulePath->empty())
+            return false;
+        // Without a record of what the interpreter imports before Install everything has to be on disk
+        if(!bootstrapModules.has_value())
+            return false;
+        return !bootstrapModules->contains(modulePath->substr(0, modulePath->find('/')));
+    }
+
+    bool AssetImporter::LoadBootstrapModules(std::string_view runtimeData, std::string_view path) {
+        // FNV-1a, a different runtime may import different modules while it starts
+        uint64_t hash = 0xcbf29ce484222325;
+        for(auto c : runtimeData) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 0x100000001b3;
+        }
+        bootstrapStamp = string_format("%zu-%016llx", runtimeData.size(), (unsigned long long) hash);
+        bootstrapPath = path;
+        bootstrapModules = std::nullopt;
+        std::ifstream file(bootstrapPath);
+        std::string line;
+        if(!std::getline(file, line) || line != bootstrapStamp)
+            return false;
+        std::unordered_set<std::string> names;
+        while(std::getline(file, line)) {
+            if(!line.empty())
+                names.emplace(std::move(line));
+        }
+        if(names.empty())
+            return false;
+        bootstrapModules = std::move(names);
+        return true;
+    }
+
+    void AssetImporter::Register(std::string_view data, std::string_view pathPrefix, std::string_view modulePrefix, std::string_view extractedPath) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto zip = zip_stream_open(data.data(), data.length(), 0, 'r');
+        if(!zip)
+            return;
+        auto archive = archives.size();
+        archives.emplace_back(zip);
+        auto total = zip_entries_total(zip);
+        for(ssize_t i = 0; i < total; i++) {
+            if(zip_entry_openbyindex(zip, i) < 0)
+                continue;
+            std::string_view name = zip_entry_name(zip);
+            bool isPackage, isBytecode;
+            std::optional<std::string> modulePath;
+            if(name.starts_with(pathPrefix))
+                modulePath = ModulePath(name.substr(pathPrefix.size()), isPackage, isBytecode);
+            zip_entry_close(zip);
+            if(!modulePath)
+                continue;
+            auto moduleName = ModuleName(*modulePath, modulePrefix);
+            auto itr = modules.find(moduleName);
+            // Prefer the compiled entry if both are shipped, the source is the fallback for a stale one
+            if(itr != modules.end() && itr->second.archive == archive) {
+                auto& module = itr->second;
+                if(isBytecode && !module.isBytecode) {
+                    module.sourceIndex = module.index;
+                    module.index = static_cast<std::size_t>(i);
+                    module.isBytecode = true;
+                } else if(!isBytecode && module.isBytecode)
+                    module.sourceIndex = i;
+                continue;
+            }
+            if(itr != modules.end() && itr->second.isBytecode)
+                continue;
+            auto path = std::string(extractedPath) + "/" + std::string(pathPrefix) + *modulePath;
+            if(path.ends_with('/'))
+                path.pop_back();
+            std::string location;
+            if(isPackage)
+                location = path;
+            auto origin = isPackage ? path + "/" + std::string(PACKAGE_INIT) + std::string(SOURCE_SUFFIX) : path + std::string(SOURCE_SUFFIX);
+            modules[moduleName] = { archive, static_cast<std::size_t>(i), isPackage, isBytecode, -1, location, origin };
+        }
+    }
+
+    // find(fullname) -> (archive, index, is_package, is_bytecode, location, source_index, origin) or None
+    Python::PyObject* AssetImporter::Find([[maybe_unused]] Python::PyObject* self, Python::PyObject* args) {
+        using namespace Python;
+        const char* fullname;
+        if(!PyArg_ParseTuple(args, "s", &fullname))
+            return nullptr;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto itr = modules.find(fullname);
+        if(itr == modules.end())
+            Py_RETURN_NONE;
+        auto& module = itr->second;
+        return Py_BuildValue("(nniisns)", (Py_ssize_t) module.archive, (Py_ssize_t) module.index, (int) module.isPackage, (int) module.isBytecode, module.location.c_str(), module.sourceIndex, module.origin.c_str());
+    }
+
+    // read(archive, index) -> bytes
+    Python::PyObject* AssetImporter::Read([[maybe_unused]] Python::PyObject* self, Python::PyObject* args) {
+        using namespace Python;
+        Py_ssize_t archive, index;
+        if(!PyArg_ParseTuple(args, "nn", &archive, &index))
+            return nullptr;
+        std::lock_guard<std::mutex> lock(mutex);
+        if(archive < 0 || archive >= (Py_ssize_t) archives.size())
+            Py_RETURN_NONE;
+        auto zip = archives[archive];
+        if(zip_entry_openbyindex(zip, index) < 0)
+            Py_RETURN_NONE;
+        auto size = zip_entry_size(zip);
+        // Inflate straight into the bytes object instead of an intermediate buffer
+        auto bytes = PyBytes_FromStringAndSize(nullptr, size);
+        if(bytes && zip_entry_noallocread(zip, PyBytes_AsString(bytes), size) < 0) {
+            Py_DecRef(bytes);
+            bytes = nullptr;
+        }
+        zip_entry_close(zip);
+        if(!bytes)
+            Py_RETURN_NONE;
+        return bytes;
+    }
+
+    void AssetImporter::Install() {
+        using namespace Python;
+        static PyMethodDef methods[] = {
+            {"find", Find, METH_VARARGS, "Looks up a module in the embedded zips"},
+            {"read", Read, METH_VARARGS, "Reads an entry of an embedded zip"},
+            {nullptr, nullptr, 0, nullptr}
+        };
+        static PyModuleDef module = {
+            PyModuleDef_HEAD_INIT,
+            "cinema_assets",
+            nullptr,
+            -1,
+            methods,
+            nullptr,
+            nullptr,
+            nullptr,
+            nullptr
+        };
+        static bool installed = false;
+        if(installed)
+            return;
+        installed = true;
+        AddNativeModule(module);
+        // Whatever is loaded at this point was imported while the interpreter started, those modules have to be
+        // extracted next time. Recorded before the importer runs so nothing it imports ends up in the list
+        if(!bootstrapPath.empty()) {
+            PyRun_SimpleString((
+                "import sys\n"
+                "with open('" + bootstrapPath + "', 'w') as _cinema_file:\n"
+                "    _cinema_file.write('\\n'.join(['" + bootstrapStamp + "'] + sorted({name.partition('.')[0] for name in sys.modules})) + '\\n')\n"
+                "del _cinema_file\n"
+            ).c_str());
+        }
+        // Only uses builtins, the stdlib might not be importable yet. It goes in front of the path finder
+        // so the embedded modules are found without touching the disk
+        PyRun_SimpleString(
+            "import sys, marshal, _imp, cinema_assets\n"
+            "_cinema_external = sys.modules['_frozen_importlib_external']\n"
+            "_cinema_magic = _cinema_external.MAGIC_NUMBER\n"
+            "# The InspectLoader and ExecutionLoader parts linecache, inspect and runpy use\n"
+            "class _CinemaAssetLoader:\n"
+            "    def __init__(self, entry):\n"
+            "        self.entry = entry\n"
+            "    def create_module(self, spec):\n"
+            "        return None\n"
+            "    def is_package(self, fullname):\n"
+            "        return bool(self.entry[2])\n"
+            "    def get_filename(self, fullname):\n"
+            "        return self.entry[6]\n"
+            "    def get_source(self, fullname):\n"
+            "        archive, index, is_package, is_bytecode, location, source_index, origin = self.entry\n"
+            "        if is_bytecode:\n"
+            "            index = source_index\n"
+            "        data = cinema_assets.read(archive, index) if index >= 0 else None\n"
+            "        return None if data is None else _cinema_external.decode_source(data)\n"
+            "    def get_code(self, fullname):\n"
+            "        archive, index, is_package, is_bytecode, location, source_index, origin = self.entry\n"
+            "        data = cinema_assets.read(archive, index)\n"
+            "        if is_bytecode:\n"
+            "            # Only timestamp based .pyc of this interpreter version, anything else is compiled from the source\n"
+            "            if data is not None and len(data) >= 16 and data[:4] == _cinema_magic and int.from_bytes(data[4:8], 'little') == 0:\n"
+            "                code = marshal.loads(memoryview(data)[16:])\n"
+            "                # Compiled at build time, the frames should name the file the module has now\n"
+            "                _imp._fix_co_filename(code, origin)\n"
+            "                return code\n"
+            "            if source_index < 0:\n"
+            "                raise ImportError('stale bytecode without a source for ' + fullname, name=fullname)\n"
+            "            data = cinema_assets.read(archive, source_index)\n"
+            "        if data is None:\n"
+            "            raise ImportError('could not read ' + fullname, name=fullname)\n"
+            "        return compile(data, origin, 'exec', dont_inherit=True)\n"
+            "    def exec_module(self, module):\n"
+            "        exec(self.get_code(module.__name__), module.__dict__)\n"
+            "class _CinemaAssetFinder:\n"
+            "    @classmethod\n"
+            "    def find_spec(cls, fullname, path=None, target=None):\n"
+            "        entry = cinema_assets.find(fullname)\n"
+            "        if entry is None:\n"
+            "            return None\n"
+            "        spec = sys.modules['_frozen_importlib'].ModuleSpec(fullname, _CinemaAssetLoader(entry), origin=entry[6], is_package=bool(entry[2]))\n"
+            "        # __file__ is the path in the extracted tree, whether or not the file is there\n"
+            "        spec.has_location = True\n"
+            "        if entry[2]:\n"
+            "            spec.submodule_search_locations = [entry[4]]\n"
+            "        return spec\n"
+            "    @classmethod\n"
+            "    def invalidate_caches(cls):\n"
+            "        pass\n"
+            "_cinema_path_finder = next((i for i, f in enumerate(sys.meta_path) if getattr(f, '__name__', '') == 'PathFinder'), len(sys.meta_path))\n"
+            "sys.meta_path.insert(_cinema_path_finder, _CinemaAssetFinder)\n"
+        );
+        LOG_INFO("Installed the asset importer with %zu modules", modules.size());
+    }
+}
@@ -0,0 +1,66 @@
+#include "CinemaScreen.hpp"
+
+#include "UnityEngine/PrimitiveType.hpp"
+#include "UnityEngine/Quaternion.hpp"
+#include "UnityEngine/Resources.hpp"
+#include "UnityEngine/Transform.hpp"
+#include "questui/shared/ArrayUtil.hpp"
+
+using namespace UnityEngine;
+
+namespace Cinema {
+
+    GameObject* CinemaScreen::screen = nullptr;
+    Renderer* CinemaScreen::renderer = nullptr;
+    Material* CinemaScreen::material = nullptr;
+    Shader* CinemaScreen::shader = nullptr;
+
+    bool CinemaScreen::IsAlive(Object* object) {
+        return object && object->m_CachedPtr.m_value;
+    }
+
+    Material* CinemaScreen::GetMaterial() {
+        if(IsAlive(material))
+            return material;
+        // Only scan all materials once, the copy is ours and doesn't go away with the environment
+        // DontDestroyOnLoad does nothing for assets, the screen's renderer referencing it is what keeps it loaded
+        auto pyroVideo = QuestUI::ArrayUtil::Last(Resources::FindObjectsOfTypeAll<Material*>(), [](Material* x) {
+            return x->get_name() == "PyroVideo (Instance)";
+        });
+        if(pyroVideo) {
+            material = Material::New_ctor(pyroVideo);
+            shader = material->get_shader();
+        } else {
+            if(!IsAlive(shader))
+                shader = Shader::Find("Unlit/Texture");
+            material = Material::New_ctor(shader);
+        }
+        return material;
+    }
+
+    void CinemaScreen::Create() {
+        screen = GameObject::CreatePrimitive(PrimitiveType::Plane);
+        screen->set_name("CinemaScreen");
+        Object::DontDestroyOnLoad(screen);
+        renderer = screen->GetComponent<Renderer*>();
+    }
+
+    Renderer* CinemaScreen::Show(Vector3 position, Vector3 rotation, Vector3 scale) {
+        if(!IsAlive(screen))
+            Create();
+        // A new screen still has the default material, one that was destroyed anyway is replaced by a new one
+        if(auto current = GetMaterial(); renderer->get_sharedMaterial() != current)
+            renderer->set_sharedMaterial(current);
+        auto transform = screen->get_transform();
+        transform->set_position(position);
+        transform->set_rotation(Quaternion::Euler(rotation.x, rotation.y, rotation.z));
+        transform->set_localScale(scale);
+        screen->SetActive(true);
+        return renderer;
+    }
+
+    void CinemaScreen::Hide() {
+        if(IsAlive(screen))
+            screen->SetActive(false);
+    }
+}
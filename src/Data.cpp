@@ -44,7 +44,8 @@ namespace SongDetailsCache {
 
     const std::vector<std::size_t> SongDetails::FindSongIndexes(const DifficultyFilterFunction& check) const {
         std::vector<std::size_t> l;
-        auto& diffs = *SongDetailsContainer::difficulties;
+        auto state = SongDetailsContainer::get_state();
+        auto& diffs = *state->columns.difficulties;
         std::size_t sz = diffs.size();
         for (std::size_t i = 0, last = std::numeric_limits<uint32_t>::max(); i < sz; i++) {
             auto& cur = diffs[i];
@@ -56,8 +57,9 @@ namespace SongDetailsCache {
     }
     const std::vector<const Song*> SongDetails::FindSongs(const DifficultyFilterFunction& check) const {
         std::vector<const Song*> l;
-        auto& diffs = *SongDetailsContainer::difficulties;
-        auto& songs = *SongDetailsContainer::songs;
+        auto state = SongDetailsContainer::get_state();
+        auto& diffs = *state->columns.difficulties;
+        auto& songs = *state->columns.songs;
         std::size_t sz = diffs.size();
         for (std::size_t i = 0, last = std::numeric_limits<uint32_t>::max(); i < sz; i++) {
             auto& cur = diffs[i];
@@ -70,7 +72,8 @@ namespace SongDetailsCache {
     }
     std::size_t SongDetails::CountSongs(const DifficultyFilterFunction& check) const {
         std::size_t count = 0;
-        auto& diffs = *SongDetailsContainer::difficulties;
+        auto state = SongDetailsContainer::get_state();
+        auto& diffs = *state->columns.difficulties;
         std::size_t sz = diffs.size();
         for (std::size_t i = 0, last = std::numeric_limits<uint32_t>::max(); i < sz; i++) {
             auto& cur = diffs[i];
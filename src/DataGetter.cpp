@@ -0,0 +1,34 @@
+#include "Data/DataGetter.hpp"
+#include "Utils.hpp"
+#include "CustomLogger.hpp"
+
+#include <fmt/format.h>
+
+namespace SongDetailsCache {
+    std::unordered_map<std::string, std::string> DataGetter::deltaSources;
+
+    void DataGetter::SetDeltaSource(std::string_view dataSourceName, std::string urlFormat) {
+        deltaSources.insert_or_assign(std::string(dataSourceName), std::move(urlFormat));
+    }
+
+    bool DataGetter::HasDeltaSource(std::string_view dataSourceName) {
+        return deltaSources.contains(std::string(dataSourceName));
+    }
+
+    std::future<std::optional<DataGetter::DownloadedDatabase>> DataGetter::UpdateAndReadDelta(std::chrono::sys_seconds since, std::string_view dataSourceName) {
+        return std::async(std::launch::async, &DataGetter::UpdateAndReadDelta_internal, since, std::string(dataSourceName));
+    }
+
+    std::optional<DataGetter::DownloadedDatabase> DataGetter::UpdateAndReadDelta_internal(std::chrono::sys_seconds since, std::string dataSourceName) {
+        auto source = deltaSources.find(dataSourceName);
+        if (source == deltaSources.end())
+            return std::nullopt;
+        auto url = fmt::format(fmt::runtime(source->second), since.time_since_epoch().count());
+        auto response = WebUtil::GetAsync(url, 20, {}).get();
+        if (response.httpCode != 200 || response.content.empty()) {
+            LOG_INFO("No song details delta from %s (%ld)", url.c_str(), response.httpCode);
+            return std::nullopt;
+        }
+        return DownloadedDatabase{ dataSourceName, "", std::make_shared<std::vector<uint8_t>>(response.content.begin(), response.content.end()) };
+    }
+}
@@ -0,0 +1,238 @@
+#include "Data/SongDetailsContainer.hpp"
+#include "Data/DifficultyQuery.hpp"
+#include "Data/SongDetailsSnapshot.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace SongDetailsCache {
+    /// Same as DifficultyColumns::BLOCK_SIZE, which is private
+    static constexpr const std::size_t BLOCK_SIZE = 64;
+
+    template<typename T>
+    static void CopyPadded(std::vector<T>& column, std::size_t size, std::size_t padded, auto get, const std::vector<SongDifficulty>& difficulties) {
+        column.reserve(padded);
+        for (std::size_t i = 0; i < size; i++)
+            column.emplace_back(static_cast<T>(get(difficulties[i])));
+        column.resize(padded);
+    }
+
+    template<typename T>
+    static void CopyPadded(std::vector<T>& column, std::size_t padded, std::span<const T> section) {
+        column.reserve(padded);
+        column.assign(section.begin(), section.end());
+        column.resize(padded);
+    }
+
+    static uint16_t ToT100(float value) {
+        return static_cast<uint16_t>(std::clamp<long>(std::lround(value * 100.0f), 0, std::numeric_limits<uint16_t>::max()));
+    }
+
+    SongDetailsContainer::DifficultyColumns::DifficultyColumns(const std::vector<SongDifficulty>& difficulties) : size(difficulties.size()) {
+        static_assert(DifficultyColumns::BLOCK_SIZE == SongDetailsCache::BLOCK_SIZE);
+        std::size_t padded = (size + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+        CopyPadded(songIndex, size, padded, [](const SongDifficulty& diff) { return diff.songIndex; }, difficulties);
+        CopyPadded(starsT100, size, padded, [](const SongDifficulty& diff) { return ToT100(diff.stars); }, difficulties);
+        CopyPadded(njsT100, size, padded, [](const SongDifficulty& diff) { return ToT100(diff.njs); }, difficulties);
+        CopyPadded(notes, size, padded, [](const SongDifficulty& diff) { return diff.notes; }, difficulties);
+        CopyPadded(bombs, size, padded, [](const SongDifficulty& diff) { return diff.bombs; }, difficulties);
+        CopyPadded(obstacles, size, padded, [](const SongDifficulty& diff) { return diff.obstacles; }, difficulties);
+        CopyPadded(characteristic, size, padded, [](const SongDifficulty& diff) { return diff.characteristic; }, difficulties);
+        CopyPadded(difficulty, size, padded, [](const SongDifficulty& diff) { return diff.difficulty; }, difficulties);
+        CopyPadded(mods, size, padded, [](const SongDifficulty& diff) { return diff.mods; }, difficulties);
+    }
+
+    SongDetailsContainer::DifficultyColumns::DifficultyColumns(const SongDetailsSnapshot& snapshot) : size(snapshot.get_difficultyCount()) {
+        using Section = SongDetailsSnapshot::Section;
+        std::size_t padded = (size + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+        CopyPadded(songIndex, padded, snapshot.get_section<uint32_t>(Section::DiffSong));
+        CopyPadded(starsT100, padded, snapshot.get_section<uint16_t>(Section::StarsT100));
+        CopyPadded(njsT100, padded, snapshot.get_section<uint16_t>(Section::NjsT100));
+        CopyPadded(notes, padded, snapshot.get_section<uint32_t>(Section::Notes));
+        CopyPadded(bombs, padded, snapshot.get_section<uint32_t>(Section::Bombs));
+        CopyPadded(obstacles, padded, snapshot.get_section<uint32_t>(Section::Obstacles));
+        CopyPadded(characteristic, padded, snapshot.get_section<uint8_t>(Section::Characteristic));
+        CopyPadded(difficulty, padded, snapshot.get_section<uint8_t>(Section::Difficulty));
+        CopyPadded(mods, padded, snapshot.get_section<uint8_t>(Section::Mods));
+    }
+
+    std::size_t SongDetailsContainer::DifficultyColumns::get_byteSize() const noexcept {
+        return songIndex.size() * sizeof(uint32_t) + (starsT100.size() + njsT100.size()) * sizeof(uint16_t) +
+            (notes.size() + bombs.size() + obstacles.size()) * sizeof(uint32_t) + characteristic.size() + difficulty.size() + mods.size();
+    }
+
+    /// Narrows a float range to the T100 values whose float, computed like SongDifficulty does, is inside it.
+    /// false if there is no such value
+    static bool ToT100Range(const DifficultyQuery::Range<float>& range, uint16_t& min, uint16_t& max) {
+        static constexpr const int64_t LIMIT = std::numeric_limits<uint16_t>::max();
+        auto value = [](int64_t t100) { return t100 / 100.0f; };
+        // The guess from rounding can be one off either way
+        auto low = static_cast<int64_t>(std::clamp<double>(std::ceil(static_cast<double>(range.min) * 100.0), 0, LIMIT + 1));
+        while (low > 0 && value(low - 1) >= range.min)
+            low--;
+        while (low <= LIMIT && value(low) < range.min)
+            low++;
+        auto high = static_cast<int64_t>(std::clamp<double>(std::floor(static_cast<double>(range.max) * 100.0), -1, LIMIT));
+        while (high < LIMIT && value(high + 1) <= range.max)
+            high++;
+        while (high >= 0 && value(high) > range.max)
+            high--;
+        if (low > high)
+            return false;
+        min = low;
+        max = high;
+        return true;
+    }
+
+    /// Bit i set if min <= values[i] <= max, for one block
+    static uint64_t RangeMask(const uint16_t* values, uint16_t min, uint16_t max) {
+        uint64_t mask = 0;
+#if defined(__aarch64__)
+        const uint16x8_t weights = { 1, 2, 4, 8, 16, 32, 64, 128 };
+        auto low = vdupq_n_u16(min);
+        auto high = vdupq_n_u16(max);
+        for (std::size_t i = 0; i < BLOCK_SIZE; i += 8) {
+            auto value = vld1q_u16(values + i);
+            auto inside = vandq_u16(vcgeq_u16(value, low), vcleq_u16(value, high));
+            mask |= static_cast<uint64_t>(vaddvq_u16(vandq_u16(inside, weights))) << i;
+        }
+#elif defined(__SSE2__)
+        // No unsigned 16 bit compare, min <= value <= max is the same as value - min <= max - min with wrap around
+        auto low = _mm_set1_epi16(static_cast<int16_t>(min));
+        auto width = _mm_set1_epi16(static_cast<int16_t>(max - min));
+        auto zero = _mm_setzero_si128();
+        auto inside = [&](const uint16_t* at) {
+            auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(at));
+            return _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(value, low), width), zero);
+        };
+        for (std::size_t i = 0; i < BLOCK_SIZE; i += 16)
+            mask |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_packs_epi16(inside(values + i), inside(values + i + 8)))) << i;
+#else
+        for (std::size_t i = 0; i < BLOCK_SIZE; i++)
+            mask |= static_cast<uint64_t>(values[i] >= min && values[i] <= max) << i;
+#endif
+        return mask;
+    }
+
+    static uint64_t RangeMask(const uint32_t* values, uint32_t min, uint32_t max) {
+        uint64_t mask = 0;
+#if defined(__aarch64__)
+        const uint32x4_t weights = { 1, 2, 4, 8 };
+        auto low = vdupq_n_u32(min);
+        auto high = vdupq_n_u32(max);
+        for (std::size_t i = 0; i < BLOCK_SIZE; i += 4) {
+            auto value = vld1q_u32(values + i);
+            auto inside = vandq_u32(vcgeq_u32(value, low), vcleq_u32(value, high));
+            mask |= static_cast<uint64_t>(vaddvq_u32(vandq_u32(inside, weights))) << i;
+        }
+#elif defined(__SSE2__)
+        // SSE2 only compares signed, flipping the sign bit keeps the unsigned order
+        auto sign = _mm_set1_epi32(0x80000000);
+        auto low = _mm_xor_si128(_mm_set1_epi32(min), sign);
+        auto high = _mm_xor_si128(_mm_set1_epi32(max), sign);
+        for (std::size_t i = 0; i < BLOCK_SIZE; i += 4) {
+            auto value = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)), sign);
+            auto outside = _mm_or_si128(_mm_cmpgt_epi32(low, value), _mm_cmpgt_epi32(value, high));
+            mask |= static_cast<uint64_t>(~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF) << i;
+        }
+#else
+        for (std::size_t i = 0; i < BLOCK_SIZE; i++)
+            mask |= static_cast<uint64_t>(values[i] >= min && values[i] <= max) << i;
+#endif
+        return mask;
+    }
+
+    /// Bit i set if bit values[i] of accepted is set
+    static uint64_t SetMask(const uint8_t* values, uint32_t accepted) {
+        // Values past 31 shift into the zero upper half
+        uint64_t set = accepted;
+        uint64_t mask = 0;
+        for (std::size_t i = 0; i < BLOCK_SIZE; i++)
+            mask |= ((set >> std::min<uint32_t>(values[i], 32)) & 1) << i;
+        return mask;
+    }
+
+    std::vector<uint64_t> SongDetailsContainer::Evaluate(const DifficultyColumns& columns, const DifficultyQuery& query) {
+        std::size_t blocks = (columns.size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        std::vector<uint64_t> bits(blocks);
+        uint16_t starsMin = 0, starsMax = 0, njsMin = 0, njsMax = 0;
+        bool stars = query.stars.active();
+        bool njs = query.njs.active();
+        // Nothing can pass
+        if ((stars && !ToT100Range(query.stars, starsMin, starsMax)) || (njs && !ToT100Range(query.njs, njsMin, njsMax)))
+            return bits;
+        bool notes = query.notes.active();
+        bool bombs = query.bombs.active();
+        bool characteristics = query.characteristics != std::numeric_limits<uint32_t>::max();
+        bool difficulties = query.difficulties != std::numeric_limits<uint32_t>::max();
+        // Every filter runs on the same block while it is still in L1, a block nothing passed is skipped by the rest
+        for (std::size_t block = 0; block < blocks; block++) {
+            auto offset = block * BLOCK_SIZE;
+            uint64_t word = std::numeric_limits<uint64_t>::max();
+            if (stars)
+                word &= RangeMask(columns.starsT100.data() + offset, starsMin, starsMax);
+            if (word && njs)
+                word &= RangeMask(columns.njsT100.data() + offset, njsMin, njsMax);
+            if (word && notes)
+                word &= RangeMask(columns.notes.data() + offset, query.notes.min, query.notes.max);
+            if (word && bombs)
+                word &= RangeMask(columns.bombs.data() + offset, query.bombs.min, query.bombs.max);
+            if (word && characteristics)
+                word &= SetMask(columns.characteristic.data() + offset, query.characteristics);
+            if (word && difficulties)
+                word &= SetMask(columns.difficulty.data() + offset, query.difficulties);
+            bits[block] = word;
+        }
+        // The padding is zeros, which might pass
+        if (auto tail = columns.size % BLOCK_SIZE; tail)
+            bits.back() &= (uint64_t(1) << tail) - 1;
+        return bits;
+    }
+
+    /// Calls found once per song with at least one set difficulty, difficulties of a song are next to each other
+    template<typename F>
+    static void ForEachSong(const std::vector<uint64_t>& bits, const std::vector<uint32_t>& songIndex, F found) {
+        uint32_t last = std::numeric_limits<uint32_t>::max();
+        for (std::size_t block = 0; block < bits.size(); block++) {
+            for (auto word = bits[block]; word; word &= word - 1) {
+                auto index = songIndex[block * BLOCK_SIZE + std::countr_zero(word)];
+                if (index == last)
+                    continue;
+                last = index;
+                found(index);
+            }
+        }
+    }
+
+    std::vector<std::size_t> SongDetailsContainer::FindSongIndexes(const DifficultyQuery& query) {
+        auto current = get_state();
+        const auto& columns = *current->columns.difficultyColumns;
+        std::vector<std::size_t> l;
+        ForEachSong(Evaluate(columns, query), columns.songIndex, [&l](uint32_t index) { l.emplace_back(index); });
+        return l;
+    }
+
+    SongList SongDetailsContainer::FindSongs(const DifficultyQuery& query) {
+        auto current = get_state();
+        const auto& columns = *current->columns.difficultyColumns;
+        const auto& songColumn = *current->columns.songs;
+        std::vector<const Song*> l;
+        ForEachSong(Evaluate(columns, query), columns.songIndex, [&](uint32_t index) { l.emplace_back(&songColumn[index]); });
+        return SongList(std::move(current), std::move(l));
+    }
+
+    std::size_t SongDetailsContainer::CountSongs(const DifficultyQuery& query) {
+        auto current = get_state();
+        const auto& columns = *current->columns.difficultyColumns;
+        std::size_t count = 0;
+        ForEachSong(Evaluate(columns, query), columns.songIndex, [&count](uint32_t) { count++; });
+        return count;
+    }
+}
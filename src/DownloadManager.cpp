@@ -0,0 +1,310 @@
+#include "DownloadManager.hpp"
+#include "PythonWorker.hpp"
+#include "main.hpp"
+#include "PythonInternal.hpp"
+#include "CustomLogger.hpp"
+
+#include <cctype>
+#include <cstdlib>
+#include <future>
+#include <optional>
+#include <string_view>
+
+#include "questui/shared/CustomTypes/Components/MainThreadScheduler.hpp"
+
+namespace Cinema {
+
+    std::mutex DownloadManager::mutex;
+    std::condition_variable DownloadManager::condition;
+    std::priority_queue<DownloadManager::JobPtr, std::vector<DownloadManager::JobPtr>, DownloadManager::JobOrder> DownloadManager::queue;
+    std::vector<DownloadManager::JobPtr> DownloadManager::retries;
+    std::unordered_map<int, DownloadManager::JobPtr> DownloadManager::jobs;
+    bool DownloadManager::workerStarted = false;
+    int DownloadManager::maxRetries = 3;
+    int DownloadManager::nextId = 0;
+    uint64_t DownloadManager::nextSequence = 0;
+
+    thread_local DownloadManager::Job* DownloadManager::currentJob = nullptr;
+    Python::PyObject* DownloadManager::cancelledException = nullptr;
+
+    int DownloadManager::Enqueue(std::string_view url, int priority, ProgressCallback progress, CompletionCallback completion) {
+        auto job = std::make_shared<Job>();
+        job->url = url;
+        job->priority = priority;
+        job->progress = std::move(progress);
+        job->completion = std::move(completion);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job->id = nextId++;
+            job->sequence = nextSequence++;
+            jobs[job->id] = job;
+            queue.push(job);
+            EnsureWorker();
+        }
+        condition.notify_one();
+        return job->id;
+    }
+
+    bool DownloadManager::Cancel(int id) {
+        JobPtr job;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto itr = jobs.find(id);
+            if(itr == jobs.end())
+                return false;
+            job = itr->second;
+        }
+        if(job->cancelled.exchange(true))
+            return false;
+        // Queued and backing off jobs are skipped when they come up, the worker waiting on a running one interrupts it
+        if(job->status == Status::Queued)
+            Complete(job, Status::Cancelled);
+        return true;
+    }
+
+    DownloadManager::Status DownloadManager::GetStatus(int id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto itr = jobs.find(id);
+        if(itr == jobs.end())
+            return Status::Failed;
+        return itr->second->status;
+    }
+
+    void DownloadManager::EnsureWorker() {
+        // More workers would only queue up behind each other on the PythonWorker thread
+        if(workerStarted)
+            return;
+        workerStarted = true;
+        std::thread(&DownloadManager::WorkerLoop).detach();
+    }
+
+    DownloadManager::JobPtr DownloadManager::NextJob() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while(true) {
+            auto now = std::chrono::steady_clock::now();
+            std::optional<std::chrono::steady_clock::time_point> nextRetry;
+            for(auto itr = retries.begin(); itr != retries.end();) {
+                if((*itr)->notBefore <= now || (*itr)->cancelled) {
+                    queue.push(*itr);
+                    itr = retries.erase(itr);
+                } else {
+                    nextRetry = std::min(nextRetry.value_or((*itr)->notBefore), (*itr)->notBefore);
+                    itr++;
+                }
+            }
+            while(!queue.empty()) {
+                auto job = queue.top();
+                queue.pop();
+                if(!job->cancelled)
+                    return job;
+                lock.unlock();
+                Complete(job, Status::Cancelled);
+                lock.lock();
+            }
+            if(nextRetry.has_value())
+                condition.wait_until(lock, *nextRetry);
+            else
+                condition.wait(lock);
+        }
+    }
+
+    void DownloadManager::WorkerLoop() {
+        while(true) {
+            auto job = NextJob();
+            job->status = Status::Downloading;
+            bool success = Run(job);
+            if(job->cancelled) {
+                Complete(job, Status::Cancelled);
+            } else if(success) {
+                Complete(job, Status::Finished);
+            } else if(job->attempt < maxRetries) {
+                job->status = Status::Queued;
+                job->notBefore = std::chrono::steady_clock::now() + RETRY_BASE_DELAY * (1 << job->attempt);
+                job->attempt++;
+                LOG_INFO("Download of %s failed, retry %d in %lld s", job->url.c_str(), job->attempt,
+                    (long long) std::chrono::duration_cast<std::chrono::seconds>(RETRY_BASE_DELAY * (1 << (job->attempt - 1))).count());
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    retries.emplace_back(job);
+                }
+                condition.notify_one();
+            } else {
+                Complete(job, Status::Failed);
+            }
+        }
+    }
+
+    void DownloadManager::Complete(const JobPtr& job, Status status) {
+        // Cancel and the worker can both finish a job that was cancelled while queued
+        auto previous = job->status.exchange(status);
+        if(previous == Status::Finished || previous == Status::Failed || previous == Status::Cancelled)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.erase(job->id);
+        }
+        if(job->completion) {
+            QuestUI::MainThreadScheduler::Schedule([job, status] {
+                job->completion(status);
+            });
+        }
+    }
+
+    void DownloadManager::ReportProgress(Job* job, const Progress& progress) {
+        if(!job->progress)
+            return;
+        // Don't flood the main thread with every update, the percentage stays at 0 while the total size is unknown
+        auto now = std::chrono::steady_clock::now();
+        if(now - job->lastProgress < PROGRESS_INTERVAL && progress.percentage < 100.0f)
+            return;
+        job->lastProgress = now;
+        QuestUI::MainThreadScheduler::Schedule([callback = job->progress, progress] {
+            callback(progress);
+        });
+    }
+
+    // Called by the yt-dlp progress hook on the thread running the download
+    Python::PyObject* DownloadManager::ProgressHook([[maybe_unused]] Python::PyObject* self, Python::PyObject* args) {
+        using namespace Python;
+        auto start = std::chrono::steady_clock::now();
+        Progress progress;
+        if(!PyArg_ParseTuple(args, "dddd", &progress.downloadedBytes, &progress.totalBytes, &progress.speed, &progress.eta))
+            return nullptr;
+        if(auto job = currentJob) {
+            if(progress.totalBytes > 0.0)
+                progress.percentage = static_cast<float>(progress.downloadedBytes / progress.totalBytes * 100.0);
+            job->structuredProgress = true;
+            ReportProgress(job, progress);
+            job->hookTime += std::chrono::steady_clock::now() - start;
+            job->hookCalls++;
+        }
+        Py_RETURN_NONE;
+    }
+
+    void DownloadManager::RegisterProgressModule() {
+        using namespace Python;
+        static PyMethodDef progressMethods[] = {
+            {"progress", ProgressHook, METH_VARARGS, "Reports the progress of the current download"},
+            {nullptr, nullptr, 0, nullptr}
+        };
+        static PyModuleDef progressModule = {
+            PyModuleDef_HEAD_INIT,
+            "cinema",
+            nullptr,
+            -1,
+            progressMethods,
+            nullptr,
+            nullptr,
+            nullptr,
+            nullptr
+        };
+        static bool registered = false;
+        if(registered)
+            return;
+        registered = true;
+        AddNativeModule(progressModule);
+        // _real_main builds its own YoutubeDL, so the hook is added to every instance
+        PyRun_SimpleString(
+            "import cinema\n"
+            "from yt_dlp.YoutubeDL import YoutubeDL as _CinemaYoutubeDL\n"
+            "def _cinema_progress(d):\n"
+            "    cinema.progress(float(d.get('downloaded_bytes') or 0), float(d.get('total_bytes') or d.get('total_bytes_estimate') or 0), float(d.get('speed') or 0), float(d.get('eta') or 0))\n"
+            "_cinema_init = _CinemaYoutubeDL.__init__\n"
+            "def _cinema_patched_init(self, *args, **kwargs):\n"
+            "    _cinema_init(self, *args, **kwargs)\n"
+            "    self.add_progress_hook(_cinema_progress)\n"
+            "_CinemaYoutubeDL.__init__ = _cinema_patched_init\n"
+        );
+    }
+
+    bool DownloadManager::Run(const JobPtr& job) {
+        bool error = false;
+        std::function<void(int, char*)> eventHandler = [job, &error](int type, char* data) {
+            if(currentJob != job.get())
+                return;
+            switch (type) {
+            case 0:
+                // Fallback for when the progress hook isn't available
+                if(!job->structuredProgress) {
+                    auto start = std::chrono::steady_clock::now();
+                    std::string_view line(data);
+                    auto pos = line.find('%');
+                    if(line.find("[download]") != std::string_view::npos && pos != std::string_view::npos) {
+                        // The number right in front of the %, e.g. "[download]  42.3% of 10.00MiB", anything else is ignored
+                        auto begin = pos;
+                        while(begin > 0 && (std::isdigit(static_cast<unsigned char>(line[begin - 1])) || line[begin - 1] == '.'))
+                            begin--;
+                        char* end = nullptr;
+                        float percentage = std::strtof(data + begin, &end);
+                        if(begin < pos && end == data + pos) {
+                            Progress progress;
+                            progress.percentage = percentage;
+                            ReportProgress(job.get(), progress);
+                        }
+                    }
+                    job->textTime += std::chrono::steady_clock::now() - start;
+                    job->textCalls++;
+                }
+                break;
+            case 1:
+                error = true;
+                LOG_INFO("Error: %s", data);
+                break;
+            }
+        };
+
+        std::promise<int> result;
+        PythonWorker::Command command;
+        command.url = job->url;
+        command.options = {
+            { "--no-cache-dir", "" },
+            { "-o", "%(id)s.%(ext)s" },
+            // The game looks for <id>.mp4, separate video and audio streams are merged into that
+            { "--merge-output-format", "mp4" },
+            { "-P", "/sdcard" }
+        };
+        // Both run on the interpreter thread with the GIL held
+        command.started = [job, &eventHandler] {
+            // Cancelled while waiting for the interpreter
+            if(job->cancelled)
+                return false;
+            if(!cancelledException)
+                cancelledException = Python::PyErr_NewException("cinema.DownloadCancelled", nullptr, nullptr);
+            RegisterProgressModule();
+            Python::PythonWriteEvent += eventHandler;
+            currentJob = job.get();
+            job->pythonThread = Python::PyThread_get_thread_ident();
+            return true;
+        };
+        command.finished = [job, &eventHandler, &result](int code) {
+            job->pythonThread = 0;
+            currentJob = nullptr;
+            Python::PythonWriteEvent -= eventHandler;
+            result.set_value(code);
+        };
+        auto future = result.get_future();
+        PythonWorker::Submit(std::move(command));
+        // Taking the GIL to interrupt the download can block for as long as yt-dlp holds it, so it's done here and not in Cancel
+        bool interrupted = false;
+        while(future.wait_for(CANCEL_POLL_INTERVAL) == std::future_status::timeout) {
+            if(interrupted || !job->cancelled)
+                continue;
+            if(auto thread = job->pythonThread.load(); thread != 0 && cancelledException) {
+                auto state = Python::PyGILState_Ensure();
+                // The download may have finished while waiting for the GIL
+                if(job->pythonThread == thread)
+                    Python::PyThreadState_SetAsyncExc(thread, cancelledException);
+                Python::PyGILState_Release(state);
+                interrupted = true;
+            }
+        }
+        int code = future.get();
+
+        auto average = [](std::chrono::nanoseconds time, int calls) {
+            return calls > 0 ? (long long) (time.count() / calls) : 0LL;
+        };
+        LOG_DEBUG("Progress of %s: hook %d calls, %lld ns avg, text parser %d calls, %lld ns avg", job->url.c_str(),
+            job->hookCalls, average(job->hookTime, job->hookCalls), job->textCalls, average(job->textTime, job->textCalls));
+        return !error && code == 0;
+    }
+}
@@ -0,0 +1,90 @@
+#include "FrameRing.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace Cinema {
+
+    void FrameRing::AlignedDelete::operator()(uint8_t* ptr) const {
+        std::free(ptr);
+    }
+
+    void FrameRing::Configure(std::size_t pitch, std::size_t lines) {
+        this->pitch = AlignPitch(pitch);
+        slotSize = this->pitch * lines;
+        auto required = slotSize * SLOT_COUNT;
+        if(required > capacity) {
+            auto memory = static_cast<uint8_t*>(std::aligned_alloc(PITCH_ALIGNMENT, required));
+            if(!memory)
+                throw std::bad_alloc();
+            pool.reset(memory);
+            capacity = required;
+        }
+        writeIndex = 0;
+        writeSlotDropped = false;
+        writing = false;
+        readIndex = 1;
+        reading = false;
+        middle.store(2, std::memory_order_relaxed);
+    }
+
+    uint8_t* FrameRing::BeginWrite() {
+        if(writeSlotDropped) {
+            reusedSlots.fetch_add(1, std::memory_order_relaxed);
+            writeSlotDropped = false;
+        }
+        writing.store(true, std::memory_order_relaxed);
+        bool fresh = middle.load(std::memory_order_relaxed) & FRESH_BIT;
+        UpdatePeak(1 + fresh + reading.load(std::memory_order_relaxed));
+        return Slot(writeIndex);
+    }
+
+    void FrameRing::EndWrite() {
+        auto previous = middle.exchange(writeIndex | FRESH_BIT, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+        writeSlotDropped = previous & FRESH_BIT;
+        writing.store(false, std::memory_order_relaxed);
+        publishedFrames.fetch_add(1, std::memory_order_relaxed);
+        if(writeSlotDropped)
+            droppedFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const uint8_t* FrameRing::AcquireLatest() {
+        if(!(middle.load(std::memory_order_acquire) & FRESH_BIT))
+            return nullptr;
+        auto previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        reading.store(true, std::memory_order_relaxed);
+        presentedFrames.fetch_add(1, std::memory_order_relaxed);
+        // The frame just taken was the fresh one, the handoff slot holds the old read slot now
+        UpdatePeak(1 + writing.load(std::memory_order_relaxed));
+        return Slot(readIndex);
+    }
+
+    void FrameRing::EndRead() {
+        reading.store(false, std::memory_order_relaxed);
+    }
+
+    void FrameRing::UpdatePeak(uint32_t occupancy) {
+        auto peak = peakOccupancy.load(std::memory_order_relaxed);
+        while(occupancy > peak && !peakOccupancy.compare_exchange_weak(peak, occupancy, std::memory_order_relaxed));
+    }
+
+    FrameRing::Stats FrameRing::get_stats() const {
+        return {
+            publishedFrames.load(std::memory_order_relaxed),
+            presentedFrames.load(std::memory_order_relaxed),
+            droppedFrames.load(std::memory_order_relaxed),
+            reusedSlots.load(std::memory_order_relaxed),
+            peakOccupancy.load(std::memory_order_relaxed)
+        };
+    }
+
+    void FrameRing::ResetStats() {
+        publishedFrames = 0;
+        presentedFrames = 0;
+        droppedFrames = 0;
+        reusedSlots = 0;
+        peakOccupancy = 0;
+    }
+}
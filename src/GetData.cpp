@@ -2,7 +2,6 @@
 #include "Data/SongDetailsContainer.hpp"
 #include "SongProto.pb.h"
 #include "Utils.hpp"
-"include/gzip-hpp"
 
 namespace SongDetailsCache {
     const Song Song::none(-1, 0, 0, nullptr);
@@ -32,29 +31,73 @@ namespace SongDetailsCache {
         return max;
     }
 
-    float Song::rating() const noexcept {
+    static float Rating(uint32_t upvotes, uint32_t downvotes) {
         float tot = upvotes + downvotes;
         if (tot == 0) return 0;
         float tmp = upvotes / tot;
         return (float)(tmp - (tmp - 0.5f) * pow(2, -log10f(tot + 1)));
     }
 
-    float Song::minNJS() const noexcept { return min([](const auto& diff){ return diff.njs; }); }
-    float Song::maxNJS() const noexcept { return max([](const auto& diff){ return diff.njs; }); }
+    SongDetailsContainer::SongAggregates::SongAggregates(const std::vector<Song>& songs, const std::vector<SongDifficulty>& difficulties) {
+        for (auto column : { &minNJS, &maxNJS, &minStar, &maxStar, &minPP, &maxPP, &rating })
+            column->reserve(songs.size());
+        for (const auto& song : songs) {
+            // Same start values as Song::min and Song::max
+            float songMinNJS = std::numeric_limits<float>::max(), songMaxNJS = std::numeric_limits<float>::min();
+            float songMinStar = std::numeric_limits<float>::max(), songMaxStar = std::numeric_limits<float>::min();
+            float songMinPP = std::numeric_limits<float>::max(), songMaxPP = std::numeric_limits<float>::min();
+            for (std::size_t i = song.diffOffset; i < song.diffOffset + song.diffCount; i++) {
+                const auto& diff = difficulties[i];
+                songMinNJS = std::min(songMinNJS, diff.njs);
+                songMaxNJS = std::max(songMaxNJS, diff.njs);
+                songMinStar = std::min(songMinStar, diff.ranked() ? diff.stars : std::numeric_limits<float>::max());
+                songMaxStar = std::max(songMaxStar, diff.stars);
+                songMinPP = std::min(songMinPP, diff.ranked() ? diff.approximatePpValue() : std::numeric_limits<float>::max());
+                songMaxPP = std::max(songMaxPP, diff.approximatePpValue());
+            }
+            bool ranked = song.rankedStatus == RankedStatus::Ranked;
+            minNJS.emplace_back(songMinNJS);
+            maxNJS.emplace_back(songMaxNJS);
+            minStar.emplace_back(ranked ? songMinStar : 0.0f);
+            maxStar.emplace_back(ranked ? songMaxStar : 0.0f);
+            minPP.emplace_back(ranked ? songMinPP : 0.0f);
+            maxPP.emplace_back(ranked ? songMaxPP : 0.0f);
+            rating.emplace_back(Rating(song.upvotes, song.downvotes));
+        }
+    }
+
+    float Song::rating() const noexcept {
+        if (auto state = SongDetailsContainer::get_songState(*this)) return state->columns.songAggregates->rating[index];
+        return Rating(upvotes, downvotes);
+    }
+
+    // Only songs outside the published databases, like Song::none, still go through min and max
+    float Song::minNJS() const noexcept {
+        if (auto state = SongDetailsContainer::get_songState(*this)) return state->columns.songAggregates->minNJS[index];
+        return min([](const auto& diff){ return diff.njs; });
+    }
+    float Song::maxNJS() const noexcept {
+        if (auto state = SongDetailsContainer::get_songState(*this)) return state->columns.songAggregates->maxNJS[index];
+        return max([](const auto& diff){ return diff.njs; });
+    }
     float Song::minStar() const noexcept { 
         if (rankedStatus != RankedStatus::Ranked) return 0.0f;
+        if (auto state = SongDetailsContainer::get_songState(*this)) return state->columns.songAggregates->minStar[index];
         return min([](const auto& diff){ return diff.ranked() ? diff.stars : std::numeric_limits<float>::max(); }); 
     }
     float Song::maxStar() const noexcept { 
         if (rankedStatus != RankedStatus::Ranked) return 0.0f;
+        if (auto state = SongDetailsContainer::get_songState(*this)) return state->columns.songAggregates->maxStar[index];
         return max([](const auto& diff){ return diff.stars; });
     }
     float Song::minPP() const noexcept { 
         if (rankedStatus != RankedStatus::Ranked) return 0.0f;
+        if (auto state = SongDetailsContainer::get_songState(*this)) return state->columns.songAggregates->minPP[index];
         return min([](const auto& diff){ return diff.ranked() ? diff.approximatePpValue() : std::numeric_limits<float>::max(); }); 
     }
     float Song::maxPP() const noexcept {
         if (rankedStatus != RankedStatus::Ranked) return 0.0f;
+        if (auto state = SongDetailsContainer::get_songState(*this)) return state->columns.songAggregates->maxPP[index];
         return max([](const auto& diff){ return diff.approximatePpValue(); }); 
     }
 
@@ -71,27 +114,38 @@ namespace SongDetailsCache {
     }
 
     uint32_t Song::mapId() const noexcept {
-        return SongDetailsContainer::keys->operator[](index);
+        auto state = SongDetailsContainer::get_songState(*this);
+        return state ? state->columns.keys->operator[](index) : 0;
     }
 
     std::string Song::hash() const noexcept {
-        return HexUtil::SongBytesToHash(index);
+        auto state = SongDetailsContainer::get_songState(*this);
+        if (!state) return "";
+        auto bytes = static_cast<const uint8_t*>(state->columns.hashBytes->operator[](index));
+        return HexUtil::ByteArrayToHex(std::span<uint8_t>(const_cast<uint8_t*>(bytes), sizeof(SongHash)));
     }
 
+    // The strings live in the same database as the song, they stay valid for as long as it does
+    static const std::string emptyString;
+
     const std::string& Song::songName() const noexcept {
-        return SongDetailsContainer::songNames->operator[](index);
+        auto state = SongDetailsContainer::get_songState(*this);
+        return state ? state->columns.songNames->operator[](index) : emptyString;
     }
 
     const std::string& Song::songAuthorName() const noexcept {
-        return SongDetailsContainer::songAuthorNames->operator[](index);
+        auto state = SongDetailsContainer::get_songState(*this);
+        return state ? state->columns.names->get(state->columns.songAuthorNames->operator[](index)) : emptyString;
     }
 
     const std::string& Song::levelAuthorName() const noexcept {
-        return SongDetailsContainer::levelAuthorNames->operator[](index);
+        auto state = SongDetailsContainer::get_songState(*this);
+        return state ? state->columns.names->get(state->columns.levelAuthorNames->operator[](index)) : emptyString;
     }
 
     const std::string& Song::uploaderName() const noexcept {
-        return SongDetailsContainer::uploaderNames->operator[](index);
+        auto state = SongDetailsContainer::get_songState(*this);
+        return state ? state->columns.names->get(state->columns.uploaderNames->operator[](index)) : emptyString;
     }
 
     std::string Song::coverURL() const noexcept {
@@ -101,8 +155,7 @@ namespace SongDetailsCache {
     }
 
     bool Song::GetDifficulty(const SongDifficulty*& outDiff, MapDifficulty diff, MapCharacteristic characteristic) const noexcept {
-        for (std::size_t i = 0; i < diffCount; i++) {
-            const auto& x = SongDetailsContainer::difficulties->operator[](i + diffOffset);
+        for (const auto& x : *this) {
             if (x.difficulty == diff && x.characteristic == characteristic) {
                 outDiff = &x;
                 return true;
@@ -138,10 +191,17 @@ namespace SongDetailsCache {
         return SongDifficulty::none;
     }
 
+    // Song::none and songs of a database that is gone have no difficulties
+    static const std::vector<SongDifficulty> noDifficulties;
+
     Song::difficulty_const_iterator Song::begin() const noexcept {
-        return std::next(SongDetailsContainer::difficulties->begin(), diffOffset);
+        auto state = SongDetailsContainer::get_songState(*this);
+        if (!state) return noDifficulties.begin();
+        return std::next(state->columns.difficulties->cbegin(), diffOffset);
     }
     Song::difficulty_const_iterator Song::end() const noexcept {
-        return std::next(SongDetailsContainer::difficulties->begin(), diffOffset + diffCount);
+        auto state = SongDetailsContainer::get_songState(*this);
+        if (!state) return noDifficulties.end();
+        return std::next(state->columns.difficulties->cbegin(), diffOffset + diffCount);
     }
 }
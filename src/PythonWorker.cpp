@@ -0,0 +1,256 @@
+#include "PythonWorker.hpp"
+#include "AssetImporter.hpp"
+#include "main.hpp"
+#include "PythonInternal.hpp"
+#include "CustomLogger.hpp"
+#include "assets.hpp"
+
+#include "Utils/FileUtils.hpp"
+
+#include <fstream>
+
+namespace Cinema {
+
+    void LatencyHistogram::Add(std::chrono::nanoseconds latency) {
+        auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(latency).count();
+        int bucket = 0;
+        while(milliseconds > 0 && bucket < BUCKET_COUNT - 1) {
+            milliseconds >>= 1;
+            bucket++;
+        }
+        buckets[bucket]++;
+        count++;
+        total += latency;
+        max = std::max(max, latency);
+    }
+
+    void LatencyHistogram::Log(const char* name) const {
+        if(count == 0)
+            return;
+        LOG_INFO("%s latency: %d samples, %lld ms avg, %lld ms max", name, count,
+            (long long) std::chrono::duration_cast<std::chrono::milliseconds>(total / count).count(),
+            (long long) std::chrono::duration_cast<std::chrono::milliseconds>(max).count());
+        for(int i = 0; i < BUCKET_COUNT; i++) {
+            if(buckets[i] == 0)
+                continue;
+            // Bucket i holds [2^(i-1), 2^i) ms, the first one everything below 1 ms
+            LOG_INFO("  < %lld ms: %d", 1LL << i, buckets[i]);
+        }
+    }
+
+    LockFreeQueue<PythonWorker::Command> PythonWorker::commands;
+    std::atomic<uint32_t> PythonWorker::submitted = 0;
+    std::atomic<bool> PythonWorker::started = false;
+    Python::PyObject* PythonWorker::runFunction = nullptr;
+
+    std::optional<std::chrono::steady_clock::time_point> PythonWorker::loadStart = std::nullopt;
+    bool PythonWorker::coldStart = false;
+
+    LatencyHistogram PythonWorker::queueLatency;
+    LatencyHistogram PythonWorker::runLatency;
+
+    void PythonWorker::Submit(Command command) {
+        command.submitted = std::chrono::steady_clock::now();
+        commands.Push(std::move(command));
+        // Sequentially consistent with the check of started, FailQueued relies on seeing one or the other
+        submitted.fetch_add(1);
+        submitted.notify_one();
+        if(!started.exchange(true))
+            std::thread(&PythonWorker::ThreadLoop).detach();
+    }
+
+    void PythonWorker::ThreadLoop() {
+        loadStart = std::chrono::steady_clock::now();
+        if(!Python::LoadPython()) {
+            LOG_ERROR("Couldn't load Python, yt-dlp commands won't run");
+            FailQueued();
+            return;
+        }
+        Python::PyGILState_Ensure();
+        // Before anything else is imported, so only the startup modules are recorded
+        AssetImporter::Install();
+        // Only hold the GIL while a command runs
+        auto threadState = Python::PyEval_SaveThread();
+        auto lastLatencyLog = std::chrono::steady_clock::now();
+        while(true) {
+            auto observed = submitted.load(std::memory_order_acquire);
+            while(auto command = commands.Pop()) {
+                Python::PyEval_RestoreThread(threadState);
+                auto start = std::chrono::steady_clock::now();
+                queueLatency.Add(start - command->submitted);
+                int result = Execute(*command);
+                if(result == 0 && loadStart.has_value()) {
+                    LOG_INFO("Python startup (%s): %lld ms from LoadPython to the first yt-dlp run", coldStart ? "cold" : "warm",
+                        (long long) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - *loadStart).count());
+                    loadStart = std::nullopt;
+                }
+                runLatency.Add(std::chrono::steady_clock::now() - start);
+                if(command->finished)
+                    command->finished(result);
+                threadState = Python::PyEval_SaveThread();
+
+                if(std::chrono::steady_clock::now() - lastLatencyLog >= LATENCY_LOG_INTERVAL) {
+                    queueLatency.Log("yt-dlp queue");
+                    runLatency.Log("yt-dlp run");
+                    lastLatencyLog = std::chrono::steady_clock::now();
+                }
+            }
+            submitted.wait(observed, std::memory_order_acquire);
+        }
+    }
+
+    void PythonWorker::FailQueued() {
+        while(true) {
+            auto observed = submitted.load();
+            while(auto command = commands.Pop()) {
+                if(command->finished)
+                    command->finished(-1);
+            }
+            // The next Submit starts a new worker, LoadPython remembers the failure so that one fails right away too
+            started.store(false);
+            // A Submit between the last Pop and the store saw this worker still running and didn't start one
+            // Only keep going if no new worker took over the queue in the meantime
+            if(submitted.load() == observed || started.exchange(true))
+                return;
+        }
+    }
+
+    std::string PythonWorker::AssetStamp() {
+        std::string_view data = IncludedAssets::ytdlp_zip;
+        // FNV-1a, only has to notice that the mod shipped a different yt-dlp
+        uint64_t hash = 0xcbf29ce484222325;
+        for(auto c : data) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 0x100000001b3;
+        }
+        return string_format("%zu-%016llx", data.size(), (unsigned long long) hash);
+    }
+
+    bool PythonWorker::BuildBundle(const std::string& bundle) {
+        auto stamp = AssetStamp();
+        auto stampPath = bundle + ".stamp";
+        if(fileexists(bundle) && fileexists(stampPath) && readfile(stampPath) == stamp)
+            return true;
+        coldStart = true;
+        auto start = std::chrono::steady_clock::now();
+        auto source = FileUtils::getScriptsPath() + "/yt_dlp_source.zip";
+        {
+            std::string_view data = IncludedAssets::ytdlp_zip;
+            std::ofstream file(source, std::ios::binary | std::ios::trunc);
+            file.write(data.data(), data.size());
+            if(!file)
+                return false;
+        }
+        // Compiles every module once and stores only the bytecode, zipimport then loads it without touching the source
+        Python::PyRun_SimpleString(
+            "def _cinema_build_bundle(source, bundle):\n"
+            "    import os, zipfile, importlib._bootstrap_external as external\n"
+            "    with zipfile.ZipFile(source) as zin, zipfile.ZipFile(bundle + '.tmp', 'w', zipfile.ZIP_STORED) as zout:\n"
+            "        for info in zin.infolist():\n"
+            "            if info.is_dir():\n"
+            "                continue\n"
+            "            data = zin.read(info)\n"
+            "            name = 'yt_dlp/' + info.filename\n"
+            "            if name.endswith('.py'):\n"
+            "                code = compile(data, name, 'exec', dont_inherit=True, optimize=1)\n"
+            "                data = external._code_to_timestamp_pyc(code, 0, len(data))\n"
+            "                name += 'c'\n"
+            "            zout.writestr(name, data)\n"
+            "    os.replace(bundle + '.tmp', bundle)\n"
+        );
+        auto main = Python::PyImport_AddModule("__main__");
+        auto build = Python::PyObject_GetAttrString(main, "_cinema_build_bundle");
+        if(!build) {
+            Python::PyErr_Clear();
+            return false;
+        }
+        auto sourceArg = Python::PyUnicode_FromString(source.c_str());
+        auto bundleArg = Python::PyUnicode_FromString(bundle.c_str());
+        auto args = Python::PyTuple_Pack(2, sourceArg, bundleArg);
+        auto result = Python::PyObject_Call(build, args, nullptr);
+        Python::Py_DecRef(args);
+        Python::Py_DecRef(sourceArg);
+        Python::Py_DecRef(bundleArg);
+        Python::Py_DecRef(build);
+        deletefile(source);
+        if(!result) {
+            Python::PyErr_Print();
+            return false;
+        }
+        Python::Py_DecRef(result);
+        writefile(stampPath, stamp);
+        LOG_INFO("Built the yt-dlp bytecode bundle in %lld ms", (long long) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+        return true;
+    }
+
+    bool PythonWorker::Import() {
+        if(runFunction)
+            return true;
+        std::string bundle = FileUtils::getScriptsPath() + "/yt_dlp.zip";
+        if(BuildBundle(bundle)) {
+            // In front of the scripts path so an old extracted copy isn't picked up instead
+            Python::PyRun_SimpleString(("import sys\nsys.path.insert(0, '" + bundle + "')").c_str());
+        } else {
+            LOG_ERROR("Couldn't build the yt-dlp bundle, importing it from the embedded zip");
+            AssetImporter::Register(IncludedAssets::ytdlp_zip, "", "yt_dlp", FileUtils::getScriptsPath() + "/yt_dlp");
+        }
+        auto importStart = std::chrono::steady_clock::now();
+        // _real_main ends with sys.exit, turn that into a return code instead of letting it reach the interpreter
+        Python::PyRun_SimpleString(
+            "from yt_dlp.__init__ import _real_main\n"
+            "def _cinema_run(argv):\n"
+            "    try:\n"
+            "        _real_main(argv)\n"
+            "    except SystemExit as e:\n"
+            "        if e.code is None:\n"
+            "            return 0\n"
+            "        return e.code if isinstance(e.code, int) else 1\n"
+            "    return 0\n"
+        );
+        runFunction = Python::PyObject_GetAttrString(Python::PyImport_AddModule("__main__"), "_cinema_run");
+        if(!runFunction) {
+            Python::PyErr_Clear();
+            LOG_ERROR("Couldn't import yt_dlp");
+            return false;
+        }
+        // Mostly stdlib imports through the AssetImporter, AssetImporterTest compares it with importing the extracted tree
+        LOG_INFO("Imported yt_dlp in %lld ms", (long long) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - importStart).count());
+        return true;
+    }
+
+    Python::PyObject* PythonWorker::BuildArguments(const Command& command) {
+        std::size_t size = 1;
+        for(auto& [option, value] : command.options)
+            size += value.empty() ? 1 : 2;
+        auto argv = Python::PyList_New(size);
+        Python::Py_ssize_t index = 0;
+        // PyList_SetItem steals the references
+        for(auto& [option, value] : command.options) {
+            Python::PyList_SetItem(argv, index++, Python::PyUnicode_FromString(option.c_str()));
+            if(!value.empty())
+                Python::PyList_SetItem(argv, index++, Python::PyUnicode_FromString(value.c_str()));
+        }
+        Python::PyList_SetItem(argv, index, Python::PyUnicode_FromString(command.url.c_str()));
+        return argv;
+    }
+
+    int PythonWorker::Execute(const Command& command) {
+        if(!Import())
+            return -1;
+        if(command.started && !command.started())
+            return -1;
+        auto argv = BuildArguments(command);
+        auto args = Python::PyTuple_Pack(1, argv);
+        auto result = Python::PyObject_Call(runFunction, args, nullptr);
+        Python::Py_DecRef(args);
+        Python::Py_DecRef(argv);
+        if(!result) {
+            // Goes through the error output, which marks the download as failed
+            Python::PyErr_Print();
+            return -1;
+        }
+        int code = Python::PyLong_AsLong(result);
+        Python::Py_DecRef(result);
+        return code;
+    }
+}
@@ -0,0 +1,650 @@
+#include "Data/SongDetailsContainer.hpp"
+#include "Data/SongDetailsSnapshot.hpp"
+#include "Data/DataGetter.hpp"
+#include "song-details/shared/Data/Song.hpp"
+#include "SongProto.pb.h"
+#include "Utils.hpp"
+#include "CustomLogger.hpp"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/gzip_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <unistd.h>
+
+namespace SongDetailsCache {
+    std::shared_ptr<const SongDetailsContainer::State> SongDetailsContainer::state = std::make_shared<SongDetailsContainer::State>();
+    std::atomic<const SongDetailsContainer::State*> SongDetailsContainer::currentState = state.get();
+    std::mutex SongDetailsContainer::generationsMutex;
+    std::vector<SongDetailsContainer::Generation> SongDetailsContainer::generations = { Generation(state) };
+    std::atomic<const Song*> SongDetailsContainer::olderSongsBegin = nullptr;
+    std::atomic<const Song*> SongDetailsContainer::olderSongsEnd = nullptr;
+
+    std::chrono::seconds SongDetailsContainer::updateThrottle = std::chrono::minutes(30);
+    unsigned int SongDetailsContainer::processThreadCount = 0;
+
+    UnorderedEventCallback<> SongDetailsContainer::dataAvailableOrUpdatedInternal;
+    UnorderedEventCallback<> SongDetailsContainer::dataLoadFailedInternal;
+
+    static std::size_t ResidentBytes() {
+        std::ifstream statm("/proc/self/statm");
+        std::size_t pages = 0, resident = 0;
+        statm >> pages >> resident;
+        return resident * sysconf(_SC_PAGESIZE);
+    }
+
+    static std::size_t PeakResidentBytes() {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.starts_with("VmHWM:"))
+                return std::stoull(line.substr(6)) * 1024;
+        }
+        return 0;
+    }
+
+    static void LogLoad(const char* source, std::size_t songCount, std::chrono::steady_clock::time_point start, std::size_t residentBefore) {
+        auto resident = ResidentBytes();
+        LOG_INFO("Loaded %zu songs from the %s in %lld ms, resident memory %zu KB (%+lld KB)", songCount, source,
+            (long long) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(),
+            resident / 1024, ((long long) resident - (long long) residentBefore) / 1024);
+    }
+
+    void SongDetailsContainer::Columns::reserve(std::size_t songCount, std::size_t difficultyCount) {
+        keys->reserve(songCount);
+        hashBytes->reserve(songCount);
+        hashBytesLUT->reserve(songCount);
+        songNames->reserve(songCount);
+        songAuthorNames->reserve(songCount);
+        levelAuthorNames->reserve(songCount);
+        uploaderNames->reserve(songCount);
+        songs->reserve(songCount);
+        difficulties->reserve(difficultyCount);
+    }
+
+    SongDetailsContainer::Generation::Generation(const std::shared_ptr<const State>& state) noexcept :
+        state(state),
+        pinned(state),
+        songsBegin(state->columns.songs->data()),
+        songsEnd(state->columns.songs->data() + state->columns.songs->size())
+        {}
+
+    static bool Contains(const Song* begin, const Song* end, const Song& song) {
+        return !std::less<const Song*>()(&song, begin) && std::less<const Song*>()(&song, end);
+    }
+
+    const SongDetailsContainer::State* SongDetailsContainer::get_songState(const Song& song) noexcept {
+        auto current = currentState.load(std::memory_order_acquire);
+        const auto& songs = *current->columns.songs;
+        if (Contains(songs.data(), songs.data() + songs.size(), song))
+            return current;
+        if (Contains(olderSongsBegin.load(std::memory_order_acquire), olderSongsEnd.load(std::memory_order_acquire), song)) {
+            // Whoever holds the song holds its state, the lock only keeps generations from changing while it's searched
+            std::lock_guard<std::mutex> lock(generationsMutex);
+            for (auto itr = generations.rbegin(); itr != generations.rend(); itr++) {
+                if (Contains(itr->songsBegin, itr->songsEnd, song) && !itr->state.expired())
+                    return itr->state.lock().get();
+            }
+        }
+        // A copy, or Song::none whose index is past the end of every database
+        return song.index < songs.size() ? current : nullptr;
+    }
+
+    std::future<void> SongDetailsContainer::Load(bool reload, int acceptableAgeHours) {
+        return std::async(std::launch::async, &SongDetailsContainer::Load_internal, reload, acceptableAgeHours);
+    }
+
+    void SongDetailsContainer::Load_internal(bool reload, int acceptableAgeHours) {
+        try {
+            if (!get_isDataAvailable()) {
+                auto start = std::chrono::steady_clock::now();
+                auto residentBefore = ResidentBytes();
+                if (auto snapshot = SongDetailsSnapshot::Open(SongDetailsSnapshot::path())) {
+                    Process(*snapshot);
+                    LogLoad("snapshot", get_state()->columns.songs->size(), start, residentBefore);
+                } else if (auto cached = DataGetter::ReadCachedDatabase()) {
+                    Process(*cached, false);
+                    LogLoad("cached protobuf", get_state()->columns.songs->size(), start, residentBefore);
+                    SongDetailsSnapshot::Write(SongDetailsSnapshot::path());
+                }
+            }
+
+            if (!reload && get_isDataAvailable()) {
+                if (DataGetter::HasCachedData(acceptableAgeHours))
+                    return;
+                if (std::chrono::system_clock::now() - get_state()->scrapeEndedTimeUnix < updateThrottle)
+                    return;
+            }
+
+            // Only the maps that changed since the loaded scrape, the full database is the fallback
+            if (!reload && get_isDataAvailable() && DataGetter::HasDeltaSource("Direct")) {
+                auto delta = DataGetter::UpdateAndReadDelta(get_state()->scrapeEndedTimeUnix).get();
+                if (delta && delta->data && ApplyDelta(*delta->data)) {
+                    SongDetailsSnapshot::Write(SongDetailsSnapshot::path());
+                    return;
+                }
+            }
+
+            auto database = DataGetter::UpdateAndReadDatabase().get();
+            if (database && database->data) {
+                Process(*database->data);
+                DataGetter::WriteCachedDatabase(*database).get();
+                SongDetailsSnapshot::Write(SongDetailsSnapshot::path());
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("Loading song details failed: %s", e.what());
+        }
+
+        if (!get_isDataAvailable())
+            dataLoadFailedInternal.invoke();
+    }
+
+    static Structs::SongProtoContainer Parse(const std::vector<uint8_t>& data) {
+        google::protobuf::io::ArrayInputStream compressed(data.data(), data.size());
+        google::protobuf::io::GzipInputStream decompressed(&compressed);
+        Structs::SongProtoContainer parsedContainer;
+        if (!parsedContainer.ParseFromZeroCopyStream(&decompressed))
+            throw std::runtime_error("Couldn't parse the song database");
+        return parsedContainer;
+    }
+
+    void SongDetailsContainer::Process(const std::vector<uint8_t>& data, bool force) {
+        google::protobuf::io::ArrayInputStream compressed(data.data(), data.size());
+        Process(compressed, force);
+    }
+
+    void SongDetailsContainer::Process(std::istream& istream, bool force) {
+        google::protobuf::io::IstreamInputStream compressed(&istream);
+        Process(compressed, force);
+    }
+
+    /// Number of difficulties in a raw SongProto record, without decoding any of the other fields
+    static std::size_t CountDifficulties(const char* record, uint32_t length) {
+        using google::protobuf::internal::WireFormatLite;
+        google::protobuf::io::CodedInputStream input(reinterpret_cast<const uint8_t*>(record), length);
+        std::size_t count = 0;
+        while (auto tag = input.ReadTag()) {
+            if (WireFormatLite::GetTagFieldNumber(tag) == Structs::SongProto::kDifficultiesFieldNumber)
+                count++;
+            if (!WireFormatLite::SkipField(&input, tag))
+                throw std::runtime_error("Couldn't parse the song database");
+        }
+        return count;
+    }
+
+    void SongDetailsContainer::DecodeChunk(Chunk& chunk) {
+        chunk.columns.reserve(chunk.lengths.size(), chunk.diffCount);
+        // One message reused for every song, parsing clears it but keeps the capacity of its strings and difficulties
+        Structs::SongProto parsedSong;
+        const char* record = chunk.records.data();
+        for (auto length : chunk.lengths) {
+            if (!parsedSong.ParseFromArray(record, length))
+                throw std::runtime_error("Couldn't parse the song database");
+            Append(chunk.columns, parsedSong, chunk.songOffset, chunk.diffOffset);
+            record += length;
+        }
+        chunk.records = std::string();
+    }
+
+    void SongDetailsContainer::AppendChunk(Columns& columns, Columns&& chunk) {
+        columns.keys->insert(columns.keys->end(), chunk.keys->begin(), chunk.keys->end());
+        columns.hashBytesLUT->insert(columns.hashBytesLUT->end(), chunk.hashBytesLUT->begin(), chunk.hashBytesLUT->end());
+        auto moveStrings = [](std::vector<std::string>& target, std::vector<std::string>& source) {
+            target.insert(target.end(), std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
+        };
+        moveStrings(*columns.songNames, *chunk.songNames);
+        // The chunk interned into its own pool, most of its names are already in the shared one
+        std::vector<uint32_t> ids;
+        ids.reserve(chunk.names->size());
+        for (uint32_t id = 0; id < chunk.names->size(); id++)
+            ids.emplace_back(columns.names->Intern(chunk.names->get(id)));
+        auto moveIds = [&ids](std::vector<uint32_t>& target, const std::vector<uint32_t>& source) {
+            for (auto id : source)
+                target.emplace_back(ids[id]);
+        };
+        moveIds(*columns.songAuthorNames, *chunk.songAuthorNames);
+        moveIds(*columns.levelAuthorNames, *chunk.levelAuthorNames);
+        moveIds(*columns.uploaderNames, *chunk.uploaderNames);
+        // Their members are const, so these can only be copy constructed one by one
+        for (const auto& hash : *chunk.hashBytes)
+            columns.hashBytes->emplace_back(hash);
+        for (const auto& song : *chunk.songs)
+            columns.songs->emplace_back(song);
+        for (const auto& diff : *chunk.difficulties)
+            columns.difficulties->emplace_back(diff);
+    }
+
+    void SongDetailsContainer::Process(google::protobuf::io::ZeroCopyInputStream& compressed, bool force) {
+        using google::protobuf::internal::WireFormatLite;
+        auto start = std::chrono::steady_clock::now();
+        google::protobuf::io::GzipInputStream decompressed(&compressed);
+        google::protobuf::io::CodedInputStream input(&decompressed);
+
+        // There is no song count up front, the current one is close enough to avoid most reallocations
+        auto currentState = get_state();
+        const auto& current = currentState->columns;
+        Columns columns;
+        columns.reserve(current.songs->size() + current.songs->size() / 64, current.difficulties->size() + current.difficulties->size() / 64);
+        std::chrono::sys_seconds scrapeEnded{};
+
+        // The gzip stream is read on this thread, which only splits it into records and counts their difficulties.
+        // That running count is all a chunk needs to know where its songs end up, decoding them happens in parallel
+        unsigned int threadCount = processThreadCount > 0 ? processThreadCount : std::max(std::thread::hardware_concurrency(), 1u);
+        std::deque<std::future<std::unique_ptr<Chunk>>> pending;
+        auto finishOldest = [&]() {
+            auto decoded = pending.front().get();
+            pending.pop_front();
+            AppendChunk(columns, std::move(decoded->columns));
+        };
+        auto chunk = std::make_unique<Chunk>();
+        std::size_t songCount = 0, diffCount = 0;
+        auto submit = [&]() {
+            songCount += chunk->lengths.size();
+            diffCount += chunk->diffCount;
+            if (threadCount <= 1) {
+                DecodeChunk(*chunk);
+                AppendChunk(columns, std::move(chunk->columns));
+            } else {
+                pending.emplace_back(std::async(std::launch::async, [](std::unique_ptr<Chunk> chunk) {
+                    DecodeChunk(*chunk);
+                    return chunk;
+                }, std::move(chunk)));
+                // Bounds the raw records held in memory
+                if (pending.size() > threadCount)
+                    finishOldest();
+            }
+            chunk = std::make_unique<Chunk>();
+            chunk->songOffset = songCount;
+            chunk->diffOffset = diffCount;
+        };
+
+        while (auto tag = input.ReadTag()) {
+            switch (WireFormatLite::GetTagFieldNumber(tag)) {
+                case Structs::SongProtoContainer::kScrapeEndedTimeUnixFieldNumber: {
+                    uint64_t value;
+                    if (!input.ReadVarint64(&value))
+                        throw std::runtime_error("Couldn't parse the song database");
+                    scrapeEnded = std::chrono::sys_seconds(std::chrono::seconds(value));
+                    // Written before the songs, an outdated database is dropped without decoding any of them
+                    if (!force && !current.songs->empty() && scrapeEnded <= currentState->scrapeEndedTimeUnix)
+                        return;
+                    break;
+                }
+                case Structs::SongProtoContainer::kSongsFieldNumber: {
+                    uint32_t length;
+                    if (WireFormatLite::GetTagWireType(tag) != WireFormatLite::WIRETYPE_LENGTH_DELIMITED || !input.ReadVarint32(&length))
+                        throw std::runtime_error("Couldn't parse the song database");
+                    auto& records = chunk->records;
+                    auto recordStart = records.size();
+                    records.resize(recordStart + length);
+                    if (!input.ReadRaw(records.data() + recordStart, length))
+                        throw std::runtime_error("Couldn't parse the song database");
+                    chunk->lengths.emplace_back(length);
+                    chunk->diffCount += CountDifficulties(records.data() + recordStart, length);
+                    if (chunk->lengths.size() == CHUNK_SONGS)
+                        submit();
+                    break;
+                }
+                default:
+                    if (!WireFormatLite::SkipField(&input, tag))
+                        throw std::runtime_error("Couldn't parse the song database");
+                    break;
+            }
+        }
+        if (!chunk->lengths.empty())
+            submit();
+        while (!pending.empty())
+            finishOldest();
+        if (decompressed.ZlibErrorCode() < 0 || columns.songs->empty())
+            throw std::runtime_error("Couldn't parse the song database");
+
+        Publish(std::move(columns), scrapeEnded);
+        LOG_INFO("Decoded %zu songs on %u threads in %lld ms, peak resident memory %zu KB", songCount, threadCount,
+            (long long) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(), PeakResidentBytes() / 1024);
+    }
+
+    void SongDetailsContainer::Process(const Structs::SongProtoContainer& parsedContainer, bool force) {
+        auto scrapeEnded = std::chrono::sys_seconds(std::chrono::seconds(parsedContainer.scrapeendedtimeunix()));
+        auto current = get_state();
+        if (!force && !current->columns.songs->empty() && scrapeEnded <= current->scrapeEndedTimeUnix)
+            return;
+
+        std::size_t len = parsedContainer.songs_size();
+        std::size_t diffLen = 0;
+        for (const auto& parsedSong : parsedContainer.songs())
+            diffLen += parsedSong.difficulties_size();
+
+        Columns columns;
+        columns.reserve(len, diffLen);
+        for (const auto& parsedSong : parsedContainer.songs())
+            Append(columns, parsedSong);
+        Publish(std::move(columns), scrapeEnded);
+    }
+
+    void SongDetailsContainer::Append(Columns& columns, const Structs::SongProto& parsedSong, std::size_t songOffset, std::size_t diffOffset) {
+        std::size_t index = songOffset + columns.songs->size();
+        diffOffset += columns.difficulties->size();
+        columns.keys->emplace_back(parsedSong.mapid());
+        const auto& hash = columns.hashBytes->emplace_back(parsedSong.hashbytes());
+        columns.hashBytesLUT->emplace_back(hash.c1);
+        columns.songNames->emplace_back(parsedSong.songname());
+        columns.songAuthorNames->emplace_back(columns.names->Intern(parsedSong.songauthorname()));
+        columns.levelAuthorNames->emplace_back(columns.names->Intern(parsedSong.levelauthorname()));
+        columns.uploaderNames->emplace_back(columns.names->Intern(parsedSong.uploadername()));
+
+        for (const auto& parsedDiff : parsedSong.difficulties())
+            columns.difficulties->emplace_back(index, &parsedDiff);
+        columns.songs->emplace_back(index, diffOffset, static_cast<uint8_t>(parsedSong.difficulties_size()), &parsedSong);
+    }
+
+    void SongDetailsContainer::AppendExisting(Columns& columns, const Columns& current, std::size_t index, Structs::SongProto& songProto, Structs::SongDifficultyProto& diffProto) {
+        const auto& song = (*current.songs)[index];
+        std::size_t newIndex = columns.songs->size();
+        std::size_t newDiffOffset = columns.difficulties->size();
+        columns.keys->emplace_back((*current.keys)[index]);
+        columns.hashBytes->emplace_back((*current.hashBytes)[index]);
+        columns.hashBytesLUT->emplace_back((*current.hashBytesLUT)[index]);
+        columns.songNames->emplace_back((*current.songNames)[index]);
+        columns.songAuthorNames->emplace_back(columns.names->Intern(current.names->get((*current.songAuthorNames)[index])));
+        columns.levelAuthorNames->emplace_back(columns.names->Intern(current.names->get((*current.levelAuthorNames)[index])));
+        columns.uploaderNames->emplace_back(columns.names->Intern(current.names->get((*current.uploaderNames)[index])));
+
+        for (std::size_t i = song.diffOffset; i < song.diffOffset + song.diffCount; i++) {
+            const auto& diff = (*current.difficulties)[i];
+            diffProto.set_characteristic(static_cast<uint32_t>(diff.characteristic));
+            diffProto.set_difficulty(static_cast<uint32_t>(diff.difficulty));
+            diffProto.set_starst100(std::lround(diff.stars * 100.0f));
+            diffProto.set_njst100(std::lround(diff.njs * 100.0f));
+            diffProto.set_bombs(diff.bombs);
+            diffProto.set_notes(diff.notes);
+            diffProto.set_obstacles(diff.obstacles);
+            diffProto.set_mods(static_cast<uint32_t>(diff.mods));
+            columns.difficulties->emplace_back(newIndex, &diffProto);
+        }
+        songProto.set_bpm(song.bpm);
+        songProto.set_downloadcount(song.downloadCount);
+        songProto.set_upvotes(song.upvotes);
+        songProto.set_downvotes(song.downvotes);
+        songProto.set_uploadtimeunix(song.uploadTimeUnix);
+        songProto.set_rankedchangeunix(song.rankedChangeUnix);
+        songProto.set_songdurationseconds(song.songDurationSeconds);
+        songProto.set_rankedstate(static_cast<uint32_t>(song.rankedStatus));
+        columns.songs->emplace_back(newIndex, newDiffOffset, song.diffCount, &songProto);
+    }
+
+    bool SongDetailsContainer::ApplyDelta(const std::vector<uint8_t>& data) {
+        return ApplyDelta(Parse(data));
+    }
+
+    bool SongDetailsContainer::ApplyDelta(const Structs::SongProtoContainer& delta) {
+        auto start = std::chrono::steady_clock::now();
+        auto current = GetColumns();
+        if (current.songs->empty())
+            return false;
+        const auto& currentKeys = *current.keys;
+        // The merge keeps the database ordered by mapId, anything else has to be rebuilt in full
+        if (std::adjacent_find(currentKeys.begin(), currentKeys.end(), std::greater_equal<uint32_t>()) != currentKeys.end()) {
+            LOG_INFO("Song details aren't ordered by mapId, falling back to the full database");
+            return false;
+        }
+
+        std::vector<const Structs::SongProto*> changed;
+        changed.reserve(delta.songs_size());
+        for (const auto& parsedSong : delta.songs())
+            changed.emplace_back(&parsedSong);
+        // Stable so the last record of a map that is in the delta twice wins below
+        std::stable_sort(changed.begin(), changed.end(), [](auto a, auto b) { return a->mapid() < b->mapid(); });
+
+        std::size_t diffLen = current.difficulties->size();
+        for (auto parsedSong : changed)
+            diffLen += parsedSong->difficulties_size();
+        Columns columns;
+        columns.reserve(currentKeys.size() + changed.size(), diffLen);
+        Structs::SongProto songProto;
+        Structs::SongDifficultyProto diffProto;
+        std::size_t added = 0, replaced = 0;
+        for (std::size_t i = 0, j = 0; i < currentKeys.size() || j < changed.size();) {
+            if (j < changed.size() && (i == currentKeys.size() || changed[j]->mapid() <= currentKeys[i])) {
+                auto mapId = changed[j]->mapid();
+                while (j + 1 < changed.size() && changed[j + 1]->mapid() == mapId)
+                    j++;
+                if (i < currentKeys.size() && currentKeys[i] == mapId) {
+                    replaced++;
+                    i++;
+                } else
+                    added++;
+                Append(columns, *changed[j++]);
+            } else
+                AppendExisting(columns, current, i++, songProto, diffProto);
+        }
+
+        Publish(std::move(columns), std::chrono::sys_seconds(std::chrono::seconds(delta.scrapeendedtimeunix())));
+        LOG_INFO("Applied song details delta, %zu added and %zu updated in %lld ms", added, replaced,
+            (long long) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+        return true;
+    }
+
+    void SongDetailsContainer::Process(const SongDetailsSnapshot& snapshot) {
+        using Section = SongDetailsSnapshot::Section;
+        std::size_t len = snapshot.get_songCount();
+        std::size_t diffLen = snapshot.get_difficultyCount();
+
+        Columns columns;
+        columns.reserve(len, diffLen);
+        auto keys = snapshot.get_section<uint32_t>(Section::Keys);
+        columns.keys->assign(keys.begin(), keys.end());
+        auto hashes = snapshot.get_section<SongHash>(Section::Hashes);
+        for (const auto& hash : hashes) {
+            columns.hashBytes->emplace_back(hash);
+            columns.hashBytesLUT->emplace_back(hash.c1);
+        }
+        auto hashTable = snapshot.get_section<HashSlot>(Section::HashTable);
+        columns.hashTable->assign(hashTable.begin(), hashTable.end());
+        auto mapIdTable = snapshot.get_section<uint32_t>(Section::MapIdTable);
+        columns.mapIdTable->assign(mapIdTable.begin(), mapIdTable.end());
+
+        // Song and SongDifficulty only know how to read a proto, one reused message each avoids a copy of every field
+        auto bpm = snapshot.get_section<float>(Section::Bpm);
+        auto downloadCount = snapshot.get_section<uint32_t>(Section::DownloadCount);
+        auto upvotes = snapshot.get_section<uint32_t>(Section::Upvotes);
+        auto downvotes = snapshot.get_section<uint32_t>(Section::Downvotes);
+        auto uploadTime = snapshot.get_section<uint32_t>(Section::UploadTime);
+        auto rankedChange = snapshot.get_section<uint32_t>(Section::RankedChange);
+        auto duration = snapshot.get_section<uint32_t>(Section::Duration);
+        auto rankedState = snapshot.get_section<uint8_t>(Section::RankedState);
+        auto diffOffset = snapshot.get_section<uint32_t>(Section::DiffOffset);
+        auto diffCount = snapshot.get_section<uint8_t>(Section::DiffCount);
+        Structs::SongProto songProto;
+        for (std::size_t i = 0; i < len; i++) {
+            songProto.set_bpm(bpm[i]);
+            songProto.set_downloadcount(downloadCount[i]);
+            songProto.set_upvotes(upvotes[i]);
+            songProto.set_downvotes(downvotes[i]);
+            songProto.set_uploadtimeunix(uploadTime[i]);
+            songProto.set_rankedchangeunix(rankedChange[i]);
+            songProto.set_songdurationseconds(duration[i]);
+            songProto.set_rankedstate(rankedState[i]);
+            columns.songs->emplace_back(i, diffOffset[i], diffCount[i], &songProto);
+
+            columns.songNames->emplace_back(snapshot.get_string(Section::SongNames, i));
+        }
+        // Written from a pool, every entry is distinct and keeps its id
+        std::size_t nameCount = snapshot.get_section<uint32_t>(Section::NamePool).size() - 1;
+        columns.names->reserve(nameCount);
+        for (std::size_t i = 0; i < nameCount; i++)
+            columns.names->Intern(snapshot.get_string(Section::NamePool, i));
+        auto songAuthorNames = snapshot.get_section<uint32_t>(Section::SongAuthorNames);
+        columns.songAuthorNames->assign(songAuthorNames.begin(), songAuthorNames.end());
+        auto levelAuthorNames = snapshot.get_section<uint32_t>(Section::LevelAuthorNames);
+        columns.levelAuthorNames->assign(levelAuthorNames.begin(), levelAuthorNames.end());
+        auto uploaderNames = snapshot.get_section<uint32_t>(Section::UploaderNames);
+        columns.uploaderNames->assign(uploaderNames.begin(), uploaderNames.end());
+
+        auto diffSong = snapshot.get_section<uint32_t>(Section::DiffSong);
+        auto characteristic = snapshot.get_section<uint8_t>(Section::Characteristic);
+        auto difficulty = snapshot.get_section<uint8_t>(Section::Difficulty);
+        auto starsT100 = snapshot.get_section<uint16_t>(Section::StarsT100);
+        auto njsT100 = snapshot.get_section<uint16_t>(Section::NjsT100);
+        auto bombs = snapshot.get_section<uint32_t>(Section::Bombs);
+        auto notes = snapshot.get_section<uint32_t>(Section::Notes);
+        auto obstacles = snapshot.get_section<uint32_t>(Section::Obstacles);
+        auto mods = snapshot.get_section<uint8_t>(Section::Mods);
+        Structs::SongDifficultyProto diffProto;
+        for (std::size_t i = 0; i < diffLen; i++) {
+            diffProto.set_characteristic(characteristic[i]);
+            diffProto.set_difficulty(difficulty[i]);
+            diffProto.set_starst100(starsT100[i]);
+            diffProto.set_njst100(njsT100[i]);
+            diffProto.set_bombs(bombs[i]);
+            diffProto.set_notes(notes[i]);
+            diffProto.set_obstacles(obstacles[i]);
+            diffProto.set_mods(mods[i]);
+            columns.difficulties->emplace_back(diffSong[i], &diffProto);
+        }
+        columns.difficultyColumns = std::make_shared<DifficultyColumns>(snapshot);
+        columns.searchIndex = std::make_shared<SongSearchIndex>(snapshot);
+        Publish(std::move(columns), std::chrono::sys_seconds(std::chrono::seconds(snapshot.get_scrapeEndedTimeUnix())));
+    }
+
+    /// Fibonacci hashing, map ids are mostly sequential and the high bits of the product spread them evenly
+    static uint32_t MapIdSlot(uint32_t mapId, uint32_t mask) {
+        return static_cast<uint32_t>((mapId * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+    }
+
+    void SongDetailsContainer::BuildLookupTables(Columns& columns) {
+        const auto& hashes = *columns.hashBytes;
+        const auto& keys = *columns.keys;
+        std::size_t capacity = std::bit_ceil(std::max<std::size_t>(hashes.size() * 2, 16));
+        uint32_t mask = capacity - 1;
+
+        auto& hashTable = *columns.hashTable;
+        hashTable.assign(capacity, { 0, EMPTY_SLOT });
+        for (uint32_t i = 0; i < hashes.size(); i++) {
+            // The hashes are sha1 already, their first bytes are as good as any hash of them
+            uint32_t prefix = hashes[i].c1;
+            auto slot = prefix & mask;
+            while (hashTable[slot].index != EMPTY_SLOT)
+                slot = (slot + 1) & mask;
+            hashTable[slot] = { prefix, i };
+        }
+
+        auto& mapIdTable = *columns.mapIdTable;
+        mapIdTable.assign(capacity, EMPTY_SLOT);
+        for (uint32_t i = 0; i < keys.size(); i++) {
+            auto slot = MapIdSlot(keys[i], mask);
+            while (mapIdTable[slot] != EMPTY_SLOT)
+                slot = (slot + 1) & mask;
+            mapIdTable[slot] = i;
+        }
+    }
+
+    void SongDetailsContainer::Publish(Columns&& columns, std::chrono::sys_seconds scrapeEnded) {
+        if (columns.hashTable->size() < columns.hashBytes->size() * 2 || columns.mapIdTable->size() != columns.hashTable->size())
+            BuildLookupTables(columns);
+        if (!columns.difficultyColumns || columns.difficultyColumns->size != columns.difficulties->size())
+            columns.difficultyColumns = std::make_shared<DifficultyColumns>(*columns.difficulties);
+        if (!columns.songAggregates || columns.songAggregates->rating.size() != columns.songs->size())
+            columns.songAggregates = std::make_shared<SongAggregates>(*columns.songs, *columns.difficulties);
+        if (!columns.searchIndex || columns.searchIndex->get_songCount() != columns.songs->size())
+            columns.searchIndex = BuildSearchIndex(columns);
+        LOG_INFO("Author, mapper and uploader names take %zu KB as %zu distinct strings", (columns.names->get_byteSize() +
+            (columns.songAuthorNames->size() + columns.levelAuthorNames->size() + columns.uploaderNames->size()) * sizeof(uint32_t)) / 1024, columns.names->size());
+        // The columns are kept next to the SongDifficulty array, not instead of it
+        auto columnBytes = columns.difficultyColumns->get_byteSize();
+        auto arrayBytes = columns.difficulties->size() * sizeof(SongDifficulty);
+        LOG_INFO("Difficulties take %zu KB for %zu difficulties, %zu KB of columns and %zu KB as SongDifficulty", (columnBytes + arrayBytes) / 1024,
+            columns.difficulties->size(), columnBytes / 1024, arrayBytes / 1024);
+
+        auto next = std::make_shared<State>();
+        next->sortedIndexes->songs = columns.songs;
+        next->sortedIndexes->aggregates = columns.songAggregates;
+        next->columns = std::move(columns);
+        next->scrapeEndedTimeUnix = scrapeEnded;
+        {
+            // Readers of the old state keep it alive, get_songState still finds its songs until they let go
+            std::lock_guard<std::mutex> lock(generationsMutex);
+            for (std::size_t i = 0; i + 1 < generations.size(); i++)
+                generations[i].pinned.reset();
+            std::erase_if(generations, [](const auto& generation) { return generation.state.expired(); });
+            const Song* begin = nullptr;
+            const Song* end = nullptr;
+            for (const auto& generation : generations) {
+                if (generation.songsBegin == generation.songsEnd)
+                    continue;
+                begin = begin ? std::min(begin, generation.songsBegin, std::less<const Song*>()) : generation.songsBegin;
+                end = end ? std::max(end, generation.songsEnd, std::less<const Song*>()) : generation.songsEnd;
+            }
+            generations.emplace_back(next);
+            olderSongsBegin.store(begin, std::memory_order_release);
+            olderSongsEnd.store(end, std::memory_order_release);
+        }
+        currentState.store(next.get(), std::memory_order_release);
+        std::atomic_store(&state, std::shared_ptr<const State>(std::move(next)));
+        dataAvailableOrUpdatedInternal.invoke();
+    }
+
+    std::optional<std::size_t> SongDetailsContainer::FindHash(const Columns& columns, const SongHash& hash) {
+        const auto& table = *columns.hashTable;
+        const auto& hashColumn = *columns.hashBytes;
+        if (table.empty())
+            return std::nullopt;
+        uint32_t mask = table.size() - 1;
+        for (auto slot = hash.c1 & mask;; slot = (slot + 1) & mask) {
+            const auto& entry = table[slot];
+            if (entry.index == EMPTY_SLOT)
+                return std::nullopt;
+            if (entry.prefix == hash.c1 && hashColumn[entry.index] == hash)
+                return entry.index;
+        }
+    }
+
+    std::optional<std::size_t> SongDetailsContainer::FindMapId(const Columns& columns, uint32_t mapId) {
+        const auto& table = *columns.mapIdTable;
+        const auto& keyColumn = *columns.keys;
+        if (table.empty())
+            return std::nullopt;
+        uint32_t mask = table.size() - 1;
+        for (auto slot = MapIdSlot(mapId, mask);; slot = (slot + 1) & mask) {
+            auto index = table[slot];
+            if (index == EMPTY_SLOT)
+                return std::nullopt;
+            if (keyColumn[index] == mapId)
+                return index;
+        }
+    }
+
+    SongList SongDetailsContainer::FindByHash(const SongHash& hash) {
+        auto current = get_state();
+        auto index = FindHash(current->columns, hash);
+        if (!index || *index >= current->columns.songs->size())
+            return SongList();
+        const Song* song = &(*current->columns.songs)[*index];
+        return SongList(std::move(current), { song });
+    }
+
+    SongList SongDetailsContainer::FindByHash(std::string_view hash) {
+        if (hash.size() != HASH_SIZE_BYTES * 2 || !std::all_of(hash.begin(), hash.end(), [](char c) { return std::isxdigit(static_cast<unsigned char>(c)); }))
+            return SongList();
+        return FindByHash(HexUtil::ToSongHash(hash));
+    }
+
+    SongList SongDetailsContainer::FindByMapId(uint32_t mapId) {
+        auto current = get_state();
+        auto index = FindMapId(current->columns, mapId);
+        if (!index || *index >= current->columns.songs->size())
+            return SongList();
+        const Song* song = &(*current->columns.songs)[*index];
+        return SongList(std::move(current), { song });
+    }
+}
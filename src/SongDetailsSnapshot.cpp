@@ -0,0 +1,305 @@
+#include "Data/SongDetailsSnapshot.hpp"
+#include "Data/SongDetailsContainer.hpp"
+#include "Data/DataGetter.hpp"
+#include "song-details/shared/Data/Song.hpp"
+#include "CustomLogger.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SongDetailsCache {
+    template<typename T, typename Row, typename Getter>
+    static std::vector<T> Gather(const std::vector<Row>& rows, Getter get) {
+        std::vector<T> column;
+        column.reserve(rows.size());
+        for (const auto& row : rows)
+            column.emplace_back(static_cast<T>(get(row)));
+        return column;
+    }
+
+    /// Appends every name to the heap, returns the offsets with one extra entry for the end of the last name
+    static std::vector<uint32_t> AppendStrings(const std::vector<std::string>& strings, std::string& heap) {
+        std::vector<uint32_t> offsets;
+        offsets.reserve(strings.size() + 1);
+        for (const auto& string : strings) {
+            offsets.emplace_back(heap.size());
+            heap.append(string);
+        }
+        offsets.emplace_back(heap.size());
+        return offsets;
+    }
+
+    SongDetailsSnapshot::SongDetailsSnapshot(const uint8_t* base, std::size_t size) noexcept :
+        base(base),
+        size(size),
+        header(reinterpret_cast<const Header*>(base))
+        {}
+
+    SongDetailsSnapshot::~SongDetailsSnapshot() {
+        munmap(const_cast<uint8_t*>(base), size);
+    }
+
+    std::filesystem::path SongDetailsSnapshot::path() {
+        return DataGetter::cachePath().parent_path() / "SongDetailsCache.columns";
+    }
+
+    /// Offsets into something limit long, the entries in between are their differences so they can't go backwards
+    static bool IsAscending(std::span<const uint32_t> offsets, uint64_t limit) noexcept {
+        return !offsets.empty() && std::is_sorted(offsets.begin(), offsets.end()) && offsets.back() <= limit;
+    }
+
+    /// Open addressing table over count songs, a lookup only ends on an empty slot so there has to be one
+    template<typename Slot, typename GetIndex>
+    static bool IsLookupTable(std::span<const Slot> table, uint32_t count, uint32_t emptySlot, GetIndex getIndex) noexcept {
+        if (!std::has_single_bit(table.size()) || table.size() > UINT32_MAX)
+            return false;
+        bool hasEmptySlot = false;
+        for (const auto& slot : table) {
+            auto index = getIndex(slot);
+            if (index == emptySlot)
+                hasEmptySlot = true;
+            else if (index >= count)
+                return false;
+        }
+        return hasEmptySlot;
+    }
+
+    bool SongDetailsSnapshot::IsValid() const noexcept {
+        if (size < sizeof(Header) || header->magic != MAGIC || header->version != VERSION)
+            return false;
+        for (const auto& section : header->sections) {
+            if (section.offset % ALIGNMENT != 0 || section.offset > size || section.size > size - section.offset)
+                return false;
+        }
+        // Process reads songCount and difficultyCount entries from every column without looking at their sizes
+        using ColumnSize = std::pair<Section, std::size_t>;
+        static constexpr const ColumnSize songColumns[] = {
+            { Section::Keys, sizeof(uint32_t) }, { Section::Hashes, sizeof(SongHash) }, { Section::Bpm, sizeof(float) },
+            { Section::DownloadCount, sizeof(uint32_t) }, { Section::Upvotes, sizeof(uint32_t) }, { Section::Downvotes, sizeof(uint32_t) },
+            { Section::UploadTime, sizeof(uint32_t) }, { Section::RankedChange, sizeof(uint32_t) }, { Section::Duration, sizeof(uint32_t) },
+            { Section::RankedState, sizeof(uint8_t) }, { Section::DiffOffset, sizeof(uint32_t) }, { Section::DiffCount, sizeof(uint8_t) }
+        };
+        static constexpr const ColumnSize difficultyColumns[] = {
+            { Section::DiffSong, sizeof(uint32_t) }, { Section::Characteristic, sizeof(uint8_t) }, { Section::Difficulty, sizeof(uint8_t) },
+            { Section::StarsT100, sizeof(uint16_t) }, { Section::NjsT100, sizeof(uint16_t) }, { Section::Bombs, sizeof(uint32_t) },
+            { Section::Notes, sizeof(uint32_t) }, { Section::Obstacles, sizeof(uint32_t) }, { Section::Mods, sizeof(uint8_t) }
+        };
+        for (auto [section, elementSize] : songColumns) {
+            if (header->sections[static_cast<uint32_t>(section)].size != static_cast<uint64_t>(header->songCount) * elementSize)
+                return false;
+        }
+        for (auto [section, elementSize] : difficultyColumns) {
+            if (header->sections[static_cast<uint32_t>(section)].size != static_cast<uint64_t>(header->difficultyCount) * elementSize)
+                return false;
+        }
+        for (auto song : get_section<uint32_t>(Section::DiffSong)) {
+            if (song >= header->songCount)
+                return false;
+        }
+        auto diffOffsets = get_section<uint32_t>(Section::DiffOffset);
+        auto diffCounts = get_section<uint8_t>(Section::DiffCount);
+        for (std::size_t i = 0; i < diffOffsets.size(); i++) {
+            if (static_cast<uint64_t>(diffOffsets[i]) + diffCounts[i] > header->difficultyCount)
+                return false;
+        }
+        // FindHash and FindMapId probe until they hit an empty slot and trust every index they find
+        if (header->sections[static_cast<uint32_t>(Section::HashTable)].size % sizeof(SongDetailsContainer::HashSlot) != 0 ||
+            header->sections[static_cast<uint32_t>(Section::MapIdTable)].size % sizeof(uint32_t) != 0)
+            return false;
+        if (!IsLookupTable(get_section<SongDetailsContainer::HashSlot>(Section::HashTable), header->songCount, SongDetailsContainer::EMPTY_SLOT, [](const auto& slot) { return slot.index; }))
+            return false;
+        if (!IsLookupTable(get_section<uint32_t>(Section::MapIdTable), header->songCount, SongDetailsContainer::EMPTY_SLOT, [](uint32_t index) { return index; }))
+            return false;
+
+        auto heapSize = header->sections[static_cast<uint32_t>(Section::StringHeap)].size;
+        auto nameSize = (static_cast<uint64_t>(header->songCount) + 1) * sizeof(uint32_t);
+        if (header->sections[static_cast<uint32_t>(Section::SongNames)].size != nameSize || !IsAscending(get_section<uint32_t>(Section::SongNames), heapSize))
+            return false;
+        auto pool = get_section<uint32_t>(Section::NamePool);
+        if (!IsAscending(pool, heapSize))
+            return false;
+        for (auto section : { Section::SongAuthorNames, Section::LevelAuthorNames, Section::UploaderNames }) {
+            auto ids = get_section<uint32_t>(section);
+            if (ids.size() != header->songCount)
+                return false;
+            for (auto id : ids) {
+                if (id >= pool.size() - 1)
+                    return false;
+            }
+        }
+        // The search index only has to be consistent enough to not read out of bounds
+        auto words = get_section<uint32_t>(Section::SearchWordOffsets);
+        auto songWordOffsets = get_section<uint32_t>(Section::SearchSongWordOffsets);
+        auto songWords = get_section<uint32_t>(Section::SearchSongWords);
+        auto postingOffsets = get_section<uint32_t>(Section::SearchPostingOffsets);
+        auto postings = get_section<uint32_t>(Section::SearchPostings);
+        if (get_section<uint32_t>(Section::SearchRanks).size() != header->songCount || !IsAscending(words, get_section<char>(Section::SearchVocabulary).size()))
+            return false;
+        if (songWordOffsets.size() != header->songCount + 1ULL || !IsAscending(songWordOffsets, songWords.size()))
+            return false;
+        if (postingOffsets.size() != words.size() || !IsAscending(postingOffsets, postings.size()))
+            return false;
+        for (auto rank : get_section<uint32_t>(Section::SearchRanks)) {
+            if (rank >= header->songCount)
+                return false;
+        }
+        for (auto word : songWords) {
+            if (word >= words.size() - 1)
+                return false;
+        }
+        for (auto rank : postings) {
+            if (rank >= header->songCount)
+                return false;
+        }
+        return true;
+    }
+
+    std::string_view SongDetailsSnapshot::get_string(Section section, std::size_t index) const noexcept {
+        auto offsets = get_section<uint32_t>(section);
+        auto heap = reinterpret_cast<const char*>(base + header->sections[static_cast<uint32_t>(Section::StringHeap)].offset);
+        return { heap + offsets[index], offsets[index + 1] - offsets[index] };
+    }
+
+    std::unique_ptr<SongDetailsSnapshot> SongDetailsSnapshot::Open(const std::filesystem::path& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return nullptr;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header))) {
+            close(fd);
+            return nullptr;
+        }
+        auto memory = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps the file alive on its own
+        close(fd);
+        if (memory == MAP_FAILED) {
+            LOG_ERROR("Couldn't map %s: %s", path.c_str(), strerror(errno));
+            return nullptr;
+        }
+        // Every column is read front to back exactly once
+        madvise(memory, info.st_size, MADV_SEQUENTIAL);
+        std::unique_ptr<SongDetailsSnapshot> snapshot(new SongDetailsSnapshot(reinterpret_cast<const uint8_t*>(memory), info.st_size));
+        if (!snapshot->IsValid()) {
+            LOG_INFO("Ignoring outdated song details snapshot %s", path.c_str());
+            return nullptr;
+        }
+        return snapshot;
+    }
+
+    bool SongDetailsSnapshot::Write(const std::filesystem::path& path) {
+        // One snapshot of the state, an update meanwhile doesn't mix columns of two databases into the file
+        auto state = SongDetailsContainer::get_state();
+        const auto& columns = state->columns;
+        if (columns.songs->empty())
+            return false;
+        auto start = std::chrono::steady_clock::now();
+        const auto& songs = *columns.songs;
+        const auto& diffs = *columns.difficulties;
+
+        Header header = {};
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.songCount = songs.size();
+        header.difficultyCount = diffs.size();
+        header.scrapeEndedTimeUnix = state->scrapeEndedTimeUnix.time_since_epoch().count();
+
+        auto temporary = path;
+        temporary += ".tmp";
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+        // The header is written again at the end once every section is placed
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        uint64_t position = sizeof(Header);
+        auto writeSection = [&](Section section, const void* data, std::size_t length) {
+            static constexpr const char padding[ALIGNMENT] = {};
+            auto pad = (ALIGNMENT - position % ALIGNMENT) % ALIGNMENT;
+            file.write(padding, pad);
+            position += pad;
+            header.sections[static_cast<uint32_t>(section)] = { position, length };
+            file.write(reinterpret_cast<const char*>(data), length);
+            position += length;
+        };
+        auto writeColumn = [&]<typename T>(Section section, const std::vector<T>& column) {
+            writeSection(section, column.data(), column.size() * sizeof(T));
+        };
+
+        writeColumn(Section::Keys, *columns.keys);
+        writeColumn(Section::Hashes, *columns.hashBytes);
+        writeColumn(Section::HashTable, *columns.hashTable);
+        writeColumn(Section::MapIdTable, *columns.mapIdTable);
+        writeColumn(Section::Bpm, Gather<float>(songs, [](const Song& song) { return song.bpm; }));
+        writeColumn(Section::DownloadCount, Gather<uint32_t>(songs, [](const Song& song) { return song.downloadCount; }));
+        writeColumn(Section::Upvotes, Gather<uint32_t>(songs, [](const Song& song) { return song.upvotes; }));
+        writeColumn(Section::Downvotes, Gather<uint32_t>(songs, [](const Song& song) { return song.downvotes; }));
+        writeColumn(Section::UploadTime, Gather<uint32_t>(songs, [](const Song& song) { return song.uploadTimeUnix; }));
+        writeColumn(Section::RankedChange, Gather<uint32_t>(songs, [](const Song& song) { return song.rankedChangeUnix; }));
+        writeColumn(Section::Duration, Gather<uint32_t>(songs, [](const Song& song) { return song.songDurationSeconds; }));
+        writeColumn(Section::RankedState, Gather<uint8_t>(songs, [](const Song& song) { return song.rankedStatus; }));
+        writeColumn(Section::DiffOffset, Gather<uint32_t>(songs, [](const Song& song) { return song.diffOffset; }));
+        writeColumn(Section::DiffCount, Gather<uint8_t>(songs, [](const Song& song) { return song.diffCount; }));
+        // The difficulty columns are already laid out like the sections, minus the padding
+        const auto& diffColumns = *columns.difficultyColumns;
+        auto writeDiffColumn = [&]<typename T>(Section section, const std::vector<T>& column) {
+            writeSection(section, column.data(), diffColumns.size * sizeof(T));
+        };
+        writeDiffColumn(Section::DiffSong, diffColumns.songIndex);
+        writeDiffColumn(Section::Characteristic, diffColumns.characteristic);
+        writeDiffColumn(Section::Difficulty, diffColumns.difficulty);
+        writeDiffColumn(Section::StarsT100, diffColumns.starsT100);
+        writeDiffColumn(Section::NjsT100, diffColumns.njsT100);
+        writeDiffColumn(Section::Bombs, diffColumns.bombs);
+        writeDiffColumn(Section::Notes, diffColumns.notes);
+        writeDiffColumn(Section::Obstacles, diffColumns.obstacles);
+        writeDiffColumn(Section::Mods, diffColumns.mods);
+
+        std::string heap;
+        writeColumn(Section::SongNames, AppendStrings(*columns.songNames, heap));
+        writeColumn(Section::SongAuthorNames, *columns.songAuthorNames);
+        writeColumn(Section::LevelAuthorNames, *columns.levelAuthorNames);
+        writeColumn(Section::UploaderNames, *columns.uploaderNames);
+        const auto& pool = *columns.names;
+        std::vector<uint32_t> poolOffsets;
+        poolOffsets.reserve(pool.size() + 1);
+        for (uint32_t id = 0; id < pool.size(); id++) {
+            poolOffsets.emplace_back(heap.size());
+            heap.append(pool.get(id));
+        }
+        poolOffsets.emplace_back(heap.size());
+        writeColumn(Section::NamePool, poolOffsets);
+        const auto& search = *columns.searchIndex;
+        writeColumn(Section::SearchRanks, search.byRank);
+        writeSection(Section::SearchVocabulary, search.vocabulary.data(), search.vocabulary.size());
+        writeColumn(Section::SearchWordOffsets, search.wordOffsets);
+        writeColumn(Section::SearchSongWordOffsets, search.songWordOffsets);
+        writeColumn(Section::SearchSongWords, search.songWords);
+        writeColumn(Section::SearchPostingOffsets, search.postingOffsets);
+        writeColumn(Section::SearchPostings, search.postings);
+
+        writeSection(Section::StringHeap, heap.data(), heap.size());
+
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        file.close();
+        if (!file) {
+            std::filesystem::remove(temporary);
+            return false;
+        }
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        if (error)
+            return false;
+        LOG_INFO("Wrote song details snapshot (%llu bytes) in %lld ms", (unsigned long long) position,
+            (long long) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+        return true;
+    }
+}
@@ -0,0 +1,282 @@
+#include "Data/SongSearchIndex.hpp"
+#include "Data/SongDetailsContainer.hpp"
+#include "Data/SongDetailsSnapshot.hpp"
+#include "Data/StringPool.hpp"
+#include "CustomLogger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <ranges>
+#include <span>
+
+namespace SongDetailsCache {
+    /// Base letter of U+00C0 to U+017F, a space for the two signs in there
+    static constexpr const std::string_view LATIN_BASE =
+        "aaaaaaaceeeeiiiidnooooo ouuuuyts"
+        "aaaaaaaceeeeiiiidnooooo ouuuuyty"
+        "aaaaaaccccccccddddeeeeeeeeeegggggggghhhhiiiiiiiiiiiijjkkklllllll"
+        "lllnnnnnnnnnoooooooorrrrrrssssssssttttttuuuuuuuuuuuuwwyyyzzzzzzs";
+    static_assert(LATIN_BASE.size() == 0x180 - 0xC0);
+
+    static void AppendUtf8(std::string& out, uint32_t codepoint) {
+        if (codepoint < 0x80) {
+            out += static_cast<char>(codepoint);
+        } else if (codepoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codepoint >> 6));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        } else if (codepoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codepoint >> 12));
+            out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (codepoint >> 18));
+            out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+    }
+
+    /// Next codepoint of text at position, which moves past it. Broken sequences come out as a space
+    static uint32_t NextCodepoint(std::string_view text, std::size_t& position) {
+        auto lead = static_cast<uint8_t>(text[position++]);
+        if (lead < 0x80)
+            return lead;
+        int length = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0;
+        if (length == 0 || position + length > text.size())
+            return ' ';
+        uint32_t codepoint = lead & (0x3F >> length);
+        for (int i = 0; i < length; i++) {
+            auto next = static_cast<uint8_t>(text[position]);
+            if ((next & 0xC0) != 0x80)
+                return ' ';
+            codepoint = (codepoint << 6) | (next & 0x3F);
+            position++;
+        }
+        return codepoint;
+    }
+
+    std::string SongSearchIndex::Normalize(std::string_view text) {
+        std::string out;
+        out.reserve(text.size());
+        for (std::size_t position = 0; position < text.size();) {
+            auto codepoint = NextCodepoint(text, position);
+            // Full width forms are common in japanese titles
+            if (codepoint >= 0xFF01 && codepoint <= 0xFF5E)
+                codepoint -= 0xFEE0;
+            if (codepoint < 0x80) {
+                auto c = static_cast<char>(codepoint);
+                if (c >= 'A' && c <= 'Z')
+                    out += c - 'A' + 'a';
+                else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9'))
+                    out += c;
+                else
+                    out += ' ';
+            } else if (codepoint >= 0xC0 && codepoint < 0x180) {
+                out += LATIN_BASE[codepoint - 0xC0];
+            } else if (codepoint >= 0x300 && codepoint < 0x370) {
+                // Combining diacritics
+                continue;
+            } else if ((codepoint >= 0x80 && codepoint < 0xC0) || (codepoint >= 0x2000 && codepoint < 0x2070) || (codepoint >= 0x3000 && codepoint < 0x3040)) {
+                // Latin-1, general and CJK punctuation
+                out += ' ';
+            } else {
+                if ((codepoint >= 0x391 && codepoint <= 0x3A9) || (codepoint >= 0x410 && codepoint <= 0x42F))
+                    codepoint += 0x20;
+                else if (codepoint >= 0x400 && codepoint <= 0x40F)
+                    codepoint += 0x50;
+                AppendUtf8(out, codepoint);
+            }
+        }
+        return out;
+    }
+
+    /// Calls found for every word of already normalized text
+    template<typename F>
+    static void ForEachWord(std::string_view text, F found) {
+        std::size_t start = 0;
+        while (start < text.size()) {
+            auto end = text.find(' ', start);
+            if (end == std::string_view::npos)
+                end = text.size();
+            if (end > start)
+                found(text.substr(start, end - start));
+            start = end + 1;
+        }
+    }
+
+    SongSearchIndex::WordRange SongSearchIndex::FindPrefix(std::string_view prefix) const noexcept {
+        uint32_t count = get_wordCount();
+        auto begin = *std::ranges::partition_point(std::views::iota(0u, count), [&](uint32_t id) { return get_word(id) < prefix; });
+        auto end = *std::ranges::partition_point(std::views::iota(begin, count), [&](uint32_t id) { return get_word(id).starts_with(prefix); });
+        return { begin, end };
+    }
+
+    bool SongSearchIndex::Matches(uint32_t rank, const std::vector<WordRange>& ranges) const noexcept {
+        auto words = songWords.begin();
+        auto first = words + songWordOffsets[rank];
+        auto last = words + songWordOffsets[rank + 1];
+        for (const auto& range : ranges) {
+            auto word = std::lower_bound(first, last, range.begin);
+            if (word == last || *word >= range.end)
+                return false;
+        }
+        return true;
+    }
+
+    std::vector<uint32_t> SongSearchIndex::Search(std::string_view query, std::size_t limit) const {
+        std::vector<uint32_t> results;
+        std::vector<WordRange> ranges;
+        bool empty = false;
+        ForEachWord(Normalize(query), [&](std::string_view word) {
+            auto range = FindPrefix(word);
+            empty |= range.begin == range.end;
+            ranges.emplace_back(range);
+        });
+        if (empty || ranges.empty() || limit == 0)
+            return results;
+
+        // The range with the fewest postings decides where the candidates come from
+        auto postingCount = [this](const WordRange& range) { return postingOffsets[range.end] - postingOffsets[range.begin]; };
+        auto narrowest = *std::ranges::min_element(ranges, {}, postingCount);
+        auto addIfMatching = [&](uint32_t rank) {
+            if (!Matches(rank, ranges))
+                return false;
+            results.emplace_back(byRank[rank]);
+            return results.size() == limit;
+        };
+        // Walking the ranks finds limit matches after about limit * songCount / count songs, gathering the postings costs count
+        uint64_t count = postingCount(narrowest);
+        if (count * count < static_cast<uint64_t>(limit) * get_songCount()) {
+            std::vector<uint32_t> candidates(postings.begin() + postingOffsets[narrowest.begin], postings.begin() + postingOffsets[narrowest.end]);
+            if (narrowest.end - narrowest.begin > 1) {
+                std::sort(candidates.begin(), candidates.end());
+                candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+            }
+            for (auto rank : candidates) {
+                if (addIfMatching(rank))
+                    break;
+            }
+        } else {
+            // Common words match early on, the walk stops once limit songs are found
+            for (uint32_t rank = 0; rank < get_songCount(); rank++) {
+                if (addIfMatching(rank))
+                    break;
+            }
+        }
+        return results;
+    }
+
+    std::size_t SongSearchIndex::get_byteSize() const noexcept {
+        return vocabulary.capacity() + (byRank.capacity() + wordOffsets.capacity() + songWordOffsets.capacity() + songWords.capacity() +
+            postingOffsets.capacity() + postings.capacity()) * sizeof(uint32_t);
+    }
+
+    template<typename T>
+    static void CopySection(std::vector<T>& column, std::span<const T> section) {
+        column.assign(section.begin(), section.end());
+    }
+
+    SongSearchIndex::SongSearchIndex(const SongDetailsSnapshot& snapshot) {
+        using Section = SongDetailsSnapshot::Section;
+        CopySection(byRank, snapshot.get_section<uint32_t>(Section::SearchRanks));
+        auto vocabularySection = snapshot.get_section<char>(Section::SearchVocabulary);
+        vocabulary.assign(vocabularySection.begin(), vocabularySection.end());
+        CopySection(wordOffsets, snapshot.get_section<uint32_t>(Section::SearchWordOffsets));
+        CopySection(songWordOffsets, snapshot.get_section<uint32_t>(Section::SearchSongWordOffsets));
+        CopySection(songWords, snapshot.get_section<uint32_t>(Section::SearchSongWords));
+        CopySection(postingOffsets, snapshot.get_section<uint32_t>(Section::SearchPostingOffsets));
+        CopySection(postings, snapshot.get_section<uint32_t>(Section::SearchPostings));
+    }
+
+    std::shared_ptr<SongSearchIndex> SongDetailsContainer::BuildSearchIndex(const Columns& columns) {
+        auto start = std::chrono::steady_clock::now();
+        const auto& songs = *columns.songs;
+        auto index = std::make_shared<SongSearchIndex>();
+        uint32_t songCount = songs.size();
+
+        auto& byRank = index->byRank;
+        byRank.resize(songCount);
+        std::iota(byRank.begin(), byRank.end(), 0);
+        // Not published yet, Song::rating() would read the current aggregates
+        const auto& rating = columns.songAggregates->rating;
+        std::stable_sort(byRank.begin(), byRank.end(), [&](uint32_t a, uint32_t b) {
+            if (rating[a] != rating[b])
+                return rating[a] > rating[b];
+            return songs[a].downloadCount > songs[b].downloadCount;
+        });
+
+        // Words get ids in the order they show up first, sorted afterwards
+        StringPool words;
+        std::vector<uint32_t> songWords;
+        auto& songWordOffsets = index->songWordOffsets;
+        songWordOffsets.reserve(songCount + 1);
+        songWordOffsets.emplace_back(0);
+        for (auto song : byRank) {
+            auto addWords = [&](std::string_view text) {
+                ForEachWord(SongSearchIndex::Normalize(text), [&](std::string_view word) { songWords.emplace_back(words.Intern(word)); });
+            };
+            addWords((*columns.songNames)[song]);
+            addWords(columns.names->get((*columns.songAuthorNames)[song]));
+            addWords(columns.names->get((*columns.levelAuthorNames)[song]));
+            addWords(columns.names->get((*columns.uploaderNames)[song]));
+            songWordOffsets.emplace_back(songWords.size());
+        }
+
+        std::vector<uint32_t> sorted(words.size());
+        std::iota(sorted.begin(), sorted.end(), 0);
+        std::sort(sorted.begin(), sorted.end(), [&words](uint32_t a, uint32_t b) { return words.get(a) < words.get(b); });
+        std::vector<uint32_t> wordId(words.size());
+        auto& wordOffsets = index->wordOffsets;
+        wordOffsets.reserve(words.size() + 1);
+        for (uint32_t i = 0; i < sorted.size(); i++) {
+            wordId[sorted[i]] = i;
+            wordOffsets.emplace_back(index->vocabulary.size());
+            index->vocabulary.append(words.get(sorted[i]));
+        }
+        wordOffsets.emplace_back(index->vocabulary.size());
+
+        // Each song once per word, in sorted word order
+        auto& uniqueWords = index->songWords;
+        uniqueWords.reserve(songWords.size());
+        std::vector<uint32_t> postingCount(words.size() + 1);
+        for (uint32_t rank = 0; rank < songCount; rank++) {
+            auto first = uniqueWords.size();
+            for (auto i = songWordOffsets[rank]; i < songWordOffsets[rank + 1]; i++)
+                uniqueWords.emplace_back(wordId[songWords[i]]);
+            std::sort(uniqueWords.begin() + first, uniqueWords.end());
+            uniqueWords.erase(std::unique(uniqueWords.begin() + first, uniqueWords.end()), uniqueWords.end());
+            songWordOffsets[rank] = first;
+            for (auto i = first; i < uniqueWords.size(); i++)
+                postingCount[uniqueWords[i] + 1]++;
+        }
+        songWordOffsets[songCount] = uniqueWords.size();
+
+        // Ranks are visited in order, so every posting list comes out sorted
+        auto& postingOffsets = index->postingOffsets;
+        postingOffsets.resize(words.size() + 1);
+        std::partial_sum(postingCount.begin(), postingCount.end(), postingOffsets.begin());
+        index->postings.resize(uniqueWords.size());
+        std::vector<uint32_t> next(postingOffsets.begin(), postingOffsets.end() - 1);
+        for (uint32_t rank = 0; rank < songCount; rank++) {
+            for (auto i = songWordOffsets[rank]; i < songWordOffsets[rank + 1]; i++)
+                index->postings[next[uniqueWords[i]]++] = rank;
+        }
+
+        LOG_INFO("Built the search index over %u songs and %zu words (%zu KB) in %lld ms", songCount, index->get_wordCount(), index->get_byteSize() / 1024,
+            (long long) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+        return index;
+    }
+
+    SongList SongDetailsContainer::Search(std::string_view query, std::size_t limit) {
+        auto current = get_state();
+        // Typed into the picker while the database is still loading
+        if (!current->columns.searchIndex)
+            return SongList();
+        const auto& songColumn = *current->columns.songs;
+        std::vector<const Song*> l;
+        for (auto song : current->columns.searchIndex->Search(query, limit))
+            l.emplace_back(&songColumn[song]);
+        return SongList(std::move(current), std::move(l));
+    }
+}
@@ -0,0 +1,71 @@
+#include "Data/SongDetailsContainer.hpp"
+#include "CustomLogger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <numeric>
+
+namespace SongDetailsCache {
+    static constexpr const char* KEY_NAMES[] = { "upload time", "ranked change", "rating", "download count", "bpm", "duration" };
+    static_assert(std::size(KEY_NAMES) == static_cast<std::size_t>(SongSortKey::Count));
+
+    double SongDetailsContainer::SortedIndexes::get_value(SongSortKey key, uint32_t index) const noexcept {
+        const auto& song = (*songs)[index];
+        switch (key) {
+            case SongSortKey::UploadTime: return song.uploadTimeUnix;
+            case SongSortKey::RankedChange: return song.rankedChangeUnix;
+            case SongSortKey::Rating: return aggregates->rating[index];
+            case SongSortKey::DownloadCount: return song.downloadCount;
+            case SongSortKey::Bpm: return song.bpm;
+            case SongSortKey::Duration: return song.songDurationSeconds;
+            default: return 0;
+        }
+    }
+
+    const std::vector<uint32_t>& SongDetailsContainer::SortedIndexes::get_order(SongSortKey key) {
+        auto slot = static_cast<std::size_t>(key);
+        std::call_once(built[slot], [this, key, slot]() {
+            auto start = std::chrono::steady_clock::now();
+            // Sorting pairs keeps the comparisons away from the songs
+            std::vector<std::pair<double, uint32_t>> values;
+            values.reserve(songs->size());
+            for (uint32_t i = 0; i < songs->size(); i++)
+                values.emplace_back(get_value(key, i), i);
+            std::sort(values.begin(), values.end());
+            auto& order = orders[slot];
+            order.reserve(values.size());
+            for (const auto& value : values)
+                order.emplace_back(value.second);
+            LOG_INFO("Sorted %zu songs by %s in %lld ms", order.size(), KEY_NAMES[slot],
+                (long long) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+        });
+        return orders[slot];
+    }
+
+    SongList SongDetailsContainer::FindSongsInRange(SongSortKey key, double min, double max, std::size_t limit, bool descending) {
+        std::vector<const Song*> l;
+        if (key >= SongSortKey::Count || min > max)
+            return {};
+        auto current = get_state();
+        auto indexes = current->sortedIndexes;
+        const auto& order = indexes->get_order(key);
+        const auto& songColumn = *indexes->songs;
+        auto first = std::partition_point(order.begin(), order.end(), [&](uint32_t index) { return indexes->get_value(key, index) < min; });
+        auto last = std::partition_point(first, order.end(), [&](uint32_t index) { return indexes->get_value(key, index) <= max; });
+        std::size_t count = std::min<std::size_t>(last - first, limit);
+        l.reserve(count);
+        if (descending) {
+            for (auto it = last; l.size() < count; )
+                l.emplace_back(&songColumn[*--it]);
+        } else {
+            for (auto it = first; l.size() < count; it++)
+                l.emplace_back(&songColumn[*it]);
+        }
+        return SongList(std::move(current), std::move(l));
+    }
+
+    SongList SongDetailsContainer::TopSongs(SongSortKey key, std::size_t limit, bool descending) {
+        return FindSongsInRange(key, -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(), limit, descending);
+    }
+}
@@ -0,0 +1,60 @@
+#include "Data/StringPool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+
+namespace SongDetailsCache {
+    std::size_t StringPool::Find(std::string_view string, std::size_t hash) const noexcept {
+        std::size_t mask = table.size() - 1;
+        for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            auto id = table[slot];
+            if (id == EMPTY_SLOT || strings[id] == string)
+                return slot;
+        }
+    }
+
+    void StringPool::Rehash(std::size_t count) {
+        table.assign(std::bit_ceil(std::max<std::size_t>(count * 2 + 2, 16)), EMPTY_SLOT);
+        for (uint32_t id = 0; id < strings.size(); id++)
+            table[Find(strings[id], std::hash<std::string_view>()(strings[id]))] = id;
+    }
+
+    void StringPool::reserve(std::size_t count) {
+        strings.reserve(count);
+        if (count * 2 + 2 > table.size())
+            Rehash(count);
+    }
+
+    uint32_t StringPool::Intern(std::string_view string) {
+        if (strings.size() * 2 + 2 > table.size())
+            Rehash(strings.size() * 2);
+        auto slot = Find(string, std::hash<std::string_view>()(string));
+        if (table[slot] == EMPTY_SLOT) {
+            table[slot] = strings.size();
+            strings.emplace_back(string);
+        }
+        return table[slot];
+    }
+
+    uint32_t StringPool::Intern(std::string&& string) {
+        if (strings.size() * 2 + 2 > table.size())
+            Rehash(strings.size() * 2);
+        auto slot = Find(string, std::hash<std::string_view>()(string));
+        if (table[slot] == EMPTY_SLOT) {
+            table[slot] = strings.size();
+            strings.emplace_back(std::move(string));
+        }
+        return table[slot];
+    }
+
+    std::size_t StringPool::get_byteSize() const noexcept {
+        static const std::size_t inlineCapacity = std::string().capacity();
+        std::size_t bytes = strings.capacity() * sizeof(std::string) + table.capacity() * sizeof(uint32_t);
+        for (const auto& string : strings) {
+            if (string.capacity() > inlineCapacity)
+                bytes += string.capacity() + 1;
+        }
+        return bytes;
+    }
+}
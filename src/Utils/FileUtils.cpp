@@ -6,6 +6,18 @@
 #include "ModInfo.hpp"
 #include "zip.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <unordered_map>
+#include <vector>
+
 namespace FileUtils {
 
     const std::string& getPythonPath() {
@@ -20,13 +32,165 @@ namespace FileUtils {
         return scriptsPath;
     }
 
-    int ExtractZip(std::string_view data, std::string_view path) {
-        int args = 2;
-        int statusCode = zip_stream_extract(data.data(), data.length(), path.data(), 
-            +[](const char* name, void* arg) -> int {
+    static const char* MANIFEST_NAME = ".extracted";
+    static const char* MANIFEST_COMPLETE = "#complete";
+
+    struct ZipEntryInfo {
+        std::size_t index;
+        std::string name;
+        uint64_t size;
+        uint32_t crc;
+    };
+
+    static std::string ManifestLine(const ZipEntryInfo& entry) {
+        return string_format("%s\t%llu\t%u", entry.name.c_str(), (unsigned long long) entry.size, entry.crc);
+    }
+
+    /// Maps every extracted entry name to its manifest line
+    static std::unordered_map<std::string, std::string> ReadManifest(const std::string& manifestPath) {
+        std::unordered_map<std::string, std::string> lines;
+        std::ifstream manifest(manifestPath);
+        std::string line;
+        while(std::getline(manifest, line)) {
+            auto tab = line.find('\t');
+            if(line != MANIFEST_COMPLETE && tab != std::string::npos)
+                lines[line.substr(0, tab)] = line;
+        }
+        return lines;
+    }
+
+    static bool IsInstalled(const std::string& filePath, uint64_t size) {
+        struct stat info;
+        return stat(filePath.c_str(), &info) == 0 && static_cast<uint64_t>(info.st_size) == size;
+    }
+
+    static std::size_t WriteChunk(void* arg, uint64_t offset, const void* data, std::size_t size) {
+        auto fd = *static_cast<int*>(arg);
+        std::size_t written = 0;
+        while(written < size) {
+            auto result = pwrite(fd, static_cast<const char*>(data) + written, size - written, offset + written);
+            if(result <= 0)
                 return 0;
-            }, &args);
-        return statusCode;
+            written += result;
+        }
+        return written;
+    }
+
+    static bool ExtractEntry(zip_t* zip, const ZipEntryInfo& entry, const std::string& root) {
+        if(zip_entry_openbyindex(zip, entry.index) < 0)
+            return false;
+        auto filePath = root + "/" + entry.name;
+        int fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0755);
+        bool success = fd >= 0;
+        if(success) {
+            // Reserve the whole file up front instead of growing it with every chunk
+            if(entry.size > 0)
+                posix_fallocate(fd, 0, entry.size);
+            success = zip_entry_extract(zip, WriteChunk, &fd) == 0;
+            close(fd);
+        }
+        zip_entry_close(zip);
+        return success;
+    }
+
+    int ExtractZip(std::string_view data, std::string_view path, const std::function<bool(std::string_view)>& filter, int threadCount) {
+        auto start = std::chrono::steady_clock::now();
+        std::string root(path);
+        auto zip = zip_stream_open(data.data(), data.length(), 0, 'r');
+        if(!zip)
+            return -1;
+        std::vector<ZipEntryInfo> entries;
+        std::vector<std::string> directories;
+        auto total = zip_entries_total(zip);
+        for(ssize_t i = 0; i < total; i++) {
+            if(zip_entry_openbyindex(zip, i) < 0)
+                continue;
+            std::string name = zip_entry_name(zip);
+            if(!filter || filter(name)) {
+                if(zip_entry_isdir(zip))
+                    directories.emplace_back(name);
+                else
+                    entries.push_back({ static_cast<std::size_t>(i), name, zip_entry_size(zip), zip_entry_crc32(zip) });
+            }
+            zip_entry_close(zip);
+        }
+        zip_stream_close(zip);
+
+        mkpath(root);
+        auto manifestPath = root + "/" + MANIFEST_NAME;
+        auto extracted = ReadManifest(manifestPath);
+        // Directories are created up front so the workers never race on them
+        for(auto& directory : directories)
+            mkpath(root + "/" + directory);
+        // Only entries whose size or CRC changed since the last extraction, or that went missing on disk, are written again
+        std::vector<ZipEntryInfo> pending;
+        for(auto& entry : entries) {
+            auto itr = extracted.find(entry.name);
+            bool unchanged = itr != extracted.end() && itr->second == ManifestLine(entry);
+            if(itr != extracted.end())
+                extracted.erase(itr);
+            if(unchanged && IsInstalled(root + "/" + entry.name, entry.size))
+                continue;
+            auto slash = entry.name.find_last_of('/');
+            if(slash != std::string::npos)
+                mkpath(root + "/" + entry.name.substr(0, slash));
+            pending.emplace_back(entry);
+        }
+        // What is left was removed from the zip, e.g. a module dropped by an update
+        for(auto& [name, line] : extracted)
+            deletefile(root + "/" + name);
+        // Largest first so one big library doesn't end up last on a single thread
+        std::sort(pending.begin(), pending.end(), [](auto& a, auto& b) { return a.size > b.size; });
+
+        if(threadCount <= 0)
+            threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        threadCount = std::clamp<int>(threadCount, 1, std::max<std::size_t>(pending.size(), 1));
+
+        std::mutex manifestMutex;
+        std::ofstream manifest(manifestPath, std::ios::app);
+        std::atomic<std::size_t> next = 0;
+        std::atomic<int> failed = 0;
+        auto worker = [&] {
+            // zip handles aren't thread safe, every worker reads the shared buffer through its own
+            auto workerZip = zip_stream_open(data.data(), data.length(), 0, 'r');
+            if(!workerZip) {
+                failed++;
+                return;
+            }
+            for(auto i = next++; i < pending.size(); i = next++) {
+                auto& entry = pending[i];
+                if(!ExtractEntry(workerZip, entry, root)) {
+                    LOG_ERROR("Couldn't extract %s", entry.name.c_str());
+                    failed++;
+                    continue;
+                }
+                std::lock_guard<std::mutex> lock(manifestMutex);
+                manifest << ManifestLine(entry) << '\n' << std::flush;
+            }
+            zip_stream_close(workerZip);
+        };
+        std::vector<std::thread> workers;
+        for(int i = 1; i < threadCount; i++)
+            workers.emplace_back(worker);
+        worker();
+        for(auto& thread : workers)
+            thread.join();
+        manifest.close();
+        if(failed == 0 && (!pending.empty() || !extracted.empty())) {
+            // Rewrite the appended manifest so it only lists what is installed now
+            auto compacted = manifestPath + ".tmp";
+            {
+                std::ofstream file(compacted, std::ios::trunc);
+                for(auto& entry : entries)
+                    file << ManifestLine(entry) << '\n';
+                file << MANIFEST_COMPLETE << '\n';
+            }
+            rename(compacted.c_str(), manifestPath.c_str());
+        }
+
+        LOG_INFO("Extracted %zu of %zu entries to %s (%zu removed) with %d threads in %lld ms", pending.size(), entries.size(), root.c_str(), extracted.size(), threadCount,
+            (long long) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+        return failed == 0 ? 0 : -1;
     }
 
 }
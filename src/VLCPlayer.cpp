@@ -0,0 +1,244 @@
+#include "VLCPlayer.hpp"
+#include "CustomLogger.hpp"
+
+#include "UnityEngine/Material.hpp"
+#include "UnityEngine/Object.hpp"
+#include "UnityEngine/TextureFormat.hpp"
+#include "UnityEngine/Vector2.hpp"
+
+using namespace UnityEngine;
+
+namespace Cinema {
+
+    static const char* const vlcArgs[] = {
+        "--no-audio",
+        "--no-xlib",
+        "--avcodec-hw=any",
+        "--no-video-title-show"
+    };
+
+    VLCPlayer::VLCPlayer() : instance(sizeof(vlcArgs) / sizeof(vlcArgs[0]), vlcArgs), mediaPlayer(instance) {
+        mediaPlayer.setVideoFormatCallbacks(
+            [this](char* chroma, uint32_t* width, uint32_t* height, uint32_t* pitches, uint32_t* lines) {
+                return FormatSetup(chroma, width, height, pitches, lines);
+            },
+            nullptr);
+        mediaPlayer.setVideoCallbacks(
+            [this](void** planes) {
+                return Lock(planes);
+            },
+            nullptr,
+            [this](void* picture) {
+                Display(picture);
+            });
+        controlThread = std::thread(&VLCPlayer::ControlLoop, this);
+    }
+
+    VLCPlayer::~VLCPlayer() {
+        Stop();
+        {
+            std::lock_guard<std::mutex> lock(controlMutex);
+            controlExit = true;
+        }
+        controlCondition.notify_one();
+        controlThread.join();
+    }
+
+    void VLCPlayer::Post(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(controlMutex);
+            controlTasks.push(std::move(task));
+        }
+        controlCondition.notify_one();
+    }
+
+    void VLCPlayer::ControlLoop() {
+        std::unique_lock<std::mutex> lock(controlMutex);
+        while(true) {
+            controlCondition.wait(lock, [this] { return controlExit || !controlTasks.empty(); });
+            if(controlTasks.empty())
+                return;
+            auto task = std::move(controlTasks.front());
+            controlTasks.pop();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    void VLCPlayer::CancelFormat() {
+        std::lock_guard<std::mutex> lock(formatMutex);
+        formatState = FormatState::Cancelled;
+        formatRequested = false;
+        formatApplied.notify_all();
+    }
+
+    void VLCPlayer::set_url(std::string_view value) {
+        url = value;
+        prepared = false;
+    }
+
+    void VLCPlayer::set_renderer(Renderer* value) {
+        renderer = value;
+        if(renderer && texture)
+            renderer->get_sharedMaterial()->set_mainTexture(texture);
+    }
+
+    void VLCPlayer::set_isLooping(bool value) {
+        isLooping = value;
+    }
+
+    void VLCPlayer::set_time(double time) {
+        // libvlc can't seek before the start of the media, a negative time only delays the start
+        mediaPlayer.setTime(static_cast<libvlc_time_t>(std::max(time, 0.0) * 1000.0));
+    }
+
+    double VLCPlayer::get_time() {
+        return mediaPlayer.time() / 1000.0;
+    }
+
+    double VLCPlayer::get_length() {
+        return mediaPlayer.length() / 1000.0;
+    }
+
+    void VLCPlayer::set_playbackSpeed(float speed) {
+        mediaPlayer.setRate(speed);
+    }
+
+    bool VLCPlayer::get_isPrepared() const {
+        return prepared;
+    }
+
+    void VLCPlayer::Prepare() {
+        // setMedia stops the previous media, whose vout may be waiting on the main thread
+        CancelFormat();
+        prepared = false;
+        playRequested = false;
+        Post([this, url = url, isLooping = isLooping] {
+            VLC::Media media(instance, url, VLC::Media::FromPath);
+            if(isLooping)
+                media.addOption(":input-repeat=65535");
+            mediaPlayer.setMedia(media);
+            {
+                std::lock_guard<std::mutex> lock(formatMutex);
+                formatState = FormatState::Idle;
+            }
+            // The old media may have displayed a frame until setMedia stopped it
+            prepared = false;
+            // Decode until the first frame is ready, UploadFrame pauses the player again
+            mediaPlayer.play();
+        });
+    }
+
+    void VLCPlayer::Play() {
+        playRequested = true;
+        playStart = std::chrono::steady_clock::now();
+        frames.ResetStats();
+        if(!mediaPlayer.isPlaying())
+            mediaPlayer.play();
+    }
+
+    void VLCPlayer::Pause() {
+        playRequested = false;
+        mediaPlayer.setPause(true);
+    }
+
+    void VLCPlayer::Stop() {
+        if(playRequested) {
+            auto seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - playStart).count();
+            auto stats = frames.get_stats();
+            if(seconds > 0.0f)
+                getLogger().info("VLCPlayer decoded %.2f fps, uploaded %.2f fps, dropped %llu frames, reused %llu slots, peak occupancy %u",
+                    stats.publishedFrames / seconds, stats.presentedFrames / seconds,
+                    (unsigned long long) stats.droppedFrames, (unsigned long long) stats.reusedSlots, stats.peakOccupancy);
+        }
+        playRequested = false;
+        // The vout may be waiting on the main thread for a format change, stop() joins it
+        CancelFormat();
+        prepared = false;
+        Post([this] {
+            mediaPlayer.stop();
+            {
+                std::lock_guard<std::mutex> lock(formatMutex);
+                formatState = FormatState::Idle;
+            }
+            prepared = false;
+        });
+    }
+
+    bool VLCPlayer::UploadFrame() {
+        static auto loadRawTextureData = reinterpret_cast<function_ptr_t<bool, Texture2D*, void*, int>>(il2cpp_functions::resolve_icall("UnityEngine.Texture2D::LoadRawTextureDataImpl"));
+
+        if(formatRequested.load(std::memory_order_acquire))
+            ApplyFormat();
+        if(prepared && !playRequested && mediaPlayer.isPlaying())
+            mediaPlayer.setPause(true);
+        if(!texture)
+            return false;
+
+        auto frame = frames.AcquireLatest();
+        if(!frame)
+            return false;
+        // Unity copies straight out of the slot, which stays untouched until the next AcquireLatest
+        loadRawTextureData(texture, const_cast<uint8_t*>(frame), frames.get_slotSize());
+        texture->Apply(false, false);
+        frames.EndRead();
+        return true;
+    }
+
+    void VLCPlayer::ApplyFormat() {
+        std::lock_guard<std::mutex> lock(formatMutex);
+        if(formatState != FormatState::Requested)
+            return;
+        // The decode thread is blocked in FormatSetup and this thread is outside of AcquireLatest, so neither holds a slot
+        width = requestedWidth;
+        height = requestedHeight;
+        frames.Configure(width * 4, height);
+        // The slots are pitch aligned, the texture covers the whole pitch and the material crops the padding
+        int textureWidth = frames.get_pitch() / 4;
+        // Nothing else references the old texture, it would stay alive until the next unload of unused assets
+        if(texture && (texture->get_width() != textureWidth || texture->get_height() != static_cast<int>(height))) {
+            Object::Destroy(texture);
+            texture = nullptr;
+        }
+        if(!texture)
+            texture = Texture2D::New_ctor(textureWidth, height, TextureFormat::RGBA32, false);
+        if(renderer) {
+            auto material = renderer->get_sharedMaterial();
+            material->set_mainTexture(texture);
+            material->set_mainTextureScale(Vector2(static_cast<float>(width) / textureWidth, 1.0f));
+        }
+        formatState = FormatState::Applied;
+        formatRequested = false;
+        formatApplied.notify_all();
+    }
+
+    uint32_t VLCPlayer::FormatSetup(char* chroma, uint32_t* width, uint32_t* height, uint32_t* pitches, uint32_t* lines) {
+        memcpy(chroma, "RGBA", 4);
+        std::unique_lock<std::mutex> lock(formatMutex);
+        if(formatState == FormatState::Cancelled)
+            return 0;
+        requestedWidth = *width;
+        requestedHeight = *height;
+        formatState = FormatState::Requested;
+        formatRequested.store(true, std::memory_order_release);
+        // Resizing the ring here would free the slot the main thread may be uploading from
+        formatApplied.wait(lock, [this] { return formatState != FormatState::Requested; });
+        if(formatState == FormatState::Cancelled)
+            return 0;
+        pitches[0] = frames.get_pitch();
+        lines[0] = *height;
+        // The vout copies into one locked picture at a time, the ring does the buffering
+        return 1;
+    }
+
+    void* VLCPlayer::Lock(void** planes) {
+        planes[0] = frames.BeginWrite();
+        return nullptr;
+    }
+
+    void VLCPlayer::Display(void* picture) {
+        frames.EndWrite();
+        prepared = true;
+    }
+}
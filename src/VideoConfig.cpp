@@ -0,0 +1,235 @@
+#include "VideoConfig.hpp"
+#include "main.hpp"
+#include "ModInfo.hpp"
+#include "CustomLogger.hpp"
+
+#include "beatsaber-hook/shared/config/rapidjson-utils.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Cinema {
+
+    VideoConfigIndex::Header* VideoConfigIndex::header = nullptr;
+    VideoConfigIndex::Entry* VideoConfigIndex::entries = nullptr;
+    std::size_t VideoConfigIndex::mappedSize = 0;
+    int VideoConfigIndex::fd = -1;
+
+    static int HexValue(char c) {
+        if(c >= '0' && c <= '9') return c - '0';
+        if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    std::optional<VideoConfigIndex::LevelHash> VideoConfigIndex::ParseLevelHash(std::string_view levelId) {
+        static constexpr std::string_view prefix = "custom_level_";
+        if(levelId.starts_with(prefix))
+            levelId.remove_prefix(prefix.size());
+        // WIP levels and duplicates have a suffix after the hash
+        if(levelId.size() < 40)
+            return std::nullopt;
+        LevelHash hash;
+        for(std::size_t i = 0; i < hash.size(); i++) {
+            int high = HexValue(levelId[i * 2]);
+            int low = HexValue(levelId[i * 2 + 1]);
+            if(high < 0 || low < 0)
+                return std::nullopt;
+            hash[i] = (high << 4) | low;
+        }
+        return hash;
+    }
+
+    std::filesystem::path VideoConfigIndex::IndexPath() {
+        return std::filesystem::path(getDataDir(modInfo)) / "videoConfigs.bin";
+    }
+
+    bool VideoConfigIndex::Map(uint32_t capacity) {
+        auto path = IndexPath();
+        std::filesystem::create_directories(path.parent_path());
+        fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if(fd < 0) {
+            LOG_ERROR("Couldn't open %s: %s", path.c_str(), strerror(errno));
+            return false;
+        }
+        Header existing = {};
+        bool valid = pread(fd, &existing, sizeof(Header), 0) == sizeof(Header) && existing.magic == MAGIC && existing.version == VERSION;
+        if(valid)
+            capacity = existing.capacity;
+        mappedSize = sizeof(Header) + capacity * sizeof(Entry);
+        if(!valid && ftruncate(fd, 0) != 0) {
+            close(fd);
+            fd = -1;
+            return false;
+        }
+        if(ftruncate(fd, mappedSize) != 0) {
+            LOG_ERROR("Couldn't resize %s: %s", path.c_str(), strerror(errno));
+            close(fd);
+            fd = -1;
+            return false;
+        }
+        auto memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if(memory == MAP_FAILED) {
+            LOG_ERROR("Couldn't map %s: %s", path.c_str(), strerror(errno));
+            close(fd);
+            fd = -1;
+            return false;
+        }
+        header = reinterpret_cast<Header*>(memory);
+        entries = reinterpret_cast<Entry*>(reinterpret_cast<uint8_t*>(memory) + sizeof(Header));
+        if(!valid)
+            *header = { MAGIC, VERSION, capacity, 0 };
+        return true;
+    }
+
+    void VideoConfigIndex::Unmap() {
+        if(header)
+            munmap(header, mappedSize);
+        if(fd >= 0)
+            close(fd);
+        header = nullptr;
+        entries = nullptr;
+        mappedSize = 0;
+        fd = -1;
+    }
+
+    bool VideoConfigIndex::Grow() {
+        std::vector<Entry> used;
+        used.reserve(header->count);
+        for(uint32_t i = 0; i < header->capacity; i++) {
+            if(entries[i].used)
+                used.emplace_back(entries[i]);
+        }
+        uint32_t capacity = header->capacity * 2;
+        Unmap();
+        std::filesystem::remove(IndexPath());
+        if(!Map(capacity))
+            return false;
+        for(auto& entry : used) {
+            *Find(entry.hash, true) = entry;
+            header->count++;
+        }
+        return true;
+    }
+
+    VideoConfigIndex::Entry* VideoConfigIndex::Find(const LevelHash& hash, bool insert) {
+        if(!header && !Map(INITIAL_CAPACITY))
+            return nullptr;
+        // The hash is a sha1 already, its first bytes are as good as any hash of it
+        uint32_t mask = header->capacity - 1;
+        uint32_t slot;
+        memcpy(&slot, hash.data(), sizeof(slot));
+        for(uint32_t probe = 0; probe < header->capacity; probe++) {
+            auto& entry = entries[(slot + probe) & mask];
+            if(!entry.used)
+                return insert ? &entry : nullptr;
+            if(entry.hash == hash)
+                return &entry;
+        }
+        return nullptr;
+    }
+
+    std::optional<VideoConfig> VideoConfigIndex::Parse(const std::filesystem::path& path) {
+        std::ifstream file(path);
+        if(!file.is_open())
+            return std::nullopt;
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        auto json = buffer.str();
+
+        rapidjson::Document document;
+        document.Parse(json.c_str());
+        if(document.HasParseError() || !document.IsObject()) {
+            LOG_ERROR("Couldn't parse %s", path.c_str());
+            return std::nullopt;
+        }
+
+        VideoConfig config;
+        auto videoId = document.FindMember("videoID");
+        if(videoId == document.MemberEnd() || !videoId->value.IsString())
+            return std::nullopt;
+        // The id becomes a file name on the sdcard, a map must not be able to point it at another path
+        std::string_view id(videoId->value.GetString(), videoId->value.GetStringLength());
+        bool valid = !id.empty() && id.size() < VideoConfig::VIDEO_ID_SIZE && std::all_of(id.begin(), id.end(), [](char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_';
+        });
+        if(!valid) {
+            LOG_ERROR("Invalid videoID in %s", path.c_str());
+            return std::nullopt;
+        }
+        id.copy(config.videoId, id.size());
+
+        auto readFloat = [&document](const char* name, float& value) {
+            auto member = document.FindMember(name);
+            if(member != document.MemberEnd() && member->value.IsNumber())
+                value = member->value.GetFloat();
+        };
+        auto readVector = [&document](const char* name, float (&value)[3]) {
+            auto member = document.FindMember(name);
+            if(member == document.MemberEnd() || !member->value.IsObject())
+                return;
+            const char* axes[] = { "x", "y", "z" };
+            for(int i = 0; i < 3; i++) {
+                auto axis = member->value.FindMember(axes[i]);
+                if(axis != member->value.MemberEnd() && axis->value.IsNumber())
+                    value[i] = axis->value.GetFloat();
+            }
+        };
+        readFloat("offset", config.offset);
+        readFloat("videoStart", config.startTime);
+        readFloat("videoEnd", config.endTime);
+        readVector("screenPosition", config.position);
+        readVector("screenRotation", config.rotation);
+        readVector("screenScale", config.scale);
+        auto loop = document.FindMember("loop");
+        if(loop != document.MemberEnd() && loop->value.IsBool())
+            config.loop = loop->value.GetBool();
+        auto backend = document.FindMember("backend");
+        if(backend != document.MemberEnd() && backend->value.IsString()) {
+            std::string_view name = backend->value.GetString();
+            if(name == "vlc")
+                config.backend = VideoConfig::BACKEND_VLC;
+            else if(name == "unity")
+                config.backend = VideoConfig::BACKEND_UNITY;
+        }
+        return config;
+    }
+
+    void VideoConfigIndex::Update(const LevelHash& hash, const std::filesystem::path& levelPath) {
+        auto path = levelPath / CONFIG_FILE_NAME;
+        struct stat info;
+        int64_t mtime = stat(path.c_str(), &info) == 0 ? info.st_mtime : -1;
+
+        // Most levels have no config, only levels that have or had one are stored so the index doesn't fill up with them
+        auto entry = Find(hash, mtime >= 0);
+        if(!entry)
+            return;
+        if(entry->used && entry->mtime == mtime)
+            return;
+
+        bool added = !entry->used;
+        auto config = mtime >= 0 ? Parse(path) : std::nullopt;
+        entry->hash = hash;
+        entry->mtime = mtime;
+        entry->hasConfig = config.has_value();
+        entry->config = config.value_or(VideoConfig());
+        entry->used = true;
+        if(added && ++header->count * 10 > header->capacity * 7)
+            Grow();
+    }
+
+    std::optional<VideoConfig> VideoConfigIndex::Get(const LevelHash& hash) {
+        auto entry = Find(hash, false);
+        if(!entry || !entry->hasConfig)
+            return std::nullopt;
+        return entry->config;
+    }
+}
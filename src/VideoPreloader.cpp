@@ -0,0 +1,162 @@
+#include "VideoPreloader.hpp"
+
+#include "GlobalNamespace/SharedCoroutineStarter.hpp"
+#include "UnityEngine/GameObject.hpp"
+#include "UnityEngine/Object.hpp"
+
+#include <algorithm>
+
+using namespace UnityEngine;
+
+namespace Cinema {
+
+    Cinema::VideoPlayer* VideoPreloader::unityPlayer = nullptr;
+    std::unique_ptr<VLCPlayer> VideoPreloader::vlcPlayer = nullptr;
+
+    std::string VideoPreloader::selectedLevelId;
+    std::string VideoPreloader::preparedLevelId;
+    std::string VideoPreloader::preparedUrl;
+    VideoBackend VideoPreloader::preparedBackend = VideoBackend::Unity;
+    int VideoPreloader::generation = 0;
+    bool VideoPreloader::firstFrameReady = false;
+    bool VideoPreloader::acquired = false;
+    double VideoPreloader::preparedOffset = 0.0;
+
+    std::optional<std::chrono::steady_clock::time_point> VideoPreloader::songStart = std::nullopt;
+    std::optional<std::chrono::milliseconds> VideoPreloader::lastTimeToFirstFrame = std::nullopt;
+
+    Cinema::VideoPlayer* VideoPreloader::GetUnityPlayer() {
+        if(!unityPlayer) {
+            // Lives outside of the scenes so the prepared video survives the transition into the level
+            auto gameObject = GameObject::New_ctor("CinemaVideoPlayer");
+            Object::DontDestroyOnLoad(gameObject);
+            unityPlayer = gameObject->AddComponent<Cinema::VideoPlayer*>();
+            unityPlayer->set_playOnAwake(false);
+            unityPlayer->set_renderMode(Video::VideoRenderMode::MaterialOverride);
+            unityPlayer->set_audioOutputMode(Video::VideoAudioOutputMode::None);
+            unityPlayer->set_aspectRatio(Video::VideoAspectRatio::FitInside);
+        }
+        return unityPlayer;
+    }
+
+    VLCPlayer* VideoPreloader::GetVLCPlayer() {
+        if(!vlcPlayer)
+            vlcPlayer = std::make_unique<VLCPlayer>();
+        return vlcPlayer.get();
+    }
+
+    bool VideoPreloader::IsPrepared() {
+        if(preparedBackend == VideoBackend::VLC)
+            return vlcPlayer && vlcPlayer->get_isPrepared();
+        return unityPlayer && unityPlayer->get_isPrepared();
+    }
+
+    void VideoPreloader::Preload(std::string_view levelId, VideoBackend backend, std::string_view url, double offset, bool loop) {
+        if(preparedLevelId == levelId && preparedBackend == backend && preparedUrl == url)
+            return;
+        Cancel();
+        Prepare(levelId, backend, url, offset, loop);
+    }
+
+    void VideoPreloader::Cancel() {
+        generation++;
+        preparedLevelId.clear();
+        preparedUrl.clear();
+        firstFrameReady = false;
+        acquired = false;
+        songStart = std::nullopt;
+        if(vlcPlayer)
+            vlcPlayer->Stop();
+        if(unityPlayer)
+            unityPlayer->Stop();
+    }
+
+    VideoPreloader::Players VideoPreloader::Acquire(std::string_view levelId, VideoBackend backend, std::string_view url, double offset, bool loop) {
+        bool warm = preparedLevelId == levelId && preparedBackend == backend && preparedUrl == url;
+        if(!warm) {
+            Cancel();
+            Prepare(levelId, backend, url, offset, loop);
+        } else if(acquired)
+            Rewind(offset);
+        acquired = true;
+        if(firstFrameReady) {
+            lastTimeToFirstFrame = std::chrono::milliseconds::zero();
+            getLogger().info("Time to first frame: 0 ms (preloaded)");
+        } else
+            songStart = std::chrono::steady_clock::now();
+
+        Players players;
+        players.warm = warm;
+        if(backend == VideoBackend::VLC)
+            players.vlc = vlcPlayer.get();
+        else
+            players.unity = unityPlayer;
+        return players;
+    }
+
+    void VideoPreloader::Release() {
+        if(!acquired)
+            return;
+        acquired = false;
+        Rewind(preparedOffset);
+    }
+
+    void VideoPreloader::Rewind(double offset) {
+        generation++;
+        preparedOffset = offset;
+        firstFrameReady = false;
+        songStart = std::nullopt;
+        GlobalNamespace::SharedCoroutineStarter::get_instance()->StartCoroutine(custom_types::Helpers::CoroutineHelper::New(WaitForFirstFrame(generation, offset, true)));
+    }
+
+    void VideoPreloader::Prepare(std::string_view levelId, VideoBackend backend, std::string_view url, double offset, bool loop) {
+        preparedLevelId = levelId;
+        preparedUrl = url;
+        preparedBackend = backend;
+        preparedOffset = offset;
+        firstFrameReady = false;
+        if(backend == VideoBackend::VLC) {
+            auto player = GetVLCPlayer();
+            player->set_isLooping(loop);
+            player->set_url(url);
+            player->Prepare();
+        } else {
+            auto player = GetUnityPlayer();
+            player->set_isLooping(loop);
+            player->set_url(url);
+            player->Prepare();
+        }
+        GlobalNamespace::SharedCoroutineStarter::get_instance()->StartCoroutine(custom_types::Helpers::CoroutineHelper::New(WaitForFirstFrame(generation, offset, false)));
+    }
+
+    custom_types::Helpers::Coroutine VideoPreloader::WaitForFirstFrame(int preloadGeneration, double offset, bool rewind) {
+        auto start = std::chrono::steady_clock::now();
+        while(!IsPrepared()) {
+            if(preloadGeneration != generation)
+                co_return;
+            // Uploading also pauses the VLC player once the first frame arrived
+            if(preparedBackend == VideoBackend::VLC)
+                vlcPlayer->UploadFrame();
+            co_yield nullptr;
+        }
+        if(preloadGeneration != generation)
+            co_return;
+        // Pre-roll to where the video starts relative to the song, a fresh player already is at 0
+        if(offset > 0.0 || rewind) {
+            if(preparedBackend == VideoBackend::VLC)
+                vlcPlayer->set_time(std::max(offset, 0.0));
+            else
+                unityPlayer->set_time(std::max(offset, 0.0));
+        }
+        firstFrameReady = true;
+
+        auto now = std::chrono::steady_clock::now();
+        getLogger().info("%s video for %s in %lld ms", rewind ? "Rewound" : "Prepared", preparedLevelId.c_str(), (long long) std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count());
+        if(songStart.has_value()) {
+            lastTimeToFirstFrame = std::chrono::duration_cast<std::chrono::milliseconds>(now - *songStart);
+            songStart = std::nullopt;
+            getLogger().info("Time to first frame: %lld ms", (long long) lastTimeToFirstFrame->count());
+        }
+        co_return;
+    }
+}
@@ -0,0 +1,79 @@
+#include "VideoSync.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Cinema {
+
+    void SyncController::Reset() {
+        drift = 0.0;
+        hasDrift = false;
+        nudging = false;
+        speed = 1.0f;
+        cooldown = 0.0;
+    }
+
+    SyncController::Correction SyncController::Update(double songTime, double videoTime, double deltaTime) {
+        Correction correction;
+        if(cooldown > 0.0) {
+            cooldown -= deltaTime;
+            return correction;
+        }
+
+        double target = songTime + settings.offset;
+        double length = settings.length;
+        bool looping = settings.loop && length > settings.loopStart;
+        // Before the video starts or after it ended there is nothing to seek to, the player holds its first or last frame
+        if(target < 0.0 || (!looping && length > 0.0 && target > length)) {
+            bool nudged = speed != 1.0f;
+            Reset();
+            if(nudged) {
+                correction.action = Action::SetSpeed;
+                correction.speed = speed;
+            }
+            return correction;
+        }
+        double loopLength = length - settings.loopStart;
+        if(looping && target >= length)
+            target = settings.loopStart + std::fmod(target - settings.loopStart, loopLength);
+        if(length > 0.0)
+            target = std::clamp(target, 0.0, length);
+
+        double sample = videoTime - target;
+        // The video may start over a frame before or after the target does, the drift is the shorter way round
+        if(looping) {
+            if(sample > loopLength / 2.0)
+                sample -= loopLength;
+            else if(sample < -loopLength / 2.0)
+                sample += loopLength;
+        }
+        if(std::abs(sample) > settings.seekThreshold) {
+            Reset();
+            cooldown = settings.seekCooldown;
+            correction.action = Action::Seek;
+            correction.seekTime = target;
+            return correction;
+        }
+
+        drift = hasDrift ? drift + (sample - drift) * settings.smoothing : sample;
+        hasDrift = true;
+
+        double absDrift = std::abs(drift);
+        if(!nudging && absDrift > settings.nudgeThreshold)
+            nudging = true;
+        else if(nudging && absDrift < settings.settleThreshold)
+            nudging = false;
+
+        float newSpeed = 1.0f;
+        if(nudging)
+            newSpeed = 1.0f - std::clamp(static_cast<float>(drift) * settings.nudgeGain, -settings.maxNudge, settings.maxNudge);
+        // Steps of half a percent, decoders don't like their rate changed every frame
+        newSpeed = std::round(newSpeed * 200.0f) / 200.0f;
+        if(newSpeed != speed) {
+            speed = newSpeed;
+            correction.action = Action::SetSpeed;
+            correction.speed = speed;
+        }
+        return correction;
+    }
+}
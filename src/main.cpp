@@ -3,10 +3,14 @@
 #include "GlobalNamespace/AudioTimeSyncController.hpp"
 #include "GlobalNamespace/SharedCoroutineStarter.hpp"
 #include "GlobalNamespace/GamePause.hpp"
+#include "GlobalNamespace/LevelCollectionViewController.hpp"
+#include "GlobalNamespace/LevelCollectionTableView.hpp"
+#include "GlobalNamespace/IPreviewBeatmapLevel.hpp"
+#include "GlobalNamespace/CustomPreviewBeatmapLevel.hpp"
+#include "GlobalNamespace/GameplayCoreInstaller.hpp"
+#include "GlobalNamespace/GameplayCoreSceneSetupData.hpp"
 #include "UnityEngine/GameObject.hpp"
-#include "UnityEngine/PrimitiveType.hpp"
 #include "UnityEngine/Material.hpp"
-#include "UnityEngine/Shader.hpp"
 #include "UnityEngine/Transform.hpp"
 #include "UnityEngine/Vector3.hpp"
 #include "UnityEngine/Quaternion.hpp"
@@ -18,21 +22,22 @@
 #include "UnityEngine/Video/VideoClip.hpp"
 #include "UnityEngine/Video/VideoRenderMode.hpp"
 #include "UnityEngine/Video/VideoPlayer_EventHandler.hpp"
-#include "UnityEngine/Resources.hpp"
 #include "UnityEngine/WaitForSeconds.hpp"
 #include "UnityEngine/MonoBehaviour.hpp"
 #include "UnityEngine/AudioSource.hpp"
+#include "UnityEngine/Time.hpp"
 #include "UI/VideoMenuViewController.hpp"
 #include "questui/shared/QuestUI.hpp"
 #include "questui/shared/CustomTypes/Components/MainThreadScheduler.hpp"
-#include "questui/shared/ArrayUtil.hpp"
 #include "VideoPlayer.hpp"
+#include "VLCPlayer.hpp"
+#include "VideoSync.hpp"
+#include "VideoPreloader.hpp"
+#include "CinemaScreen.hpp"
+#include "VideoConfig.hpp"
 #include "custom-types/shared/coroutine.hpp"
 #include "assets.hpp"
-#include "PythonInternal.hpp"
-#include "CustomLogger.hpp"
-#include "pythonlib/shared/Utils/FileUtils.hpp"
-#include "pythonlib/shared/Utils/StringUtils.hpp"
+#include "DownloadManager.hpp"
 #include "pinkcore/shared/RequirementAPI.hpp"
 
 using namespace UnityEngine;
@@ -62,106 +67,253 @@ extern "C" void setup(ModInfo& info) {
     getLogger().info("Completed setup!");
 }
 
-custom_types::Helpers::Coroutine coroutine(Cinema::VideoPlayer* videoPlayer, AudioSource* audioSource) {
-    while(!audioSource->get_isPlaying()) co_yield nullptr;
-    videoPlayer->set_time(-2040);
-    videoPlayer->Play();
+Cinema::SyncController syncController;
+
+template<typename T>
+custom_types::Helpers::Coroutine coroutine(T* player, AudioTimeSyncController* audioTimeSyncController, Cinema::VideoConfig config) {
+    auto audioSource = audioTimeSyncController->audioSource;
+    while(!audioSource->get_isPlaying()) {
+        if constexpr(std::is_same_v<T, Cinema::VLCPlayer>)
+            player->UploadFrame();
+        co_yield nullptr;
+    }
+    // The player was pre-rolled to the offset, the controller only seeks if it is too far off
+    syncController.Reset();
+    player->Play();
+    while(true) {
+        co_yield nullptr;
+        if constexpr(std::is_same_v<T, Cinema::VLCPlayer>)
+            player->UploadFrame();
+        // Paused, both clocks stand still
+        if(!audioSource->get_isPlaying()) {
+            syncController.Reset();
+            continue;
+        }
+        auto videoTime = player->get_time();
+        // Only known once the player parsed the video, without it the controller can't tell where a loop starts over
+        if(syncController.get_settings().length <= 0.0) {
+            auto length = player->get_length();
+            if(length > 0.0)
+                syncController.set_length(length);
+        }
+        if(config.endTime > 0.0f && videoTime >= config.endTime) {
+            if(!config.loop) {
+                player->Pause();
+                co_return;
+            }
+            player->set_time(config.startTime);
+            syncController.Reset();
+            continue;
+        }
+        auto correction = syncController.Update(audioTimeSyncController->get_songTime(), videoTime, Time::get_deltaTime());
+        switch(correction.action) {
+            case Cinema::SyncController::Action::SetSpeed:
+                player->set_playbackSpeed(correction.speed);
+                break;
+            case Cinema::SyncController::Action::Seek:
+                player->set_playbackSpeed(1.0f);
+                player->set_time(correction.seekTime);
+                break;
+            default:
+                break;
+        }
+    }
     co_return;
 }
 
 Cinema::VideoPlayer* videoPlayer = nullptr;
+Cinema::VLCPlayer* vlcPlayer = nullptr;
+Cinema::VideoBackend videoBackend = Cinema::VideoBackend::Unity;
+
+Cinema::SyncController::Settings GetSyncSettings(const Cinema::VideoConfig& videoConfig) {
+    Cinema::SyncController::Settings settings;
+    auto& config = getConfig().config;
+    auto readDouble = [&config](const char* name, auto& value) {
+        if(config.HasMember(name) && config[name].IsNumber())
+            value = config[name].GetDouble();
+    };
+    // The offset is stored in ms like the offset buttons in the menu, the start trim shifts the whole video
+    settings.offset = videoConfig.offset / 1000.0 + videoConfig.startTime;
+    // Trimmed videos are looped from the start trim by the coroutine, untrimmed ones from 0 by the player itself
+    settings.loop = videoConfig.loop;
+    if(videoConfig.endTime > 0.0f) {
+        settings.loopStart = videoConfig.startTime;
+        settings.length = videoConfig.endTime;
+    }
+    readDouble("syncNudgeThreshold", settings.nudgeThreshold);
+    readDouble("syncSettleThreshold", settings.settleThreshold);
+    readDouble("syncSeekThreshold", settings.seekThreshold);
+    readDouble("syncMaxNudge", settings.maxNudge);
+    return settings;
+}
+
+std::optional<Cinema::VideoConfig> GetVideoConfig(std::string_view levelId) {
+    auto hash = Cinema::VideoConfigIndex::ParseLevelHash(levelId);
+    if(!hash)
+        return std::nullopt;
+    return Cinema::VideoConfigIndex::Get(*hash);
+}
+
+// Downloads are merged into mp4, a format yt-dlp couldn't merge keeps its own extension
+std::string GetVideoUrl(const Cinema::VideoConfig& videoConfig) {
+    auto path = "/sdcard/" + std::string(videoConfig.get_videoId());
+    for(auto extension : { ".mp4", ".webm", ".mkv" }) {
+        if(fileexists(path + extension))
+            return path + extension;
+    }
+    return path + ".mp4";
+}
+
+Cinema::VideoBackend GetVideoBackend(const Cinema::VideoConfig& videoConfig) {
+    // The map's choice wins either way, the mod config only decides for maps that don't make one
+    if(videoConfig.backend == Cinema::VideoConfig::BACKEND_VLC)
+        return Cinema::VideoBackend::VLC;
+    if(videoConfig.backend == Cinema::VideoConfig::BACKEND_UNITY)
+        return Cinema::VideoBackend::Unity;
+    auto& config = getConfig().config;
+    if(config.HasMember("backend") && config["backend"].IsString() && std::string_view(config["backend"].GetString()) == "vlc")
+        return Cinema::VideoBackend::VLC;
+    return Cinema::VideoBackend::Unity;
+}
 
 MAKE_HOOK_MATCH(GamePause_Resume, &GlobalNamespace::GamePause::Resume, void, GamePause* self) {
     GamePause_Resume(self);
-    if(videoPlayer)
+    if(videoBackend == Cinema::VideoBackend::VLC && vlcPlayer)
+        vlcPlayer->Play();
+    else if(videoPlayer)
         videoPlayer->Play();
     getLogger().info("resume");
 }
 
 MAKE_HOOK_MATCH(GamePause_Pause, &GamePause::Pause, void, GamePause* self) {
     GamePause_Pause(self);
-    if(videoPlayer) {
+    if(videoBackend == Cinema::VideoBackend::VLC && vlcPlayer) {
+        vlcPlayer->Pause();
+        getLogger().info("pause");
+    } else if(videoPlayer) {
         videoPlayer->Pause();
         getLogger().info("pause");
     }
 
 }
 
-MAKE_HOOK_MATCH(SetupSongUI, &GlobalNamespace::AudioTimeSyncController::StartSong, void, GlobalNamespace::AudioTimeSyncController* self, float startTimeOffset) {
-    SetupSongUI(self, startTimeOffset);
+MAKE_HOOK_MATCH(AudioTimeSyncController_StopSong, &AudioTimeSyncController::StopSong, void, AudioTimeSyncController* self) {
+    AudioTimeSyncController_StopSong(self);
+    if(vlcPlayer)
+        vlcPlayer->Pause();
+    if(videoPlayer)
+        videoPlayer->Pause();
+    Cinema::VideoPreloader::Release();
+    Cinema::CinemaScreen::Hide();
+}
 
-    GameObject* Mesh = GameObject::CreatePrimitive(PrimitiveType::Plane);
-    auto material = QuestUI::ArrayUtil::Last(Resources::FindObjectsOfTypeAll<Material*>(), [](Material* x) {
-        return x->get_name() == "PyroVideo (Instance)";
+// The level that is actually played, which isn't the selected one for e.g. multiplayer or a level started by another mod
+std::string gameplayLevelId;
+
+MAKE_HOOK_MATCH(GameplayCoreInstaller_InstallBindings, &GameplayCoreInstaller::InstallBindings, void, GameplayCoreInstaller* self) {
+    GameplayCoreInstaller_InstallBindings(self);
+    auto level = self->sceneSetupData ? self->sceneSetupData->previewBeatmapLevel : nullptr;
+    gameplayLevelId = level ? static_cast<std::string>(level->get_levelID()) : "";
+}
+
+std::unordered_map<std::string, int> pendingDownloads;
+
+// Downloads run on the DownloadManager workers, the selected level goes in front of the queue
+void DownloadVideo(const std::string& levelId, const Cinema::VideoConfig& videoConfig) {
+    if(pendingDownloads.contains(levelId))
+        return;
+    std::string url = "https://www.youtube.com/watch?v=" + std::string(videoConfig.get_videoId());
+    // Completions run on the main thread after the id is set, a cancelled download may already have been queued again
+    auto id = std::make_shared<int>(-1);
+    *id = Cinema::DownloadManager::Enqueue(url, 1, [levelId](const Cinema::DownloadManager::Progress& progress) {
+        getLogger().info("Download %s: %f%% %f/%f bytes %f B/s eta %f s", levelId.c_str(), progress.percentage, progress.downloadedBytes, progress.totalBytes, progress.speed, progress.eta);
+    }, [levelId, id](Cinema::DownloadManager::Status status) {
+        if(auto itr = pendingDownloads.find(levelId); itr != pendingDownloads.end() && itr->second == *id)
+            pendingDownloads.erase(itr);
+        getLogger().info("Download %s finished with status %d", levelId.c_str(), static_cast<int>(status));
+        if(status != Cinema::DownloadManager::Status::Finished || Cinema::VideoPreloader::get_selectedLevelId() != levelId)
+            return;
+        if(auto videoConfig = GetVideoConfig(levelId))
+            Cinema::VideoPreloader::Preload(levelId, GetVideoBackend(*videoConfig), GetVideoUrl(*videoConfig), GetSyncSettings(*videoConfig).offset, videoConfig->loop);
     });
-    if(material)
-        Mesh->GetComponent<Renderer*>()->set_material(material);
-    else
-        Mesh->GetComponent<Renderer*>()->set_material(Material::New_ctor(Shader::Find(il2cpp_utils::newcsstr("Unlit/Texture"))));
-    Mesh->get_transform()->set_position(Vector3{0.0f, 12.4f, 67.8f});
-    Mesh->get_transform()->set_rotation(Quaternion::Euler(90.0f, 270.0f, 90.0f));
-    Mesh->get_transform()->set_localScale(Vector3(5.11, 1, 3));
-
-    auto cinemaScreen = Mesh->GetComponent<Renderer*>();
-
-    videoPlayer = Mesh->AddComponent<Cinema::VideoPlayer*>();
-    videoPlayer->set_isLooping(true);
-    videoPlayer->set_playOnAwake(false);
-    videoPlayer->set_renderMode(Video::VideoRenderMode::MaterialOverride);
-    videoPlayer->set_audioOutputMode(Video::VideoAudioOutputMode::None);
-    videoPlayer->set_aspectRatio(Video::VideoAspectRatio::FitInside);
-    if(cinemaScreen)
-        videoPlayer->set_renderer(cinemaScreen);
-    videoPlayer->set_url("/sdcard/EaswWiwMVs8.mp4");
+    pendingDownloads[levelId] = *id;
+}
 
-    videoPlayer->Prepare();
+// Only the selected level is worth downloading, the others would hold up the queue
+void CancelDownloads(std::string_view selectedLevelId = "") {
+    for(auto itr = pendingDownloads.begin(); itr != pendingDownloads.end();) {
+        if(itr->first == selectedLevelId) {
+            itr++;
+            continue;
+        }
+        Cinema::DownloadManager::Cancel(itr->second);
+        itr = pendingDownloads.erase(itr);
+    }
+}
+
+MAKE_HOOK_MATCH(LevelCollectionViewController_HandleLevelCollectionTableViewDidSelectLevel, &LevelCollectionViewController::HandleLevelCollectionTableViewDidSelectLevel, void, LevelCollectionViewController* self, LevelCollectionTableView* tableView, IPreviewBeatmapLevel* level) {
+    LevelCollectionViewController_HandleLevelCollectionTableViewDidSelectLevel(self, tableView, level);
+    if(!level) {
+        Cinema::VideoPreloader::Cancel();
+        CancelDownloads();
+        return;
+    }
+    Cinema::CinemaScreen::Hide();
+    std::string levelId = level->get_levelID();
+    CancelDownloads(levelId);
+    Cinema::VideoPreloader::set_selectedLevelId(levelId);
 
-    GlobalNamespace::SharedCoroutineStarter::get_instance()->StartCoroutine(custom_types::Helpers::CoroutineHelper::New(coroutine(videoPlayer, self->audioSource)));
+    // Only stats the json, it is parsed again only if it changed since it was indexed
+    auto hash = Cinema::VideoConfigIndex::ParseLevelHash(levelId);
+    if(auto customLevel = il2cpp_utils::try_cast<CustomPreviewBeatmapLevel>(level); hash && customLevel)
+        Cinema::VideoConfigIndex::Update(*hash, static_cast<std::string>(customLevel.value()->get_customLevelPath()));
 
-	PinkCore::RequirementAPI::RegisterInstalled("Cinema");
+    auto videoConfig = GetVideoConfig(levelId);
+    if(!videoConfig) {
+        Cinema::VideoPreloader::Cancel();
+        return;
+    }
+    auto url = GetVideoUrl(*videoConfig);
+    if(!fileexists(url)) {
+        Cinema::VideoPreloader::Cancel();
+        DownloadVideo(levelId, *videoConfig);
+        return;
+    }
+    Cinema::VideoPreloader::Preload(levelId, GetVideoBackend(*videoConfig), url, GetSyncSettings(*videoConfig).offset, videoConfig->loop);
 }
 
-#include "pythonlib/shared/Utils/FileUtils.hpp"
-#include "pythonlib/shared/Utils/StringUtils.hpp"
-#include "assets.hpp"
+MAKE_HOOK_MATCH(SetupSongUI, &GlobalNamespace::AudioTimeSyncController::StartSong, void, GlobalNamespace::AudioTimeSyncController* self, float startTimeOffset) {
+    SetupSongUI(self, startTimeOffset);
+	PinkCore::RequirementAPI::RegisterInstalled("Cinema");
 
-bool DownloadVideo(std::string_view url, std::function<void(float)> status = nullptr) {
-    bool error = false;
-    std::function<void(int, char*)> eventHandler = [status, &error](int type, char* data) {
-        switch (type) {
-        case 0:
-            {
-                std::string dataString(data);
-                if(dataString.find("[download]", 0) != -1) {
-                    auto pos = dataString.find("%", 0);
-                    if(pos != -1 && pos > 5) {
-                        auto percentange = dataString.substr(pos-5, 5);
-                        if(percentange.find("]", 0) == 0) 
-                            percentange = percentange.substr(1);
-                        status(std::stof(percentange));
-                    }
-                }
-            }
-            break;
-        case 1:
-            error = true;
-            getLogger().info("Error: %s", data);
-            break;
-        }
-    };
-    Python::PythonWriteEvent += eventHandler;
-    std::string ytdlp = FileUtils::getScriptsPath() + "/yt_dlp";
-    if(!direxists(ytdlp))
-        FileUtils::ExtractZip(IncludedAssets::ytdlp_zip, ytdlp);
-    Python::PyRun_SimpleString("from yt_dlp.__init__ import _real_main");
-    std::string command = "_real_main([";
-    for(auto splitted : StringUtils::Split("--no-cache-dir -o %(id)s.%(ext)s -P /sdcard " + url, " ")) {
-        command += "\"" + splitted + "\",";
+    auto& levelId = gameplayLevelId;
+    auto videoConfig = GetVideoConfig(levelId);
+    if(!videoConfig) {
+        videoPlayer = nullptr;
+        vlcPlayer = nullptr;
+        return;
+    }
+
+    auto& position = videoConfig->position;
+    auto& rotation = videoConfig->rotation;
+    auto& scale = videoConfig->scale;
+    auto cinemaScreen = Cinema::CinemaScreen::Show(Vector3(position[0], position[1], position[2]), Vector3(rotation[0], rotation[1], rotation[2]), Vector3(scale[0], scale[1], scale[2]));
+
+    videoBackend = GetVideoBackend(*videoConfig);
+    auto syncSettings = GetSyncSettings(*videoConfig);
+    syncController = Cinema::SyncController(syncSettings);
+    auto players = Cinema::VideoPreloader::Acquire(levelId, videoBackend, GetVideoUrl(*videoConfig), syncSettings.offset, videoConfig->loop);
+    videoPlayer = players.unity;
+    vlcPlayer = players.vlc;
+
+    // Started on the AudioTimeSyncController so the loop ends with the gameplay scene
+    if(vlcPlayer) {
+        vlcPlayer->set_renderer(cinemaScreen);
+        self->StartCoroutine(custom_types::Helpers::CoroutineHelper::New(coroutine(vlcPlayer, self, *videoConfig)));
+    } else {
+        videoPlayer->set_renderer(cinemaScreen);
+        self->StartCoroutine(custom_types::Helpers::CoroutineHelper::New(coroutine(videoPlayer, self, *videoConfig)));
     }
-    command = command.substr(0, command.length()-1) + "])";
-    int result = Python::PyRun_SimpleString(command.c_str());
-    Python::PythonWriteEvent -= eventHandler;
-    return !error;
 }
 
 // Called later on in the game loading - a good time to install function hooks
@@ -171,14 +323,11 @@ extern "C" void load() {
     INSTALL_HOOK(getLogger(), SetupSongUI);
     INSTALL_HOOK(getLogger(), GamePause_Resume);
     INSTALL_HOOK(getLogger(), GamePause_Pause);
+    INSTALL_HOOK(getLogger(), AudioTimeSyncController_StopSong);
+    INSTALL_HOOK(getLogger(), GameplayCoreInstaller_InstallBindings);
+    INSTALL_HOOK(getLogger(), LevelCollectionViewController_HandleLevelCollectionTableViewDidSelectLevel);
 
     QuestUI::Register::RegisterGameplaySetupMenu<Cinema::VideoMenuViewController*>(modInfo, "Cinema", QuestUI::Register::MenuType::Solo);
 
 	custom_types::Register::AutoRegister();
-    getLogger().info("DownloadVideo Result: %d", DownloadVideo("", [](float percentage) {
-        getLogger().info("Download: %f", percentage);
-    }));
-    getLogger().info("DownloadVideo Result: %d", DownloadVideo("", [](float percentage) {
-        getLogger().info("Download: %f", percentage);
-    }));
 }
@@ -0,0 +1,144 @@
+#include "AssetImporter.hpp"
+#include "PythonInternal.hpp"
+#include "PythonSymbols.hpp"
+#include "Utils/FileUtils.hpp"
+#include "ModInfo.hpp"
+#include "CustomLogger.hpp"
+#include "Check.hpp"
+#include "ZipTestUtils.hpp"
+
+#include <cstdio>
+#include <dlfcn.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+ModInfo modInfo = { "AssetImporterTest", "0.0.0" };
+
+Logger& getLogger() {
+    static Logger logger;
+    return logger;
+}
+
+// The same expansions as Downloader.cpp, bound to the libpython of the host
+namespace Python {
+    #define DEFINE_PYTHON_FUNCTION(binding, retval, name, ...) DEFINE_DLSYM(retval, name, __VA_ARGS__)
+    #define DEFINE_PYTHON_TYPE(binding, name) DEFINE_DLSYM_TYPE(name)
+    PYTHON_SYMBOLS(DEFINE_PYTHON_FUNCTION, DEFINE_PYTHON_TYPE)
+
+    #define BIND_PYTHON_FUNCTION(binding, retval, name, ...) DLSYM_##binding(name),
+    #define BIND_PYTHON_TYPE(binding, name) DLSYM_##binding(name),
+    static const DlsymBinding dlsymBindings[] = {
+        PYTHON_SYMBOLS(BIND_PYTHON_FUNCTION, BIND_PYTHON_TYPE)
+    };
+
+    PyObject* Py_None;
+
+    void AddNativeModule(PyModuleDef& def) {
+        PyObject* module = PyModule_Create2(&def, 3);
+        PyObject* sys_modules = PyImport_GetModuleDict();
+        PyDict_SetItemString(sys_modules, def.m_name, module);
+        Py_DecRef(module);
+    }
+}
+
+static constexpr const int MODULE_COUNT = 80;
+
+/// A package of pure Python modules the size of the json or email packages, importing each other relatively
+static std::vector<ZipFile> MakePackage() {
+    std::vector<ZipFile> files;
+    std::string init = "\"\"\"Benchmark package\"\"\"\nfrom .sub import deep\n";
+    for(int i = 0; i < MODULE_COUNT; i++) {
+        init += "from . import mod" + std::to_string(i) + "\n";
+        std::string source = "\"\"\"Module " + std::to_string(i) + "\"\"\"\n";
+        if(i > 0)
+            source += "from . import mod" + std::to_string(i - 1) + " as previous\n";
+        source += "CONSTANT = " + std::to_string(i) + "\n";
+        for(int function = 0; function < 40; function++) {
+            source += "\ndef function" + std::to_string(function) + "(value, *args, **kwargs):\n"
+                "    if value is None:\n"
+                "        return [CONSTANT + " + std::to_string(function) + " for _ in args]\n"
+                "    return {'value': value, 'kwargs': kwargs, 'total': sum(args) + CONSTANT}\n";
+        }
+        source += "\nclass Thing:\n    def __init__(self, value):\n        self.value = value\n    def __repr__(self):\n        return 'Thing(%r)' % self.value\n";
+        files.push_back({ "bench/mod" + std::to_string(i) + ".py", source });
+    }
+    files.push_back({ "bench/__init__.py", init });
+    files.push_back({ "bench/sub/__init__.py", "" });
+    files.push_back({ "bench/sub/deep.py", "def fail():\n    raise ValueError('deep failure')\n" });
+    return files;
+}
+
+/// Times both imports and checks the modules of the importer look like the ones on disk, gets root and module_count
+static const char* const SCRIPT = R"python(
+import sys, os, time, importlib, linecache, traceback
+# Both compile from source every time, the extracted tree has no bytecode of the host interpreter either
+sys.dont_write_bytecode = True
+sys.path.insert(0, root)
+
+def purge(name):
+    for module in [module for module in sys.modules if module == name or module.startswith(name + '.')]:
+        del sys.modules[module]
+
+def timed(name):
+    purge(name)
+    importlib.invalidate_caches()
+    start = time.perf_counter()
+    importlib.import_module(name)
+    return (time.perf_counter() - start) * 1000
+
+first = { name: timed(name) for name in ('zipped', 'bench') }
+median = { name: sorted(timed(name) for _ in range(21))[10] for name in ('zipped', 'bench') }
+print('%d modules: embedded zip %.1f ms first, %.1f ms median; extracted tree %.1f ms first, %.1f ms median' %
+    (module_count + 3, first['zipped'], median['zipped'], first['bench'], median['bench']), flush=True)
+
+import zipped, bench
+# __file__ and __path__ point at the extracted tree, as if the modules were loaded from there
+assert zipped.__spec__.has_location and zipped.__file__ == root + '/bench/__init__.py' == bench.__file__, zipped.__file__
+assert zipped.mod7.__file__ == bench.mod7.__file__ and zipped.__path__ == [root + '/bench']
+assert zipped.__loader__.is_package('zipped') and not zipped.mod7.__loader__.is_package('zipped.mod7')
+assert zipped.mod7.__loader__.get_filename('zipped.mod7') == zipped.mod7.__file__
+with open(bench.mod7.__file__) as file:
+    assert zipped.mod7.__loader__.get_source('zipped.mod7') == file.read()
+assert zipped.mod7.__loader__.get_code('zipped.mod7').co_filename == zipped.mod7.__file__
+assert zipped.mod7.previous is zipped.mod6 and zipped.mod7.Thing(1).value == 1
+
+# Tracebacks of modules that were never extracted read their lines through get_source
+os.remove(zipped.sub.deep.__file__)
+linecache.clearcache()
+try:
+    zipped.sub.deep.fail()
+except ValueError as error:
+    frame = traceback.extract_tb(error.__traceback__)[-1]
+assert frame.filename == zipped.sub.deep.__file__ and frame.line == "raise ValueError('deep failure')", frame
+)python";
+
+int main() {
+    using namespace Python;
+    auto libpython = dlopen(PYTHON_LIBRARY, RTLD_NOW | RTLD_GLOBAL);
+    CHECK(libpython);
+    Py_None = reinterpret_cast<PyObject*>(dlsym(libpython, "_Py_NoneStruct"));
+    for(auto& binding : dlsymBindings)
+        *binding.address = dlsym(libpython, binding.name);
+    CHECK(Py_None && Py_InitializeEx);
+
+    // The importer serves the zip, the same zip extracted is what the path finder would load otherwise
+    auto root = fs::temp_directory_path() / "cinema_tests" / "AssetImporterTest";
+    fs::remove_all(root);
+    auto zip = MakeZip(MakePackage());
+    CHECK(FileUtils::ExtractZip(zip, root.string()) == 0);
+    Cinema::AssetImporter::Register(zip, "bench/", "zipped", root.string());
+
+    Py_InitializeEx(0);
+    Cinema::AssetImporter::Install();
+    CHECK(PyRun_SimpleString(("root = '" + root.string() + "'\n"
+        "module_count = " + std::to_string(MODULE_COUNT) + "\n").c_str()) == 0);
+    CHECK(PyRun_SimpleString(SCRIPT) == 0);
+    fs::remove_all(root);
+    std::printf("AssetImporter OK\n");
+    std::fflush(stdout);
+    // Finalizing the host interpreter isn't what is tested here
+    std::quick_exit(0);
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+
+// Unlike assert this stays on in release builds, the benchmarks need optimizations
+#define CHECK(condition) \
+do { \
+    if(!(condition)) { \
+        std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+        std::abort(); \
+    } \
+} while(0)
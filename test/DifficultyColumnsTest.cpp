@@ -0,0 +1,86 @@
+#include "SongDetailsTestUtils.hpp"
+
+#include <cmath>
+
+using DifficultyColumns = SongDetailsTestAccess::DifficultyColumns;
+
+static void CheckSame(const DifficultyColumns& a, const DifficultyColumns& b) {
+    CHECK(a.size == b.size && a.songIndex == b.songIndex && a.starsT100 == b.starsT100 && a.njsT100 == b.njsT100);
+    CHECK(a.notes == b.notes && a.bombs == b.bombs && a.obstacles == b.obstacles);
+    CHECK(a.characteristic == b.characteristic && a.difficulty == b.difficulty && a.mods == b.mods);
+}
+
+/// Songs whose difficulties have stars in [min, max], compared as floats like a DifficultyFilterFunction would
+static std::vector<std::size_t> Scan(const std::vector<SongDifficulty>& difficulties, float min, float max) {
+    std::vector<std::size_t> l;
+    for (std::size_t i = 0, last = std::numeric_limits<uint32_t>::max(); i < difficulties.size(); i++) {
+        auto& cur = difficulties[i];
+        if (last == cur.songIndex || cur.stars < min || cur.stars > max)
+            continue;
+        last = l.emplace_back(cur.songIndex);
+    }
+    return l;
+}
+
+int main() {
+    ResetCache("DifficultyColumnsTest");
+
+    // Every hundredth up to the 16 bit limit once, plus a few the columns have to saturate
+    auto database = MakeDatabase(0);
+    std::mt19937 rng(9);
+    for (uint32_t value = 0; value <= UINT16_MAX + 10;) {
+        auto song = database.add_songs();
+        FillSong(song, database.songs_size(), rng);
+        song->set_rankedstate(1);
+        for (auto& diff : *song->mutable_difficulties())
+            diff.set_starst100(value++);
+    }
+    SongDetailsTestAccess::Process(database, true);
+    auto state = SongDetailsTestAccess::get_state();
+    const auto& difficulties = *state->columns.difficulties;
+    const auto& columns = *state->columns.difficultyColumns;
+    CHECK(columns.size == difficulties.size() && columns.songIndex.size() % DifficultyColumns::BLOCK_SIZE == 0);
+    for (std::size_t i = 0; i < difficulties.size(); i++) {
+        const auto& diff = difficulties[i];
+        CHECK(columns.songIndex[i] == diff.songIndex && columns.notes[i] == diff.notes && columns.bombs[i] == diff.bombs && columns.obstacles[i] == diff.obstacles);
+        CHECK(columns.characteristic[i] == static_cast<uint8_t>(diff.characteristic) && columns.difficulty[i] == static_cast<uint8_t>(diff.difficulty));
+        CHECK(columns.mods[i] == static_cast<uint8_t>(diff.mods) && columns.get_njs(i) == diff.njs);
+        CHECK(columns.starsT100[i] == std::min<std::size_t>(i, UINT16_MAX));
+        if (i <= UINT16_MAX)
+            CHECK(columns.get_stars(i) == diff.stars);
+    }
+    // The padding never matches, not even a query for zero
+    for (std::size_t i = columns.size; i < columns.songIndex.size(); i++)
+        CHECK(columns.starsT100[i] == 0 && columns.songIndex[i] == 0);
+
+    // Bounds right on a hundredth, just next to one, between two and outside of what the columns hold
+    std::vector<float> bounds = { -1.0f, 0.0f, 0.01f, 655.34f, 655.35f, 655.36f, 700.0f, INFINITY, -INFINITY };
+    for (int i = 0; i < 300; i++) {
+        float hundredth = (rng() % (UINT16_MAX + 1)) / 100.0f;
+        bounds.insert(bounds.end(), { hundredth, std::nextafter(hundredth, -INFINITY), std::nextafter(hundredth, INFINITY), hundredth + 0.005f });
+    }
+    for (std::size_t i = 0; i + 1 < bounds.size(); i += 2) {
+        float min = std::min(bounds[i], bounds[i + 1]), max = std::max(bounds[i], bounds[i + 1]);
+        for (auto [queryMin, queryMax] : { std::pair{ min, max }, std::pair{ min, min }, std::pair{ max, max }, std::pair{ max, min } }) {
+            DifficultyQuery query;
+            query.stars = { queryMin, queryMax };
+            // Stars from 655.35 up all saturate to the same column value, a bound among them can't tell them apart
+            if ((queryMax >= 655.35f && queryMax != INFINITY) || queryMin > 655.35f)
+                continue;
+            CHECK(SongDetailsContainer::FindSongIndexes(query) == Scan(difficulties, queryMin, queryMax));
+        }
+    }
+
+    DifficultyQuery saturated;
+    saturated.stars = { 655.35f, 655.35f };
+    CHECK(SongDetailsContainer::FindSongIndexes(saturated) == Scan(difficulties, 655.35f, INFINITY));
+
+    // The snapshot keeps the same layout, mapping it gives the same columns
+    CHECK(SongDetailsSnapshot::Write(SongDetailsSnapshot::path()));
+    auto snapshot = SongDetailsSnapshot::Open(SongDetailsSnapshot::path());
+    CHECK(snapshot);
+    CheckSame(columns, DifficultyColumns(*snapshot));
+    CheckSame(columns, DifficultyColumns(difficulties));
+    std::printf("%zu difficulties in %zu KB of columns, %zu KB as SongDifficulty\n", columns.size, columns.get_byteSize() / 1024, difficulties.size() * sizeof(SongDifficulty) / 1024);
+    std::printf("DifficultyColumns OK\n");
+}
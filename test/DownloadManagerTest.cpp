@@ -0,0 +1,360 @@
+#include "DownloadManager.hpp"
+#include "PythonWorker.hpp"
+#include "main.hpp"
+#include "PythonInternal.hpp"
+#include "PythonSymbols.hpp"
+#include "Check.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "questui/shared/CustomTypes/Components/MainThreadScheduler.hpp"
+
+using namespace Cinema;
+using namespace std::chrono_literals;
+using Status = DownloadManager::Status;
+
+Logger& getLogger() {
+    static Logger logger;
+    return logger;
+}
+
+// Every pointer is defined like in Downloader.cpp, the few the download queue calls are pointed at the fake interpreter below
+namespace Python {
+    UnorderedEventCallback<int, char*> PythonWriteEvent;
+    PyObject* Py_None;
+
+    #define DEFINE_PYTHON_FUNCTION(binding, retval, name, ...) DEFINE_DLSYM(retval, name, __VA_ARGS__)
+    #define DEFINE_PYTHON_TYPE(binding, name) DEFINE_DLSYM_TYPE(name)
+    PYTHON_SYMBOLS(DEFINE_PYTHON_FUNCTION, DEFINE_PYTHON_TYPE)
+
+    PyMethodDef* nativeMethods = nullptr;
+
+    void AddNativeModule(PyModuleDef& def) {
+        nativeMethods = def.m_methods;
+    }
+}
+
+/// Stands in for libpython and the PythonWorker thread, one command at a time with the GIL held like yt-dlp
+/// A script is what yt-dlp does for its url, it returns the exit code
+namespace Interpreter {
+    using Script = std::function<int()>;
+
+    std::mutex gil;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<PythonWorker::Command> commands;
+    std::map<std::string, Script> scripts;
+    std::vector<std::string> ran;
+    std::vector<std::pair<std::string, std::string>> options;
+    Python::PyObject cancelledException;
+    Python::PyObject none;
+    std::atomic<bool> interrupted = false;
+    std::thread::id interruptedFrom;
+
+    /// Holds the GIL for a while like a long running bytecode stretch, false once a cancellation was raised
+    bool Work(std::chrono::milliseconds time) {
+        std::this_thread::sleep_for(time);
+        if(interrupted.exchange(false))
+            return false;
+        // Lets a thread waiting in PyGILState_Ensure in, like the eval loop's switch interval does
+        gil.unlock();
+        std::this_thread::sleep_for(1ms);
+        gil.lock();
+        return !interrupted.exchange(false);
+    }
+
+    void Print(int type, std::string line) {
+        Python::PythonWriteEvent.invoke(type, line.data());
+    }
+
+    /// Calls cinema.progress like the hook RegisterProgressModule patches into yt-dlp
+    void Progress(double downloaded, double total) {
+        double args[4] = { downloaded, total, 1000.0, 1.0 };
+        CHECK(Python::nativeMethods && Python::nativeMethods[0].ml_meth(nullptr, reinterpret_cast<Python::PyObject*>(args)) == &none);
+    }
+
+    void Loop() {
+        while(true) {
+            PythonWorker::Command command;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [] { return !commands.empty(); });
+                command = std::move(commands.front());
+                commands.pop_front();
+            }
+            std::lock_guard<std::mutex> lock(gil);
+            if(!command.started()) {
+                command.finished(-1);
+                continue;
+            }
+            Script script;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ran.emplace_back(command.url);
+                options = command.options;
+                script = scripts.at(command.url);
+            }
+            command.finished(script());
+        }
+    }
+
+    /// Reads the four doubles Progress packs in place of a tuple
+    int ParseTuple(Python::PyObject* args, const char* format, ...) {
+        CHECK(std::string_view(format) == "dddd");
+        auto values = reinterpret_cast<double*>(args);
+        std::va_list list;
+        va_start(list, format);
+        for(int i = 0; i < 4; i++)
+            *va_arg(list, double*) = values[i];
+        va_end(list);
+        return 1;
+    }
+
+    void Start() {
+        using namespace Python;
+        Py_None = &none;
+        Py_IncRef = [](PyObject*) {};
+        PyRun_SimpleString = [](const char*) { return 0; };
+        PyErr_NewException = [](const char*, PyObject*, PyObject*) { return &cancelledException; };
+        PyThread_get_thread_ident = [] { return static_cast<unsigned long>(std::hash<std::thread::id>()(std::this_thread::get_id()) | 1); };
+        PyGILState_Ensure = [] {
+            gil.lock();
+            return PyGILState_LOCKED;
+        };
+        PyGILState_Release = [](PyGILState_STATE) { gil.unlock(); };
+        PyThreadState_SetAsyncExc = [](unsigned long, PyObject* exception) {
+            CHECK(exception == &cancelledException);
+            interruptedFrom = std::this_thread::get_id();
+            interrupted = true;
+            return 1;
+        };
+        PyArg_ParseTuple = ParseTuple;
+        std::thread(Loop).detach();
+    }
+
+    std::vector<std::string> Ran() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ran;
+    }
+}
+
+namespace Cinema {
+    void PythonWorker::Submit(Command command) {
+        {
+            std::lock_guard<std::mutex> lock(Interpreter::mutex);
+            Interpreter::commands.emplace_back(std::move(command));
+        }
+        Interpreter::condition.notify_one();
+    }
+}
+
+/// Plays the Unity main thread until the condition holds
+template<typename Condition>
+static void RunMainThread(Condition condition, std::chrono::seconds timeout = 10s) {
+    auto end = std::chrono::steady_clock::now() + timeout;
+    while(!condition()) {
+        CHECK(std::chrono::steady_clock::now() < end);
+        QuestUI::MainThreadScheduler::RunQueued();
+        std::this_thread::sleep_for(1ms);
+    }
+    QuestUI::MainThreadScheduler::RunQueued();
+}
+
+struct Download {
+    int id = -1;
+    std::optional<Status> status;
+    std::vector<DownloadManager::Progress> progress;
+
+    void Enqueue(const std::string& url, int priority = 0) {
+        id = DownloadManager::Enqueue(url, priority, [this](auto& update) { progress.emplace_back(update); }, [this](Status result) {
+            CHECK(!status);
+            status = result;
+        });
+    }
+
+    Status Wait() {
+        RunMainThread([this] { return status.has_value(); });
+        return *status;
+    }
+};
+
+int main() {
+    Interpreter::Start();
+    DownloadManager::set_maxRetries(0);
+
+    // Higher priorities first, the same priority in the order they came in, a cancelled one never reaches the interpreter
+    {
+        std::atomic<bool> open = false;
+        Interpreter::scripts["gate"] = [&] {
+            while(!open)
+                Interpreter::Work(1ms);
+            return 0;
+        };
+        for(auto url : { "low", "high", "high again", "middle", "cancelled" })
+            Interpreter::scripts[url] = [] { return 0; };
+        Download gate, low, high, highAgain, middle, cancelled;
+        gate.Enqueue("gate");
+        RunMainThread([] { return Interpreter::Ran().size() == 1; });
+        low.Enqueue("low", 0);
+        high.Enqueue("high", 2);
+        cancelled.Enqueue("cancelled", 3);
+        middle.Enqueue("middle", 1);
+        highAgain.Enqueue("high again", 2);
+        CHECK(DownloadManager::GetStatus(low.id) == Status::Queued && DownloadManager::GetStatus(gate.id) == Status::Downloading);
+        CHECK(DownloadManager::Cancel(cancelled.id) && !DownloadManager::Cancel(cancelled.id));
+        CHECK(cancelled.Wait() == Status::Cancelled);
+        open = true;
+        for(auto download : { &gate, &low, &high, &highAgain, &middle })
+            CHECK(download->Wait() == Status::Finished);
+        CHECK(Interpreter::Ran() == std::vector<std::string>({ "gate", "high", "high again", "middle", "low" }));
+        CHECK(!DownloadManager::Cancel(low.id));
+    }
+
+    // Separate video and audio streams end up in the <id>.mp4 the game looks for
+    {
+        auto& options = Interpreter::options;
+        CHECK(std::find(options.begin(), options.end(), std::pair<std::string, std::string>("--merge-output-format", "mp4")) != options.end());
+        CHECK(std::find(options.begin(), options.end(), std::pair<std::string, std::string>("-o", "%(id)s.%(ext)s")) != options.end());
+    }
+
+    // Cancelling while yt-dlp holds the GIL returns right away, the worker raises in the interpreter once it gets the GIL
+    {
+        std::atomic<bool> running = false;
+        std::atomic<int> stretches = 0;
+        Interpreter::scripts["long"] = [&] {
+            running = true;
+            while(stretches++ < 100) {
+                if(!Interpreter::Work(300ms))
+                    return -1;
+            }
+            return 0;
+        };
+        Download download;
+        download.Enqueue("long");
+        RunMainThread([&] { return running.load(); });
+        std::this_thread::sleep_for(50ms);
+        auto start = std::chrono::steady_clock::now();
+        CHECK(DownloadManager::Cancel(download.id));
+        auto cancelTime = std::chrono::steady_clock::now() - start;
+        CHECK(cancelTime < 50ms);
+        CHECK(download.Wait() == Status::Cancelled);
+        CHECK(stretches < 5 && Interpreter::interruptedFrom != std::this_thread::get_id());
+        std::printf("Cancel returned in %lld us while the GIL was held\n", (long long) std::chrono::duration_cast<std::chrono::microseconds>(cancelTime).count());
+    }
+
+    // A failed download is retried after the backoff, an error line fails it even with exit code 0
+    {
+        int attempts = 0;
+        Interpreter::scripts["flaky"] = [&] { return attempts++ == 0 ? 1 : 0; };
+        Interpreter::scripts["failing"] = [] { return 1; };
+        Interpreter::scripts["error"] = [] {
+            Interpreter::Print(1, "ERROR: Video unavailable");
+            return 0;
+        };
+        DownloadManager::set_maxRetries(1);
+        Download flaky;
+        auto start = std::chrono::steady_clock::now();
+        flaky.Enqueue("flaky");
+        CHECK(flaky.Wait() == Status::Finished && attempts == 2);
+        CHECK(std::chrono::steady_clock::now() - start >= 2s);
+        DownloadManager::set_maxRetries(0);
+        Download failing, error;
+        failing.Enqueue("failing");
+        error.Enqueue("error");
+        CHECK(failing.Wait() == Status::Failed && error.Wait() == Status::Failed);
+    }
+    // While the size is unknown the percentage stays at 0, updates still go out at most every PROGRESS_INTERVAL
+    {
+        Interpreter::scripts["unknown size"] = [] {
+            for(int i = 1; i <= 50; i++) {
+                Interpreter::Progress(i * 1000.0, 0.0);
+                std::this_thread::sleep_for(20ms);
+            }
+            return 0;
+        };
+        Download download;
+        download.Enqueue("unknown size");
+        CHECK(download.Wait() == Status::Finished);
+        CHECK(download.progress.size() >= 2);
+        CHECK(download.progress[0].downloadedBytes == 1000.0 && download.progress[0].percentage == 0.0f);
+        for(std::size_t i = 1; i < download.progress.size(); i++)
+            CHECK(download.progress[i].downloadedBytes >= download.progress[i - 1].downloadedBytes + 10000.0);
+    }
+
+    // A fast download only sends a few updates, the last one is always delivered
+    {
+        Interpreter::scripts["fast"] = [] {
+            for(int i = 1; i <= 1000; i++)
+                Interpreter::Progress(i, 1000.0);
+            return 0;
+        };
+        Download download;
+        download.Enqueue("fast");
+        CHECK(download.Wait() == Status::Finished);
+        CHECK(download.progress.size() == 2 && download.progress.back().percentage == 100.0f);
+        CHECK(download.progress.back().totalBytes == 1000.0 && download.progress.back().speed == 1000.0);
+    }
+
+    // The text output is parsed until the hook fires, a line that doesn't parse is skipped and never throws
+    {
+        Interpreter::scripts["text"] = [] {
+            for(auto line : { "[download]  42.3% of 10.00MiB at 1.00MiB/s ETA 00:05", "[download] % of 10.00MiB", "[download] .% done",
+                "[download] 1.2.3% of 10.00MiB", "[download] abc%", "[youtube] 60.0% is not a download line", "[download]  60.0% of 10.00MiB" }) {
+                Interpreter::Print(0, line);
+                std::this_thread::sleep_for(260ms);
+            }
+            Interpreter::Progress(700.0, 1000.0);
+            std::this_thread::sleep_for(260ms);
+            Interpreter::Print(0, "[download]  80.0% of 10.00MiB");
+            std::this_thread::sleep_for(260ms);
+            Interpreter::Progress(1000.0, 1000.0);
+            return 0;
+        };
+        Download download;
+        download.Enqueue("text");
+        CHECK(download.Wait() == Status::Finished);
+        std::vector<float> percentages;
+        for(auto& progress : download.progress)
+            percentages.emplace_back(progress.percentage);
+        CHECK(percentages == std::vector<float>({ 42.3f, 60.0f, 70.0f, 100.0f }));
+    }
+
+    // Cost of one update with the hook against parsing a line, most of them are throttled away
+    {
+        constexpr int calls = 200000;
+        double hookTime = 0.0, textTime = 0.0;
+        Interpreter::scripts["hook benchmark"] = [&] {
+            auto start = std::chrono::steady_clock::now();
+            for(int i = 0; i < calls; i++)
+                Interpreter::Progress(i, calls);
+            hookTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+            return 0;
+        };
+        Interpreter::scripts["text benchmark"] = [&] {
+            std::string line = "[download]  42.3% of 10.00MiB at 1.00MiB/s ETA 00:05";
+            auto start = std::chrono::steady_clock::now();
+            for(int i = 0; i < calls; i++)
+                Python::PythonWriteEvent.invoke(0, line.data());
+            textTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+            return 0;
+        };
+        Download hook, text;
+        hook.Enqueue("hook benchmark");
+        text.Enqueue("text benchmark");
+        CHECK(hook.Wait() == Status::Finished && text.Wait() == Status::Finished);
+        std::printf("Progress update: hook %.0f ns, text parser %.0f ns\n", hookTime, textTime);
+    }
+    std::printf("DownloadManager OK\n");
+    // The worker is detached and waits on the queue forever, destroying the queue under it would block
+    std::fflush(stdout);
+    std::quick_exit(0);
+}
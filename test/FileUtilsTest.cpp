@@ -0,0 +1,156 @@
+#include "Utils/FileUtils.hpp"
+#include "ModInfo.hpp"
+#include "CustomLogger.hpp"
+#include "Check.hpp"
+#include "ZipTestUtils.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+ModInfo modInfo = { "FileUtilsTest", "0.0.0" };
+
+Logger& getLogger() {
+    static Logger logger;
+    return logger;
+}
+
+/// Source like text, deflates about as well as the standard library does
+static std::string MakeData(std::size_t size, uint32_t seed) {
+    static const char* words[] = { "def ", "return ", "self", ".", "(", ")", ":\n    ", "import ", "None", " = ", "if ", "else", "\n", "_", "x", "value", "0", "1" };
+    std::mt19937 rng(seed);
+    std::string data;
+    while(data.size() < size)
+        data += words[rng() % std::size(words)];
+    data.resize(size);
+    return data;
+}
+
+/// The standard library of version, the modules grow from 1 KB to about 200 KB and one big stored library
+static std::vector<ZipFile> MakeFiles(int moduleCount, uint32_t version = 0) {
+    std::vector<ZipFile> files;
+    for(int i = 0; i < moduleCount; i++) {
+        auto directory = i % 3 == 0 ? "lib/python/" : i % 3 == 1 ? "lib/python/encodings/" : "lib/python/json/";
+        files.push_back({ directory + std::string("module") + std::to_string(i) + ".py", MakeData(1024 + (i * 7919) % (200 * 1024), i + version) });
+    }
+    files.push_back({ "lib/libpython.so", MakeData(4 * 1024 * 1024, 12345), false });
+    return files;
+}
+
+static std::string ReadFile(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+/// Exactly the files are on disk next to the manifest, with their content
+static void CheckExtracted(const fs::path& root, const std::vector<ZipFile>& files) {
+    for(auto& file : files)
+        CHECK(ReadFile(root / file.name) == file.data);
+    std::size_t onDisk = std::count_if(fs::recursive_directory_iterator(root), fs::recursive_directory_iterator(), [](auto& entry) { return entry.is_regular_file(); });
+    CHECK(onDisk == files.size() + 1);
+}
+
+static const auto OLD_TIME = fs::file_time_type(std::chrono::seconds(1000000));
+
+/// Backdates every extracted file, whatever ExtractZip writes again gets a new time
+static void Backdate(const fs::path& root, const std::vector<ZipFile>& files) {
+    for(auto& file : files)
+        fs::last_write_time(root / file.name, OLD_TIME);
+}
+
+static bool Rewritten(const fs::path& root, const ZipFile& file) {
+    return fs::last_write_time(root / file.name) != OLD_TIME;
+}
+
+template<typename Function>
+static double Milliseconds(Function function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    auto base = fs::temp_directory_path() / "cinema_tests" / "FileUtilsTest";
+    fs::remove_all(base);
+    auto root = base / "python";
+
+    auto files = MakeFiles(60);
+    auto zip = MakeZip(files);
+    CHECK(FileUtils::ExtractZip(zip, root.string(), nullptr, 4) == 0);
+    CheckExtracted(root, files);
+    auto manifest = ReadFile(root / ".extracted");
+    CHECK(manifest.ends_with("#complete\n"));
+
+    // Unchanged, nothing is written again
+    Backdate(root, files);
+    CHECK(FileUtils::ExtractZip(zip, root.string(), nullptr, 4) == 0);
+    CheckExtracted(root, files);
+    CHECK(std::none_of(files.begin(), files.end(), [&](auto& file) { return Rewritten(root, file); }));
+
+    // One module changed with the same size, one removed and one added, only those are touched
+    auto updated = files;
+    updated[1].data = MakeData(updated[1].data.size(), 999);
+    auto removed = updated[2];
+    updated.erase(updated.begin() + 2);
+    updated.push_back({ "lib/python/json/added.py", MakeData(5000, 1000) });
+    CHECK(FileUtils::ExtractZip(MakeZip(updated), root.string(), nullptr, 4) == 0);
+    CheckExtracted(root, updated);
+    CHECK(!fs::exists(root / removed.name));
+    for(std::size_t i = 0; i < updated.size(); i++)
+        CHECK(Rewritten(root, updated[i]) == (i == 1 || i == updated.size() - 1));
+
+    // Killed halfway, the manifest only has the lines appended for the entries that were written completely,
+    // one file was being written and the rest never started
+    auto interrupted = base / "interrupted";
+    CHECK(FileUtils::ExtractZip(zip, interrupted.string(), nullptr, 4) == 0);
+    Backdate(interrupted, files);
+    std::vector<std::string> lines;
+    {
+        std::ifstream file(interrupted / ".extracted");
+        for(std::string line; std::getline(file, line);)
+            lines.emplace_back(line);
+    }
+    CHECK(lines.size() == files.size() + 1);
+    std::size_t written = files.size() / 2;
+    {
+        std::ofstream file(interrupted / ".extracted", std::ios::trunc);
+        for(std::size_t i = 0; i < written; i++)
+            file << lines[i] << '\n';
+    }
+    fs::resize_file(interrupted / files[written].name, files[written].data.size() / 2);
+    for(std::size_t i = written + 1; i < files.size(); i++)
+        fs::remove(interrupted / files[i].name);
+    CHECK(FileUtils::ExtractZip(zip, interrupted.string(), nullptr, 4) == 0);
+    CheckExtracted(interrupted, files);
+    CHECK(ReadFile(interrupted / ".extracted") == manifest);
+    for(std::size_t i = 0; i < files.size(); i++)
+        CHECK(Rewritten(interrupted, files[i]) == (i >= written));
+
+    // Entries the filter rejects count as removed
+    CHECK(FileUtils::ExtractZip(zip, interrupted.string(), [](std::string_view name) { return !name.ends_with(".so"); }, 4) == 0);
+    CHECK(!fs::exists(interrupted / "lib/libpython.so") && fs::exists(interrupted / files[0].name));
+
+    // A standard library sized zip, fresh and again unchanged
+    auto large = MakeFiles(600);
+    auto largeZip = MakeZip(large);
+    std::size_t totalSize = 0;
+    for(auto& file : large)
+        totalSize += file.data.size();
+    for(int threads : { 1, 2, 4, 8 }) {
+        auto target = base / ("threads" + std::to_string(threads));
+        double fresh = Milliseconds([&] { CHECK(FileUtils::ExtractZip(largeZip, target.string(), nullptr, threads) == 0); });
+        double unchanged = Milliseconds([&] { CHECK(FileUtils::ExtractZip(largeZip, target.string(), nullptr, threads) == 0); });
+        std::printf("%zu files, %zu MB, %d threads: extract %.0f ms, unchanged %.1f ms\n", large.size(), totalSize >> 20, threads, fresh, unchanged);
+        CheckExtracted(target, large);
+        fs::remove_all(target);
+    }
+    fs::remove_all(base);
+    std::printf("FileUtils OK\n");
+}
@@ -0,0 +1,142 @@
+#include "FrameRing.hpp"
+#include "Check.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+using namespace Cinema;
+
+// Every frame is filled with its sequence number, a torn or reused slot shows up as a mixed pattern
+static void WriteFrame(uint8_t* slot, std::size_t size, uint64_t sequence) {
+    std::memset(slot, static_cast<uint8_t>(sequence), size);
+    std::memcpy(slot, &sequence, sizeof(sequence));
+    std::memcpy(slot + size - sizeof(sequence), &sequence, sizeof(sequence));
+}
+
+static uint64_t ReadFrame(const uint8_t* slot, std::size_t size) {
+    uint64_t first, last;
+    std::memcpy(&first, slot, sizeof(first));
+    std::memcpy(&last, slot + size - sizeof(last), sizeof(last));
+    CHECK(first == last);
+    for(std::size_t i = sizeof(first); i < size - sizeof(last); i += 61)
+        CHECK(slot[i] == static_cast<uint8_t>(first));
+    return first;
+}
+
+/// Runs a decoder and a renderer at different rates and checks every presented frame is whole and newer than the last
+static void Run(FrameRing& ring, uint64_t frameCount, std::chrono::microseconds writeDelay, std::chrono::microseconds readDelay) {
+    ring.ResetStats();
+    std::atomic<bool> done = false;
+    std::thread decoder([&] {
+        for(uint64_t sequence = 1; sequence <= frameCount; sequence++) {
+            WriteFrame(ring.BeginWrite(), ring.get_slotSize(), sequence);
+            ring.EndWrite();
+            if(writeDelay.count() > 0)
+                std::this_thread::sleep_for(writeDelay);
+        }
+        done = true;
+    });
+    uint64_t lastSequence = 0;
+    uint64_t presented = 0;
+    while(true) {
+        bool finished = done.load();
+        // Drains the last frame after the decoder stopped
+        while(auto frame = ring.AcquireLatest()) {
+            auto sequence = ReadFrame(frame, ring.get_slotSize());
+            CHECK(sequence > lastSequence);
+            lastSequence = sequence;
+            presented++;
+            ring.EndRead();
+        }
+        if(finished)
+            break;
+        if(readDelay.count() > 0)
+            std::this_thread::sleep_for(readDelay);
+    }
+    decoder.join();
+
+    auto stats = ring.get_stats();
+    CHECK(lastSequence == frameCount);
+    CHECK(stats.publishedFrames == frameCount);
+    CHECK(stats.presentedFrames == presented);
+    // Every frame was either presented or replaced before the renderer got to it
+    CHECK(stats.presentedFrames + stats.droppedFrames == stats.publishedFrames);
+    // Every dropped frame gets overwritten, only one dropped before ResetStats or by the very last frame is off by one
+    CHECK(stats.reusedSlots <= stats.droppedFrames + 1 && stats.reusedSlots + 1 >= stats.droppedFrames);
+    CHECK(stats.peakOccupancy >= 1 && stats.peakOccupancy <= FrameRing::SLOT_COUNT);
+    std::printf("%llu frames, write delay %lld us, read delay %lld us: presented %llu, dropped %llu, peak occupancy %u\n",
+        (unsigned long long) frameCount, (long long) writeDelay.count(), (long long) readDelay.count(),
+        (unsigned long long) stats.presentedFrames, (unsigned long long) stats.droppedFrames, stats.peakOccupancy);
+}
+
+int main() {
+    CHECK(FrameRing::AlignPitch(1) == FrameRing::PITCH_ALIGNMENT);
+    CHECK(FrameRing::AlignPitch(1920 * 4) == 1920 * 4);
+    CHECK(FrameRing::AlignPitch(1918 * 4) == 1920 * 4);
+
+    FrameRing ring;
+    CHECK(ring.AcquireLatest() == nullptr);
+
+    // The counters step by step on one thread
+    ring.Configure(16 * 4, 4);
+    auto step = [&](uint64_t reused, uint32_t peak) {
+        auto stats = ring.get_stats();
+        CHECK(stats.reusedSlots == reused && stats.peakOccupancy == peak);
+    };
+    ring.BeginWrite();
+    step(0, 1);
+    ring.EndWrite();
+    // Presented while nothing is written
+    CHECK(ring.AcquireLatest());
+    step(0, 1);
+    // Written while the frame is uploaded, then one waits for the renderer while the next is written
+    ring.BeginWrite();
+    step(0, 2);
+    ring.EndWrite();
+    ring.BeginWrite();
+    step(0, 3);
+    ring.EndRead();
+    // That write replaces the waiting frame, which the one after overwrites
+    ring.EndWrite();
+    CHECK(ring.get_stats().droppedFrames == 1);
+    ring.BeginWrite();
+    step(1, 3);
+    ring.EndWrite();
+    ring.ResetStats();
+    // With the upload done nothing is in use but the write slot and the waiting frame.
+    // The first write goes over the frame the last one replaced, the next over the slot the renderer gave back
+    CHECK(ring.AcquireLatest());
+    ring.EndRead();
+    ring.BeginWrite();
+    step(1, 1);
+    ring.EndWrite();
+    ring.BeginWrite();
+    step(1, 2);
+    ring.EndWrite();
+    ring.ResetStats();
+
+    ring.Configure(64 * 4, 48);
+    CHECK(ring.get_pitch() == 256 && ring.get_slotSize() == 256 * 48);
+    CHECK(ring.AcquireLatest() == nullptr);
+    // Fast decoder, slow renderer: most frames are dropped, none are queued
+    Run(ring, 20000, std::chrono::microseconds(0), std::chrono::microseconds(50));
+    // Slow decoder, fast renderer: nothing is dropped unless the renderer thread gets descheduled
+    Run(ring, 2000, std::chrono::microseconds(50), std::chrono::microseconds(0));
+    // Both flat out
+    Run(ring, 100000, std::chrono::microseconds(0), std::chrono::microseconds(0));
+
+    // A bigger format with neither thread holding a slot, the old frames are gone
+    ring.Configure(123 * 4, 77);
+    CHECK(ring.get_pitch() % FrameRing::PITCH_ALIGNMENT == 0 && ring.get_pitch() >= 123 * 4);
+    CHECK(ring.AcquireLatest() == nullptr);
+    Run(ring, 20000, std::chrono::microseconds(0), std::chrono::microseconds(20));
+
+    // Shrinking reuses the pool
+    ring.Configure(16 * 4, 16);
+    CHECK(ring.get_slotSize() == 64 * 16);
+    Run(ring, 20000, std::chrono::microseconds(0), std::chrono::microseconds(0));
+
+    std::printf("FrameRing OK\n");
+}
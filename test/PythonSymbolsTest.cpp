@@ -0,0 +1,102 @@
+#include "PythonInternal.hpp"
+#include "PythonSymbols.hpp"
+#include "Check.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <dlfcn.h>
+#include <set>
+#include <string_view>
+#include <vector>
+
+// The same expansions as Downloader.cpp, checked against the libpython of the host
+namespace Python {
+    #define DEFINE_PYTHON_FUNCTION(binding, retval, name, ...) DEFINE_DLSYM(retval, name, __VA_ARGS__)
+    #define DEFINE_PYTHON_TYPE(binding, name) DEFINE_DLSYM_TYPE(name)
+    PYTHON_SYMBOLS(DEFINE_PYTHON_FUNCTION, DEFINE_PYTHON_TYPE)
+
+    #define BIND_PYTHON_FUNCTION(binding, retval, name, ...) DLSYM_##binding(name),
+    #define BIND_PYTHON_TYPE(binding, name) DLSYM_##binding(name),
+    static const DlsymBinding dlsymBindings[] = {
+        PYTHON_SYMBOLS(BIND_PYTHON_FUNCTION, BIND_PYTHON_TYPE)
+    };
+}
+
+using namespace Python;
+
+static const DlsymBinding* Find(std::string_view name) {
+    auto itr = std::find_if(std::begin(dlsymBindings), std::end(dlsymBindings), [name](auto& binding) { return binding.name == name; });
+    return itr == std::end(dlsymBindings) ? nullptr : itr;
+}
+
+/// What Load_Dlsym did before the table, dlerror around every dlsym, the load gave up at the first missing symbol
+/// @return the index of the first missing symbol
+static std::size_t ResolveEagerly(void* libpython) {
+    std::size_t firstMissing = std::size(dlsymBindings);
+    for(std::size_t i = 0; i < std::size(dlsymBindings); i++) {
+        dlerror();
+        *dlsymBindings[i].address = dlsym(libpython, dlsymBindings[i].name);
+        if(dlerror() && firstMissing == std::size(dlsymBindings))
+            firstMissing = i;
+    }
+    return firstMissing;
+}
+
+/// The single pass of Load_Dlsym
+/// @return the number of required symbols that are missing
+static int ResolveTable(void* libpython, int& missingOptional) {
+    int missingRequired = 0;
+    missingOptional = 0;
+    for(auto& binding : dlsymBindings) {
+        *binding.address = dlsym(libpython, binding.name);
+        if(!*binding.address)
+            (binding.optional ? missingOptional : missingRequired)++;
+    }
+    return missingRequired;
+}
+
+template<typename Function>
+static double MedianMicroseconds(Function function) {
+    std::vector<double> times;
+    for(int i = 0; i < 51; i++) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        times.emplace_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+int main() {
+    // Every entry is bound once and writes to its own pointer
+    std::set<std::string_view> names;
+    std::set<void**> addresses;
+    for(auto& binding : dlsymBindings) {
+        CHECK(names.insert(binding.name).second);
+        CHECK(addresses.insert(binding.address).second);
+    }
+    CHECK(Find("PyGILState_Ensure")->address == reinterpret_cast<void**>(&PyGILState_Ensure));
+    CHECK(Find("PyBaseObject_Type")->address == reinterpret_cast<void**>(&PyBaseObject_Type));
+
+    // Everything the mod calls has to be there, a missing one fails the load
+    for(auto name : { "PyGILState_Ensure", "PyGILState_Release", "PyRun_SimpleString", "PyErr_NewException", "PyThreadState_SetAsyncExc",
+        "PyArg_ParseTuple", "PyThread_get_thread_ident", "Py_IncRef", "Py_DecRef", "PyModule_Create2", "PyImport_GetModuleDict", "PyDict_SetItemString" }) {
+        auto binding = Find(name);
+        CHECK(binding && !binding->optional);
+    }
+
+    // Another libpython build than the one shipped, the required symbols still resolve where eager loading gives up
+    auto libpython = dlopen(PYTHON_LIBRARY, RTLD_NOW | RTLD_LOCAL);
+    CHECK(libpython);
+    int missingOptional = 0;
+    CHECK(ResolveTable(libpython, missingOptional) == 0);
+    auto firstMissing = ResolveEagerly(libpython);
+    CHECK((missingOptional == 0) == (firstMissing == std::size(dlsymBindings)));
+    std::printf("%s: %zu symbols, %d optional ones missing, eager loading would have stopped after %zu\n", PYTHON_LIBRARY, std::size(dlsymBindings), missingOptional, firstMissing);
+
+    double tableTime = MedianMicroseconds([&] { ResolveTable(libpython, missingOptional); });
+    double eagerTime = MedianMicroseconds([&] { ResolveEagerly(libpython); });
+    std::printf("Binding table %.0f us, with dlerror around every dlsym %.0f us\n", tableTime, eagerTime);
+    std::printf("PythonSymbols OK\n");
+}
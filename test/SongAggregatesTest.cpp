@@ -0,0 +1,82 @@
+#include "SongDetailsTestUtils.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/// The getters before the aggregates, worked out from the difficulties on every call
+static float OldMaxStar(const Song& song) {
+    if (song.rankedStatus != RankedStatus::Ranked)
+        return 0.0f;
+    return song.max([](const auto& diff) { return diff.stars; });
+}
+
+static float OldRating(const Song& song) {
+    float tot = song.upvotes + song.downvotes;
+    if (tot == 0)
+        return 0;
+    float tmp = song.upvotes / tot;
+    return static_cast<float>(tmp - (tmp - 0.5f) * std::pow(2, -std::log10(tot + 1)));
+}
+
+template<typename Function>
+static double Milliseconds(Function function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    ResetCache("SongAggregatesTest");
+    auto database = MakeDatabase(30000);
+    // A few songs nobody voted on, the old formula returns 0 for them instead of dividing by zero
+    for (int i = 0; i < database.songs_size(); i += 97) {
+        database.mutable_songs(i)->set_upvotes(0);
+        database.mutable_songs(i)->set_downvotes(0);
+    }
+    SongDetailsTestAccess::Process(database, true);
+    auto state = SongDetailsTestAccess::get_state();
+    const auto& songs = *state->columns.songs;
+
+    for (const auto& song : songs) {
+        bool ranked = song.rankedStatus == RankedStatus::Ranked;
+        CHECK(song.minNJS() == song.min([](const auto& diff) { return diff.njs; }) && song.maxNJS() == song.max([](const auto& diff) { return diff.njs; }));
+        CHECK(song.maxStar() == OldMaxStar(song) && song.rating() == OldRating(song));
+        CHECK(song.minStar() == (ranked ? song.min([](const auto& diff) { return diff.ranked() ? diff.stars : std::numeric_limits<float>::max(); }) : 0.0f));
+        CHECK(song.minPP() == (ranked ? song.min([](const auto& diff) { return diff.ranked() ? diff.approximatePpValue() : std::numeric_limits<float>::max(); }) : 0.0f));
+        CHECK(song.maxPP() == (ranked ? song.max([](const auto& diff) { return diff.approximatePpValue(); }) : 0.0f));
+    }
+    // Songs outside every database still work the values out themselves
+    CHECK(Song::none.rating() == 0.0f && Song::none.maxStar() == 0.0f);
+    CHECK(Song::none.minNJS() == std::numeric_limits<float>::max() && Song::none.maxNJS() == std::numeric_limits<float>::min());
+
+    // Sorting is where the getters are called the most
+    std::vector<const Song*> old, aggregated;
+    for (const auto& song : songs)
+        old.emplace_back(&song);
+    aggregated = old;
+    double oldStarTime = Milliseconds([&] { std::stable_sort(old.begin(), old.end(), [](auto a, auto b) { return OldMaxStar(*a) > OldMaxStar(*b); }); });
+    double starTime = Milliseconds([&] { std::stable_sort(aggregated.begin(), aggregated.end(), [](auto a, auto b) { return a->maxStar() > b->maxStar(); }); });
+    CHECK(old == aggregated);
+    double oldRatingTime = Milliseconds([&] { std::stable_sort(old.begin(), old.end(), [](auto a, auto b) { return OldRating(*a) > OldRating(*b); }); });
+    double ratingTime = Milliseconds([&] { std::stable_sort(aggregated.begin(), aggregated.end(), [](auto a, auto b) { return a->rating() > b->rating(); }); });
+    CHECK(old == aggregated);
+    std::printf("sort %zu songs by maxStar: %.1f ms -> %.1f ms, by rating: %.1f ms -> %.1f ms\n", songs.size(), oldStarTime, starTime, oldRatingTime, ratingTime);
+
+    // What one getter call costs on a song of the database and on a copy of one
+    std::vector<Song> copies(songs.begin(), songs.end());
+    for (std::size_t i = 0; i < songs.size(); i += 101)
+        CHECK(copies[i].rating() == songs[i].rating() && copies[i].mapId() == songs[i].mapId() && copies[i].songName() == songs[i].songName());
+    auto perCall = [&](const std::vector<Song>& list) {
+        float sum = 0.0f;
+        double time = Milliseconds([&] {
+            for (int repeat = 0; repeat < 10; repeat++) {
+                for (const auto& song : list)
+                    sum += song.rating() + song.maxStar() + song.mapId();
+            }
+        });
+        CHECK(sum > 0.0f);
+        return time * 1e6 / (list.size() * 10 * 3);
+    };
+    std::printf("getter: %.1f ns per call on the database's songs, %.1f ns on copies\n", perCall(songs), perCall(copies));
+    std::printf("SongAggregates OK\n");
+}
@@ -0,0 +1,107 @@
+#include "SongDetailsTestUtils.hpp"
+
+#include <map>
+
+static constexpr const uint64_t SCRAPE_ENDED = 1700000000;
+static constexpr const uint64_t DELTA_SCRAPE_ENDED = SCRAPE_ENDED + 3600;
+
+/// Changes some maps, adds new ones in between and at the end, one map twice, in no particular order
+static Structs::SongProtoContainer MakeDelta(const Structs::SongProtoContainer& base, uint32_t seed) {
+    std::mt19937 rng(seed);
+    Structs::SongProtoContainer delta;
+    delta.set_formatversion(1);
+    delta.set_scrapeendedtimeunix(DELTA_SCRAPE_ENDED);
+    for (int i = 0; i < 300; i++) {
+        uint32_t mapId = i % 3 == 0 ? base.songs(rng() % base.songs_size()).mapid() : i % 3 == 1 ? rng() % 60000 : 60000 + rng() % 1000;
+        FillSong(delta.add_songs(), mapId, rng);
+    }
+    *delta.add_songs() = delta.songs(0);
+    delta.mutable_songs(delta.songs_size() - 1)->set_downloadcount(12345);
+    for (int i = delta.songs_size() - 1; i > 0; i--)
+        delta.mutable_songs()->SwapElements(i, rng() % (i + 1));
+    return delta;
+}
+
+/// What a full download after the delta would contain
+static Structs::SongProtoContainer Merge(const Structs::SongProtoContainer& base, const Structs::SongProtoContainer& delta) {
+    std::map<uint32_t, const Structs::SongProto*> songs;
+    for (const auto& song : base.songs())
+        songs[song.mapid()] = &song;
+    // The last record of a map wins, like in ApplyDelta
+    for (const auto& song : delta.songs())
+        songs[song.mapid()] = &song;
+    Structs::SongProtoContainer merged;
+    merged.set_formatversion(1);
+    merged.set_scrapeendedtimeunix(delta.scrapeendedtimeunix());
+    for (auto [mapId, song] : songs)
+        *merged.add_songs() = *song;
+    return merged;
+}
+
+int main() {
+    ResetCache("SongDetailsDeltaTest");
+
+    // Delta updates are off until a source is set, Load goes straight to the full download
+    CHECK(!DataGetter::HasDeltaSource("Direct"));
+    auto base = MakeDatabase(20000, SCRAPE_ENDED, 7);
+    auto delta = MakeDelta(base, 8);
+    SongDetailsTestAccess::Process(Compress(base), true);
+    webResponses["https://example.com/delta?since=" + std::to_string(SCRAPE_ENDED)] = Gzip(delta.SerializeAsString());
+    auto before = SongDetailsTestAccess::get_state();
+    SongDetailsContainer::Load(false, 1).get();
+    CHECK(SongDetailsTestAccess::get_state() == before);
+
+    // Once it is set, Load merges the delta and writes the snapshot again
+    DataGetter::SetDeltaSource("Direct", "https://example.com/delta?since={}");
+    CHECK(DataGetter::HasDeltaSource("Direct"));
+    SongDetailsContainer::Load(false, 1).get();
+    auto applied = SongDetailsTestAccess::get_state();
+    CHECK(applied != before && applied->scrapeEndedTimeUnix.time_since_epoch().count() == DELTA_SCRAPE_ENDED);
+    auto snapshot = SongDetailsSnapshot::Open(SongDetailsSnapshot::path());
+    CHECK(snapshot && snapshot->get_scrapeEndedTimeUnix() == DELTA_SCRAPE_ENDED);
+    // There is no newer delta, the full download fails too and the merged database stays
+    SongDetailsContainer::Load(false, 1).get();
+    CHECK(SongDetailsTestAccess::get_state() == applied);
+
+    // The merged columns are exactly what processing the merged database from scratch gives
+    SongDetailsTestAccess::Process(Merge(base, delta), true);
+    CheckSameColumns(applied->columns, SongDetailsTestAccess::get_state()->columns);
+    for (uint32_t seed = 0; seed < 4; seed++) {
+        auto base = MakeDatabase(5000 + seed * 3000, SCRAPE_ENDED, seed);
+        auto delta = MakeDelta(base, seed + 100);
+        SongDetailsTestAccess::Process(base, true);
+        CHECK(SongDetailsTestAccess::ApplyDelta(delta));
+        auto applied = SongDetailsTestAccess::get_state();
+        SongDetailsTestAccess::Process(Merge(base, delta), true);
+        CheckSameColumns(applied->columns, SongDetailsTestAccess::get_state()->columns);
+    }
+
+    // Unchanged songs go back through the proto as lround(x * 100), that has to give the same float for every hundredth up to 655.35
+    Structs::SongProtoContainer everyValue;
+    everyValue.set_scrapeendedtimeunix(SCRAPE_ENDED);
+    std::mt19937 rng(3);
+    for (uint32_t value = 0; value <= UINT16_MAX;) {
+        auto song = everyValue.add_songs();
+        FillSong(song, everyValue.songs_size(), rng);
+        for (auto& diff : *song->mutable_difficulties()) {
+            auto clamped = std::min<uint32_t>(value++, UINT16_MAX);
+            diff.set_starst100(clamped);
+            diff.set_njst100(UINT16_MAX - clamped);
+        }
+    }
+    SongDetailsTestAccess::Process(everyValue, true);
+    auto original = SongDetailsTestAccess::get_state();
+    Structs::SongProtoContainer added;
+    added.set_scrapeendedtimeunix(DELTA_SCRAPE_ENDED);
+    FillSong(added.add_songs(), everyValue.songs_size() + 1, rng);
+    CHECK(SongDetailsTestAccess::ApplyDelta(added));
+    auto merged = SongDetailsTestAccess::get_state();
+    const auto& copied = *merged->columns.difficulties;
+    const auto& difficulties = *original->columns.difficulties;
+    CHECK(copied.size() == difficulties.size() + added.songs(0).difficulties_size());
+    for (std::size_t i = 0; i < difficulties.size(); i++) {
+        CHECK(copied[i].stars == difficulties[i].stars && copied[i].njs == difficulties[i].njs);
+        CHECK(std::lround(difficulties[i].stars * 100.0f) == std::min<long>(i, UINT16_MAX));
+    }
+    std::printf("SongDetailsDelta OK\n");
+}
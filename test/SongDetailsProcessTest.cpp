@@ -0,0 +1,68 @@
+#include "SongDetailsTestUtils.hpp"
+
+#include <google/protobuf/io/gzip_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <sstream>
+
+/// The old way, the whole container parsed before any column is built
+static Structs::SongProtoContainer Parse(const std::vector<uint8_t>& data) {
+    google::protobuf::io::ArrayInputStream compressed(data.data(), data.size());
+    google::protobuf::io::GzipInputStream decompressed(&compressed);
+    Structs::SongProtoContainer container;
+    CHECK(container.ParseFromZeroCopyStream(&decompressed));
+    return container;
+}
+
+template<typename Function>
+static long long Milliseconds(Function function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    ResetCache("SongDetailsProcessTest");
+    auto data = Compress(MakeDatabase(50000, 1700000000, 1));
+
+    long long parsedTime = Milliseconds([&] { SongDetailsTestAccess::Process(Parse(data), true); });
+    auto parsed = SongDetailsTestAccess::get_state();
+    long long streamedTime = Milliseconds([&] { SongDetailsTestAccess::Process(data, true); });
+    auto streamed = SongDetailsTestAccess::get_state();
+    CHECK(streamed != parsed && streamed->scrapeEndedTimeUnix == parsed->scrapeEndedTimeUnix);
+    CheckSameColumns(parsed->columns, streamed->columns);
+    std::printf("50000 songs: parsed container %lld ms, streamed %lld ms\n", parsedTime, streamedTime);
+
+    // Every thread count decodes the same columns as the loading thread alone
+    for (unsigned int threadCount : { 1u, 2u, 3u, 8u, 0u }) {
+        SongDetailsTestAccess::processThreadCount = threadCount;
+        long long time = Milliseconds([&] { SongDetailsTestAccess::Process(data, true); });
+        CheckSameColumns(parsed->columns, SongDetailsTestAccess::get_state()->columns);
+        std::printf("%u threads: %lld ms\n", threadCount, time);
+    }
+
+    // The same database again is dropped right after the scrape time unless forced
+    auto published = SongDetailsTestAccess::get_state();
+    SongDetailsTestAccess::Process(data, false);
+    CHECK(SongDetailsTestAccess::get_state() == published);
+    auto newer = Compress(MakeDatabase(1000, 1700000001, 2));
+    SongDetailsTestAccess::Process(newer, false);
+    CHECK(SongDetailsTestAccess::get_state()->columns.songs->size() == 1000);
+
+    // Straight from a stream like the cached file
+    std::istringstream stream(std::string(data.begin(), data.end()));
+    SongDetailsTestAccess::Process(stream, true);
+    CheckSameColumns(parsed->columns, SongDetailsTestAccess::get_state()->columns);
+
+    // Anything that isn't a database is an error and leaves the current one alone
+    auto current = SongDetailsTestAccess::get_state();
+    for (auto damaged : { std::vector<uint8_t>(data.begin(), data.begin() + data.size() / 2), std::vector<uint8_t>(100, 0x55), std::vector<uint8_t>() }) {
+        bool threw = false;
+        try {
+            SongDetailsTestAccess::Process(damaged, true);
+        } catch (const std::exception&) {
+            threw = true;
+        }
+        CHECK(threw && SongDetailsTestAccess::get_state() == current);
+    }
+    std::printf("SongDetailsProcess OK\n");
+}
@@ -0,0 +1,145 @@
+#include "SongDetailsTestUtils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+
+using Filter = std::function<bool(const SongDifficulty&)>;
+
+/// What SongDetails::FindSongIndexes does, every difficulty through a std::function
+static std::vector<std::size_t> Scan(const std::vector<SongDifficulty>& difficulties, const Filter& check) {
+    std::vector<std::size_t> l;
+    for (std::size_t i = 0, last = std::numeric_limits<uint32_t>::max(); i < difficulties.size(); i++) {
+        auto& cur = difficulties[i];
+        if (last == cur.songIndex || !check(cur))
+            continue;
+        last = l.emplace_back(cur.songIndex);
+    }
+    return l;
+}
+
+/// Median of 21 runs
+template<typename Function>
+static double Microseconds(Function function) {
+    std::vector<double> times;
+    for (int i = 0; i < 21; i++) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        times.emplace_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+int main() {
+    ResetCache("SongDetailsQueryTest");
+    // Nothing is found while the database is still loading
+    {
+        DifficultyQuery query;
+        query.stars.min = 1.0f;
+        for (const auto& nothing : { DifficultyQuery(), query }) {
+            CHECK(SongDetailsContainer::FindSongIndexes(nothing).empty());
+            CHECK(SongDetailsContainer::FindSongs(nothing).empty());
+            CHECK(SongDetailsContainer::CountSongs(nothing) == 0);
+        }
+    }
+
+    SongDetailsTestAccess::Process(MakeDatabase(20000, 1700000000, 1), true);
+    auto state = SongDetailsTestAccess::get_state();
+    const auto& difficulties = *state->columns.difficulties;
+
+    struct Case {
+        const char* name;
+        DifficultyQuery query;
+        Filter check;
+    };
+    std::vector<Case> cases;
+    {
+        DifficultyQuery query;
+        query.stars = { 7.0f, 9.5f };
+        cases.push_back({ "stars", query, [](auto& diff) { return diff.stars >= 7.0f && diff.stars <= 9.5f; } });
+    }
+    {
+        DifficultyQuery query;
+        query.njs = { 16.0f, 20.0f };
+        query.notes.min = 1000;
+        cases.push_back({ "njs and notes", query, [](auto& diff) { return diff.njs >= 16.0f && diff.njs <= 20.0f && diff.notes >= 1000; } });
+    }
+    {
+        DifficultyQuery query;
+        query.characteristics = 1u << static_cast<int>(MapCharacteristic::Standard);
+        query.difficulties = 1u << static_cast<int>(MapDifficulty::ExpertPlus);
+        query.bombs.max = 0;
+        cases.push_back({ "standard expert+ without bombs", query, [](auto& diff) {
+            return diff.characteristic == MapCharacteristic::Standard && diff.difficulty == MapDifficulty::ExpertPlus && diff.bombs == 0;
+        } });
+    }
+    cases.push_back({ "everything", DifficultyQuery(), [](auto&) { return true; } });
+    {
+        DifficultyQuery query;
+        query.stars.min = 100.0f;
+        cases.push_back({ "nothing", query, [](auto& diff) { return diff.stars >= 100.0f; } });
+    }
+    // Bounds between two hundredths and right on them
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> value(-1.0f, 20.0f);
+    for (int i = 0; i < 200; i++) {
+        float min = value(rng), max = value(rng);
+        if (min > max)
+            std::swap(min, max);
+        if (i % 3 == 0) {
+            min = std::round(min * 100.0f) / 100.0f;
+            max = std::round(max * 100.0f) / 100.0f;
+        }
+        DifficultyQuery query;
+        if (i % 2)
+            query.stars = { min / 1.5f, max / 1.5f };
+        else
+            query.njs = { min, max };
+        cases.push_back({ "random range", query, [query, stars = i % 2 == 1](auto& diff) {
+            return stars ? diff.stars >= query.stars.min && diff.stars <= query.stars.max : diff.njs >= query.njs.min && diff.njs <= query.njs.max;
+        } });
+    }
+    for (const auto& test : cases) {
+        auto expected = Scan(difficulties, test.check);
+        CHECK(SongDetailsContainer::FindSongIndexes(test.query) == expected);
+        CHECK(SongDetailsContainer::CountSongs(test.query) == expected.size());
+        auto songs = SongDetailsContainer::FindSongs(test.query);
+        CHECK(songs.size() == expected.size());
+        for (std::size_t i = 0; i < songs.size(); i++)
+            CHECK(songs[i].index == expected[i]);
+    }
+
+    // The named cases against the std::function scan they replace
+    for (const auto& test : cases) {
+        if (std::string_view(test.name) == "random range")
+            break;
+        double kernelTime = Microseconds([&] { SongDetailsContainer::FindSongIndexes(test.query); });
+        double countTime = Microseconds([&] { SongDetailsContainer::CountSongs(test.query); });
+        double scanTime = Microseconds([&] { Scan(difficulties, test.check); });
+        std::printf("%s over %zu difficulties: FindSongIndexes %.0f us, CountSongs %.0f us, std::function scan %.0f us\n",
+            test.name, difficulties.size(), kernelTime, countTime, scanTime);
+    }
+
+    // The lists keep their database alive after an update replaced it
+    DifficultyQuery ranked;
+    ranked.stars.min = 0.01f;
+    auto found = SongDetailsContainer::FindSongs(ranked);
+    auto searched = SongDetailsContainer::Search("camellia extended", 100);
+    CHECK(!found.empty() && !searched.empty());
+    std::weak_ptr<const SongDetailsTestAccess::State> old = state;
+    state.reset();
+    // Two updates, the one right after it keeps the replaced state pinned for the Song getters
+    SongDetailsTestAccess::Process(MakeDatabase(100, 1700000001, 2), true);
+    SongDetailsTestAccess::Process(MakeDatabase(100, 1700000002, 3), true);
+    CHECK(!old.expired());
+    for (auto song : found)
+        CHECK(song->songName().starts_with("Song number " + std::to_string(song->mapId())) && song->maxStar() > 0.0f);
+    for (auto song : searched)
+        CHECK(song->songAuthorName() == "Camellia" && song->songName().ends_with("(Extended Mix)"));
+    found = SongList();
+    searched = SongList();
+    CHECK(old.expired());
+    std::printf("SongDetailsQuery OK\n");
+}
@@ -0,0 +1,165 @@
+#include "SongDetailsTestUtils.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using Section = SongDetailsSnapshot::Section;
+
+static std::string ReadFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+static SongDetailsTestAccess::SnapshotHeader& HeaderOf(std::string& file) {
+    return *reinterpret_cast<SongDetailsTestAccess::SnapshotHeader*>(file.data());
+}
+
+template<typename T>
+static T* SectionOf(std::string& file, Section section) {
+    return reinterpret_cast<T*>(file.data() + HeaderOf(file).sections[static_cast<uint32_t>(section)].offset);
+}
+
+/// Writes a damaged copy of the snapshot, Open has to turn it down before anything reads the broken section
+static void CheckRejected(const std::string& original, const char* what, const std::function<void(std::string&)>& damage) {
+    auto file = original;
+    damage(file);
+    auto path = DataGetter::cachePath().parent_path() / "damaged.columns";
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << file;
+    if (SongDetailsSnapshot::Open(path)) {
+        std::fprintf(stderr, "Damaged snapshot was accepted: %s\n", what);
+        std::abort();
+    }
+}
+
+static std::size_t ResidentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    std::size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+struct ColdLoad {
+    double milliseconds;
+    long long residentKB;
+};
+
+/// Runs load in a fresh child process, like the first load after the game starts, the file stays in the page cache
+template<typename Load>
+static ColdLoad MeasureColdLoad(Load load) {
+    int fds[2];
+    CHECK(pipe(fds) == 0);
+    auto child = fork();
+    CHECK(child >= 0);
+    if (child == 0) {
+        close(fds[0]);
+        auto residentBefore = ResidentBytes();
+        auto start = std::chrono::steady_clock::now();
+        load();
+        ColdLoad result = { std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+            ((long long) ResidentBytes() - (long long) residentBefore) / 1024 };
+        bool written = write(fds[1], &result, sizeof(result)) == sizeof(result);
+        _exit(written ? 0 : 1);
+    }
+    close(fds[1]);
+    ColdLoad result = {};
+    CHECK(read(fds[0], &result, sizeof(result)) == sizeof(result));
+    close(fds[0]);
+    int status = 0;
+    CHECK(waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    return result;
+}
+
+/// Median time and resident growth of a few cold loads
+template<typename Load>
+static ColdLoad MedianColdLoad(Load load) {
+    std::vector<ColdLoad> runs;
+    for (int i = 0; i < 5; i++)
+        runs.emplace_back(MeasureColdLoad(load));
+    std::sort(runs.begin(), runs.end(), [](auto& a, auto& b) { return a.milliseconds < b.milliseconds; });
+    return runs[runs.size() / 2];
+}
+
+int main() {
+    auto database = MakeDatabase(5000);
+    ResetCache("SongDetailsSnapshotTest", &database);
+
+    // The first load decodes the protobuf and writes the snapshot, the second one only maps it
+    SongDetailsContainer::Load(false, 1).get();
+    auto decoded = SongDetailsTestAccess::get_state();
+    CHECK(decoded->columns.songs->size() == 5000 && std::filesystem::exists(SongDetailsSnapshot::path()));
+    auto snapshot = SongDetailsSnapshot::Open(SongDetailsSnapshot::path());
+    CHECK(snapshot && snapshot->get_songCount() == 5000 && snapshot->get_scrapeEndedTimeUnix() == database.scrapeendedtimeunix());
+    SongDetailsTestAccess::Process(*snapshot);
+    auto mapped = SongDetailsTestAccess::get_state();
+    CHECK(mapped != decoded);
+    CheckSameColumns(decoded->columns, mapped->columns);
+    for (std::size_t i = 0; i < mapped->columns.songs->size(); i++)
+        CHECK(SongDetailsTestAccess::FindHash(mapped->columns, (*decoded->columns.hashBytes)[i]) == i);
+    snapshot.reset();
+
+    auto original = ReadFile(SongDetailsSnapshot::path());
+    CheckRejected(original, "truncated", [](std::string& file) { file.resize(file.size() / 2); });
+    CheckRejected(original, "other version", [](std::string& file) { HeaderOf(file).version++; });
+    CheckRejected(original, "short song column", [](std::string& file) { HeaderOf(file).sections[static_cast<uint32_t>(Section::Bpm)].size -= sizeof(float); });
+    CheckRejected(original, "short difficulty column", [](std::string& file) { HeaderOf(file).sections[static_cast<uint32_t>(Section::Notes)].size = 0; });
+    CheckRejected(original, "more songs than columns", [](std::string& file) { HeaderOf(file).songCount++; });
+    CheckRejected(original, "more difficulties than columns", [](std::string& file) { HeaderOf(file).difficultyCount++; });
+    CheckRejected(original, "difficulty of a missing song", [](std::string& file) { SectionOf<uint32_t>(file, Section::DiffSong)[3] = HeaderOf(file).songCount; });
+    CheckRejected(original, "difficulties past the end", [](std::string& file) {
+        auto songCount = HeaderOf(file).songCount;
+        SectionOf<uint32_t>(file, Section::DiffOffset)[songCount - 1] = HeaderOf(file).difficultyCount - SectionOf<uint8_t>(file, Section::DiffCount)[songCount - 1] + 1;
+    });
+    CheckRejected(original, "hash table index out of range", [](std::string& file) {
+        auto table = SectionOf<SongDetailsTestAccess::HashSlot>(file, Section::HashTable);
+        auto slot = std::find_if(table, table + 100, [](const auto& slot) { return slot.index != SongDetailsTestAccess::EMPTY_SLOT; });
+        slot->index = HeaderOf(file).songCount;
+    });
+    CheckRejected(original, "full hash table", [](std::string& file) {
+        auto& info = HeaderOf(file).sections[static_cast<uint32_t>(Section::HashTable)];
+        auto table = SectionOf<SongDetailsTestAccess::HashSlot>(file, Section::HashTable);
+        for (std::size_t i = 0; i < info.size / sizeof(SongDetailsTestAccess::HashSlot); i++) {
+            if (table[i].index == SongDetailsTestAccess::EMPTY_SLOT)
+                table[i].index = 0;
+        }
+    });
+    CheckRejected(original, "hash table not a power of two", [](std::string& file) {
+        HeaderOf(file).sections[static_cast<uint32_t>(Section::HashTable)].size -= sizeof(SongDetailsTestAccess::HashSlot);
+    });
+    CheckRejected(original, "map id table index out of range", [](std::string& file) {
+        auto table = SectionOf<uint32_t>(file, Section::MapIdTable);
+        *std::find_if(table, table + 100, [](uint32_t index) { return index != SongDetailsTestAccess::EMPTY_SLOT; }) = UINT32_MAX - 1;
+    });
+    CheckRejected(original, "map id table not a power of two", [](std::string& file) {
+        HeaderOf(file).sections[static_cast<uint32_t>(Section::MapIdTable)].size = 3 * sizeof(uint32_t);
+    });
+    CheckRejected(original, "song names going backwards", [](std::string& file) { std::swap(SectionOf<uint32_t>(file, Section::SongNames)[1], SectionOf<uint32_t>(file, Section::SongNames)[2]); });
+    CheckRejected(original, "name pool going backwards", [](std::string& file) { std::swap(SectionOf<uint32_t>(file, Section::NamePool)[0], SectionOf<uint32_t>(file, Section::NamePool)[1]); });
+    CheckRejected(original, "search words going backwards", [](std::string& file) { SectionOf<uint32_t>(file, Section::SearchSongWordOffsets)[1] = UINT32_MAX; });
+
+    // The undamaged copy still opens
+    std::ofstream(SongDetailsSnapshot::path(), std::ios::binary | std::ios::trunc) << original;
+    CHECK(SongDetailsSnapshot::Open(SongDetailsSnapshot::path()));
+
+    // What Load_internal does on start with only the cached protobuf and with the snapshot next to it
+    constexpr int coldSongCount = 50000;
+    auto large = MakeDatabase(coldSongCount, 1700000000, 2);
+    ResetCache("SongDetailsSnapshotColdLoad", &large);
+    SongDetailsTestAccess::Process(Compress(large));
+    CHECK(SongDetailsTestAccess::get_state()->columns.songs->size() == coldSongCount && SongDetailsSnapshot::Write(SongDetailsSnapshot::path()));
+    auto fromProtobuf = MedianColdLoad([] {
+        auto cached = DataGetter::ReadCachedDatabase();
+        CHECK(cached);
+        SongDetailsTestAccess::Process(*cached, true);
+    });
+    auto fromSnapshot = MedianColdLoad([] {
+        auto coldSnapshot = SongDetailsSnapshot::Open(SongDetailsSnapshot::path());
+        CHECK(coldSnapshot);
+        SongDetailsTestAccess::Process(*coldSnapshot);
+    });
+    std::printf("Cold load of %d songs: cached protobuf %.1f ms (%+lld KB resident), snapshot %.1f ms (%+lld KB resident)\n", coldSongCount,
+        fromProtobuf.milliseconds, fromProtobuf.residentKB, fromSnapshot.milliseconds, fromSnapshot.residentKB);
+    std::printf("SongDetailsSnapshot OK\n");
+}
@@ -0,0 +1,134 @@
+#include "SongDetailsTestUtils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+static constexpr const int SONG_COUNT = 20000;
+
+/// Every lookup of a state has to land in that same state
+static void CheckState(const SongDetailsTestAccess::State& state) {
+    const auto& columns = state.columns;
+    const auto& songs = *columns.songs;
+    CHECK(columns.keys->size() == songs.size() && columns.hashBytes->size() == songs.size() && columns.songNames->size() == songs.size());
+    CHECK(state.sortedIndexes->songs == columns.songs && state.sortedIndexes->aggregates == columns.songAggregates);
+    for (std::size_t i = 0; i < songs.size(); i += 97) {
+        CHECK(SongDetailsTestAccess::FindHash(columns, (*columns.hashBytes)[i]) == i);
+        CHECK(SongDetailsTestAccess::FindMapId(columns, (*columns.keys)[i]) == i);
+        // The name is generated from the mapId, a song of another database would have another one
+        CHECK((*columns.songNames)[i].starts_with("Song number " + std::to_string((*columns.keys)[i])));
+        CHECK(songs[i].songName() == (*columns.songNames)[i] && songs[i].mapId() == (*columns.keys)[i]);
+        CHECK(songs[i].end() - songs[i].begin() == songs[i].diffCount);
+    }
+}
+
+/// Hash and mapId lookups through the tables against the linear scans over the songs they replaced
+static void BenchmarkLookups(const SongDetailsTestAccess::State& state) {
+    const auto& songs = *state.columns.songs;
+    std::vector<std::size_t> targets;
+    for (std::size_t i = 0; i < 1000; i++)
+        targets.emplace_back(i * 7919 % songs.size());
+    auto nanoseconds = [&](auto lookup) {
+        std::size_t found = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (auto target : targets)
+            found += lookup(target) == &songs[target];
+        CHECK(found == targets.size());
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / targets.size();
+    };
+    const auto& hashes = *state.columns.hashBytes;
+    const auto& keys = *state.columns.keys;
+    double hashTime = nanoseconds([&](std::size_t i) { return &SongDetailsContainer::FindByHash(hashes[i])[0]; });
+    double hashScanTime = nanoseconds([&](std::size_t i) { return &songs[std::find(hashes.begin(), hashes.end(), hashes[i]) - hashes.begin()]; });
+    double mapIdTime = nanoseconds([&](std::size_t i) { return &SongDetailsContainer::FindByMapId(keys[i])[0]; });
+    double mapIdScanTime = nanoseconds([&](std::size_t i) { return &songs[std::find(keys.begin(), keys.end(), keys[i]) - keys.begin()]; });
+    std::printf("lookup in %zu songs: by hash %.0f ns (scan %.0f ns), by mapId %.0f ns (scan %.0f ns)\n", songs.size(), hashTime, hashScanTime, mapIdTime, mapIdScanTime);
+}
+
+int main() {
+    ResetCache("SongDetailsStateTest");
+    CHECK(!SongDetailsTestAccess::get_isDataAvailable());
+    CHECK(SongDetailsContainer::FindByMapId(1).empty());
+
+    auto first = MakeDatabase(SONG_COUNT, 1700000000, 1);
+    SongDetailsTestAccess::Process(Compress(first), true);
+    auto state = SongDetailsTestAccess::get_state();
+    const auto& songs = *state->columns.songs;
+    CHECK(songs.size() == SONG_COUNT);
+    CheckState(*state);
+    for (std::size_t i = 0; i < songs.size(); i++) {
+        auto byHash = SongDetailsContainer::FindByHash((*state->columns.hashBytes)[i]);
+        auto byMapId = SongDetailsContainer::FindByMapId((*state->columns.keys)[i]);
+        CHECK(byHash.size() == 1 && &byHash[0] == &songs[i]);
+        CHECK(byMapId.size() == 1 && &byMapId[0] == &songs[i]);
+    }
+    CHECK(SongDetailsContainer::FindByHash(songs[77].hash()).get_songs() == std::vector{ &songs[77] });
+    CHECK(SongDetailsContainer::FindByHash(std::string_view("zz")).empty());
+    CHECK(SongDetailsContainer::FindByMapId(2).empty());
+    BenchmarkLookups(*state);
+    CHECK(SongDetailsTestAccess::get_songState(Song::none) == nullptr && Song::none.mapId() == 0 && Song::none.begin() == Song::none.end());
+
+    // A copied song lies in no database, it reads the current one by index like the getters always did
+    for (std::size_t i : { std::size_t(0), std::size_t(5), songs.size() - 1 }) {
+        Song copy = songs[i];
+        CHECK(SongDetailsTestAccess::get_songState(copy) == state.get());
+        CHECK(copy.mapId() == songs[i].mapId() && copy.songName() == songs[i].songName() && copy.hash() == songs[i].hash());
+        CHECK(copy.songAuthorName() == songs[i].songAuthorName() && copy.rating() == songs[i].rating() && copy.maxNJS() == songs[i].maxNJS());
+        CHECK(std::distance(copy.begin(), copy.end()) == songs[i].diffCount && &*copy.begin() == &*songs[i].begin());
+    }
+
+    // A song of a database that was replaced keeps reading its own columns for as long as someone holds them
+    const Song& oldSong = songs[123];
+    auto oldName = oldSong.songName();
+    auto oldMapId = oldSong.mapId();
+    auto oldDiffCount = std::distance(oldSong.begin(), oldSong.end());
+    auto found = SongDetailsContainer::FindByMapId(oldMapId);
+    auto second = MakeDatabase(SONG_COUNT / 2, 1700000001, 2);
+    SongDetailsTestAccess::Process(Compress(second), true);
+    CHECK(SongDetailsTestAccess::get_state() != state && SongDetailsTestAccess::get_state()->columns.songs->size() == SONG_COUNT / 2);
+    CHECK(SongDetailsTestAccess::get_songState(oldSong) == state.get());
+    CHECK(oldSong.songName() == oldName && oldSong.mapId() == oldMapId && std::distance(oldSong.begin(), oldSong.end()) == oldDiffCount);
+    std::weak_ptr<const SongDetailsTestAccess::State> released = state;
+    state.reset();
+    // The getters may still read it through currentState until the next update, a found song until its list is gone
+    CHECK(!released.expired());
+    SongDetailsTestAccess::Process(Compress(first), true);
+    CHECK(!released.expired() && &found[0] == &oldSong && found[0].songName() == oldName);
+    found = SongList();
+    CHECK(released.expired());
+
+    // Readers take one state per query while the database gets replaced underneath them
+    auto databases = std::array{ Compress(first), Compress(second) };
+    std::atomic<bool> done = false;
+    std::atomic<std::size_t> queries = 0;
+    std::vector<std::thread> readers;
+    for (int reader = 0; reader < 3; reader++) {
+        readers.emplace_back([&] {
+            while (!done) {
+                CheckState(*SongDetailsTestAccess::get_state());
+                DifficultyQuery query;
+                query.njs = { 16.0f, 20.0f };
+                SongDetailsContainer::CountSongs(query);
+                SongDetailsContainer::Search("camellia extended", 20);
+                SongDetailsContainer::TopSongs(SongSortKey::Rating, 20);
+                queries++;
+            }
+        });
+    }
+    for (int i = 0; i < 20; i++)
+        SongDetailsTestAccess::Process(databases[i % 2], true);
+    done = true;
+    for (auto& reader : readers)
+        reader.join();
+    CheckState(*SongDetailsTestAccess::get_state());
+
+    // Nothing holds the replaced states anymore, except for the pin on the one the current state replaced
+    {
+        std::lock_guard<std::mutex> lock(SongDetailsTestAccess::generationsMutex);
+        const auto& generations = SongDetailsTestAccess::generations;
+        CHECK(std::count_if(generations.begin(), generations.end(), [](const auto& generation) { return !generation.state.expired(); }) == 2);
+        CHECK(std::count_if(generations.begin(), generations.end(), [](const auto& generation) { return generation.pinned != nullptr; }) == 2);
+        CHECK(generations.back().state.lock() == SongDetailsTestAccess::get_state());
+    }
+    std::printf("SongDetailsState OK, %zu queries during 20 publishes\n", queries.load());
+}
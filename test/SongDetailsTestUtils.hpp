@@ -0,0 +1,159 @@
+#pragma once
+// Builds databases for the song details tests and compares processed columns.
+// The tests look at the columns directly, the headers befriend SongDetailsTestAccess for that
+#include "song-details/shared/Data/Song.hpp"
+#include "SongProto.pb.h"
+#include "Check.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <zlib.h>
+
+#include "Data/SongDetailsContainer.hpp"
+#include "Data/SongDetailsSnapshot.hpp"
+#include "Data/DataGetter.hpp"
+
+namespace SongDetailsCache {
+    /// The internals the tests use, under names anything in the test can reach
+    struct SongDetailsTestAccess {
+        using State = SongDetailsContainer::State;
+        using Columns = SongDetailsContainer::Columns;
+        using HashSlot = SongDetailsContainer::HashSlot;
+        using DifficultyColumns = SongDetailsContainer::DifficultyColumns;
+        using SnapshotHeader = SongDetailsSnapshot::Header;
+        static constexpr const uint32_t EMPTY_SLOT = SongDetailsContainer::EMPTY_SLOT;
+
+        static inline std::filesystem::path& basePath = DataGetter::basePath;
+        static inline unsigned int& processThreadCount = SongDetailsContainer::processThreadCount;
+        static inline std::mutex& generationsMutex = SongDetailsContainer::generationsMutex;
+        static inline const std::vector<SongDetailsContainer::Generation>& generations = SongDetailsContainer::generations;
+
+        template<typename... Args>
+        static void Process(Args&&... args) { SongDetailsContainer::Process(std::forward<Args>(args)...); }
+        static bool ApplyDelta(const Structs::SongProtoContainer& delta) { return SongDetailsContainer::ApplyDelta(delta); }
+        static std::shared_ptr<const State> get_state() { return SongDetailsContainer::get_state(); }
+        static const State* get_songState(const Song& song) { return SongDetailsContainer::get_songState(song); }
+        static bool get_isDataAvailable() { return SongDetailsContainer::get_isDataAvailable(); }
+        static std::optional<std::size_t> FindHash(const Columns& columns, const SongHash& hash) { return SongDetailsContainer::FindHash(columns, hash); }
+        static std::optional<std::size_t> FindMapId(const Columns& columns, uint32_t mapId) { return SongDetailsContainer::FindMapId(columns, mapId); }
+
+        static bool SameArrays(const SongSearchIndex& a, const SongSearchIndex& b) {
+            return a.byRank == b.byRank && a.vocabulary == b.vocabulary && a.wordOffsets == b.wordOffsets && a.songWordOffsets == b.songWordOffsets &&
+                a.songWords == b.songWords && a.postingOffsets == b.postingOffsets && a.postings == b.postings;
+        }
+    };
+}
+
+using namespace SongDetailsCache;
+
+/// What WebUtil::GetAsync answers for each url, anything else is a 404
+extern std::unordered_map<std::string, std::string> webResponses;
+
+inline std::string Gzip(const std::string& data) {
+    z_stream stream{};
+    deflateInit2(&stream, 6, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    std::string compressed(deflateBound(&stream, data.size()), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = data.size();
+    stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+    stream.avail_out = compressed.size();
+    deflate(&stream, Z_FINISH);
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    return compressed;
+}
+
+/// Random song with mapId, the names repeat like real authors and mappers do
+inline void FillSong(Structs::SongProto* song, uint32_t mapId, std::mt19937& rng) {
+    static const char* authors[] = { "Camellia", "Kobaryo", "xi", "Lindsey Stirling", "Äphex Twin", "Rëol" };
+    static const char* mappers[] = { "Joetastic", "Nolanimations", "Hexagonial", "Fatbeanzoop" };
+    song->set_mapid(mapId);
+    song->set_bpm(60 + rng() % 200);
+    song->set_downloadcount(rng() % 100000);
+    song->set_upvotes(rng() % 5000);
+    song->set_downvotes(rng() % 500);
+    song->set_uploadtimeunix(1500000000 + rng() % 200000000);
+    song->set_rankedchangeunix(rng() % 3 ? 0 : 1600000000 + rng() % 10000000);
+    song->set_songdurationseconds(60 + rng() % 400);
+    song->set_rankedstate(rng() % 4);
+    std::string hash(sizeof(SongHash), '\0');
+    for (auto& byte : hash)
+        byte = rng();
+    song->set_hashbytes(hash);
+    song->set_songname("Song number " + std::to_string(mapId) + (mapId % 3 ? " (Extended Mix)" : ""));
+    song->set_songauthorname(authors[rng() % std::size(authors)]);
+    song->set_levelauthorname(mappers[rng() % std::size(mappers)]);
+    song->set_uploadername(mappers[rng() % std::size(mappers)]);
+    int diffCount = 1 + rng() % 5;
+    for (int i = 0; i < diffCount; i++) {
+        auto diff = song->add_difficulties();
+        diff->set_characteristic(1 + rng() % 3);
+        diff->set_difficulty(i);
+        diff->set_starst100(song->rankedstate() == 1 ? rng() % 1400 : 0);
+        diff->set_njst100(1000 + rng() % 1500);
+        diff->set_notes(rng() % 3000);
+        diff->set_bombs(rng() % 100);
+        diff->set_obstacles(rng() % 100);
+        diff->set_mods(rng() % 16);
+    }
+}
+
+/// count songs with the mapIds 1, 4, 7, ...
+inline Structs::SongProtoContainer MakeDatabase(int count, uint64_t scrapeEnded = 1700000000, uint32_t seed = 1) {
+    std::mt19937 rng(seed);
+    Structs::SongProtoContainer container;
+    container.set_formatversion(1);
+    container.set_scrapeendedtimeunix(scrapeEnded);
+    for (int i = 0; i < count; i++)
+        FillSong(container.add_songs(), i * 3 + 1, rng);
+    return container;
+}
+
+inline std::vector<uint8_t> Compress(const Structs::SongProtoContainer& container) {
+    auto compressed = Gzip(container.SerializeAsString());
+    return { compressed.begin(), compressed.end() };
+}
+
+/// Fresh cache directory for one test, with the database in it if there is one
+inline void ResetCache(const char* name, const Structs::SongProtoContainer* database = nullptr) {
+    auto path = std::filesystem::temp_directory_path() / "cinema_tests" / name;
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+    SongDetailsTestAccess::basePath = path;
+    if (database)
+        std::ofstream(DataGetter::cachePath(), std::ios::binary) << Gzip(database->SerializeAsString());
+}
+
+inline void CheckSameColumns(const SongDetailsTestAccess::Columns& a, const SongDetailsTestAccess::Columns& b) {
+    CHECK(a.songs->size() == b.songs->size() && a.difficulties->size() == b.difficulties->size());
+    CHECK(*a.keys == *b.keys && *a.hashBytesLUT == *b.hashBytesLUT && *a.mapIdTable == *b.mapIdTable && *a.songNames == *b.songNames);
+    CHECK(a.hashTable->size() == b.hashTable->size() && std::memcmp(a.hashTable->data(), b.hashTable->data(), a.hashTable->size() * sizeof(SongDetailsTestAccess::HashSlot)) == 0);
+    CHECK(std::memcmp(a.hashBytes->data(), b.hashBytes->data(), a.hashBytes->size() * sizeof(SongHash)) == 0);
+    for (std::size_t i = 0; i < a.songs->size(); i++) {
+        CHECK(a.names->get((*a.songAuthorNames)[i]) == b.names->get((*b.songAuthorNames)[i]));
+        CHECK(a.names->get((*a.levelAuthorNames)[i]) == b.names->get((*b.levelAuthorNames)[i]));
+        CHECK(a.names->get((*a.uploaderNames)[i]) == b.names->get((*b.uploaderNames)[i]));
+        auto& x = (*a.songs)[i];
+        auto& y = (*b.songs)[i];
+        CHECK(x.index == y.index && x.diffOffset == y.diffOffset && x.diffCount == y.diffCount && x.bpm == y.bpm);
+        CHECK(x.downloadCount == y.downloadCount && x.upvotes == y.upvotes && x.downvotes == y.downvotes && x.uploadTimeUnix == y.uploadTimeUnix);
+        CHECK(x.rankedChangeUnix == y.rankedChangeUnix && x.songDurationSeconds == y.songDurationSeconds && x.rankedStatus == y.rankedStatus);
+    }
+    for (std::size_t i = 0; i < a.difficulties->size(); i++) {
+        auto& x = (*a.difficulties)[i];
+        auto& y = (*b.difficulties)[i];
+        CHECK(x.songIndex == y.songIndex && x.characteristic == y.characteristic && x.difficulty == y.difficulty && x.stars == y.stars && x.njs == y.njs);
+        CHECK(x.bombs == y.bombs && x.notes == y.notes && x.obstacles == y.obstacles && x.mods == y.mods);
+    }
+}
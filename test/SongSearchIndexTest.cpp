@@ -0,0 +1,140 @@
+#include "SongDetailsTestUtils.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <numeric>
+
+static std::vector<std::string> Words(const std::string& normalized) {
+    std::vector<std::string> words;
+    for (std::size_t start = 0; start < normalized.size();) {
+        auto end = std::min(normalized.find(' ', start), normalized.size());
+        if (end > start)
+            words.emplace_back(normalized.substr(start, end - start));
+        start = end + 1;
+    }
+    return words;
+}
+
+/// Made up words out of a few syllables, some accented or in other scripts, so prefixes are shared a lot
+static std::string Word(uint32_t seed) {
+    static const char* syllables[] = { "ka", "ri", "to", "mel", "sun", "ne", "on", "dra", "zé", "lo", "vi", "ça", "Ña", "qu", "x", "be", "at", "ス" };
+    std::mt19937 rng(seed);
+    std::string word;
+    for (int i = 1 + rng() % 4; i > 0; i--)
+        word += syllables[rng() % std::size(syllables)];
+    if (rng() % 3 == 0)
+        word[0] = std::toupper(word[0]);
+    return word;
+}
+
+int main() {
+    CHECK(SongSearchIndex::Normalize("Ünïcödé Ärtist") == "unicode artist");
+    CHECK(SongSearchIndex::Normalize("ＡＢＣ！def") == "abc def");
+    CHECK(SongSearchIndex::Normalize("Łódź – Straße") == "lodz   strase");
+    CHECK(SongSearchIndex::Normalize("ПРИВЕТ") == "привет");
+    // A combining accent is dropped, a cut off sequence turns into a space
+    CHECK(SongSearchIndex::Normalize("e\xCC\x81t\xC3") == "et ");
+
+    ResetCache("SongSearchIndexTest");
+    // Nothing to search before the first database is in
+    CHECK(SongDetailsContainer::Search("ka", 50).empty() && SongDetailsContainer::Search("", 50).empty());
+
+    auto database = MakeDatabase(30000);
+    std::mt19937 rng(7);
+    auto zipf = [&](int distinct) { return static_cast<uint32_t>(std::pow(distinct, std::uniform_real_distribution<>(0, 1)(rng))); };
+    for (auto& song : *database.mutable_songs()) {
+        std::string title;
+        for (int i = 1 + rng() % 5; i > 0; i--)
+            title += (title.empty() ? "" : rng() % 4 ? " " : " - ") + Word(zipf(20000));
+        song.set_songname(title);
+        song.set_songauthorname(Word(zipf(40000)) + " " + Word(zipf(40000)));
+        song.set_levelauthorname(Word(zipf(15000) + 100000));
+        song.set_uploadername(rng() % 5 ? song.levelauthorname() : Word(zipf(15000) + 100000));
+    }
+    SongDetailsTestAccess::Process(database, true);
+    auto state = SongDetailsTestAccess::get_state();
+    const auto& songs = *state->columns.songs;
+
+    // Every song checked against every query word, best rated first, then most downloaded
+    std::vector<std::vector<std::string>> words(songs.size());
+    for (std::size_t i = 0; i < songs.size(); i++) {
+        for (auto name : { &songs[i].songName(), &songs[i].songAuthorName(), &songs[i].levelAuthorName(), &songs[i].uploaderName() }) {
+            for (auto& word : Words(SongSearchIndex::Normalize(*name)))
+                words[i].emplace_back(std::move(word));
+        }
+    }
+    std::vector<uint32_t> ranked(songs.size());
+    std::iota(ranked.begin(), ranked.end(), 0);
+    std::stable_sort(ranked.begin(), ranked.end(), [&](uint32_t a, uint32_t b) {
+        if (songs[a].rating() != songs[b].rating())
+            return songs[a].rating() > songs[b].rating();
+        return songs[a].downloadCount > songs[b].downloadCount;
+    });
+    auto scan = [&](const std::string& query, std::size_t limit) {
+        std::vector<uint32_t> found;
+        auto queryWords = Words(SongSearchIndex::Normalize(query));
+        if (queryWords.empty())
+            return found;
+        for (auto song : ranked) {
+            bool matches = std::all_of(queryWords.begin(), queryWords.end(), [&](const auto& queryWord) {
+                return std::any_of(words[song].begin(), words[song].end(), [&](const auto& word) { return word.starts_with(queryWord); });
+            });
+            if (matches && found.emplace_back(song) && found.size() == limit)
+                break;
+        }
+        return found;
+    };
+
+    std::vector<std::string> queries = { "k", "ka", "kar", "kari", "x", "xx", "ç", "C", "za", "zé", "ZE", "mel sun", "Ña ka", "ス", "スス", "q", "quq", "quqx", "vi - lo", "", "  ", "zzz", "bezé", "at at" };
+    for (int i = 0; i < 200; i++) {
+        const auto& songWords = words[rng() % songs.size()];
+        const auto& word = songWords[rng() % songWords.size()];
+        queries.emplace_back(word.substr(0, 1 + rng() % word.size()));
+    }
+    for (const auto& query : queries) {
+        for (std::size_t limit : { 1, 10, 50, 100000 }) {
+            std::vector<uint32_t> found;
+            for (auto song : SongDetailsContainer::Search(query, limit))
+                found.emplace_back(song->index);
+            CHECK(found == scan(query, limit));
+        }
+    }
+
+    // Latency by query length, against looking for the query in every name
+    for (std::size_t length = 1; length <= 4; length++) {
+        std::vector<std::string> prefixes;
+        for (int i = 0; i < 500; i++) {
+            const auto& songWords = words[rng() % songs.size()];
+            const auto& word = songWords[rng() % songWords.size()];
+            if (word.size() >= length)
+                prefixes.emplace_back(word.substr(0, length));
+        }
+        std::vector<double> times;
+        for (const auto& prefix : prefixes) {
+            auto start = std::chrono::steady_clock::now();
+            SongDetailsContainer::Search(prefix, 50);
+            times.emplace_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(times.begin(), times.end());
+        auto start = std::chrono::steady_clock::now();
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < 20; i++) {
+            for (const auto& song : songs) {
+                for (auto name : { &song.songName(), &song.songAuthorName(), &song.levelAuthorName(), &song.uploaderName() })
+                    hits += name->find(prefixes[i]) != std::string::npos;
+            }
+        }
+        double scanTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / 20;
+        std::printf("%zu characters: median %.1f us, p99 %.1f us (string scan %.0f us, %zu hits)\n", length, times[times.size() / 2], times[times.size() * 99 / 100], scanTime, hits);
+    }
+
+    // The snapshot keeps the index as it is
+    CHECK(SongDetailsSnapshot::Write(SongDetailsSnapshot::path()));
+    auto snapshot = SongDetailsSnapshot::Open(SongDetailsSnapshot::path());
+    CHECK(snapshot);
+    SongSearchIndex mapped(*snapshot);
+    const auto& built = *state->columns.searchIndex;
+    CHECK(SongDetailsTestAccess::SameArrays(mapped, built));
+    std::printf("SongSearchIndex OK\n");
+}
@@ -0,0 +1,107 @@
+#include "SongDetailsTestUtils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+static double Value(SongSortKey key, const Song& song) {
+    switch (key) {
+        case SongSortKey::UploadTime: return song.uploadTimeUnix;
+        case SongSortKey::RankedChange: return song.rankedChangeUnix;
+        case SongSortKey::Rating: return song.rating();
+        case SongSortKey::DownloadCount: return song.downloadCount;
+        case SongSortKey::Bpm: return song.bpm;
+        default: return song.songDurationSeconds;
+    }
+}
+
+/// Every song through a partial sort, ties by index like the sorted orders
+static std::vector<const Song*> Scan(const std::vector<Song>& songs, SongSortKey key, double min, double max, std::size_t limit, bool descending) {
+    std::vector<std::pair<double, const Song*>> matches;
+    for (const auto& song : songs) {
+        auto value = Value(key, song);
+        if (value >= min && value <= max)
+            matches.emplace_back(value, &song);
+    }
+    auto less = [](const auto& a, const auto& b) { return a.first != b.first ? a.first < b.first : a.second->index < b.second->index; };
+    auto count = std::min(limit, matches.size());
+    if (descending)
+        std::partial_sort(matches.begin(), matches.begin() + count, matches.end(), [&](const auto& a, const auto& b) { return less(b, a); });
+    else
+        std::partial_sort(matches.begin(), matches.begin() + count, matches.end(), less);
+    std::vector<const Song*> l;
+    for (std::size_t i = 0; i < count; i++)
+        l.emplace_back(matches[i].second);
+    return l;
+}
+
+/// Median of 21 runs
+template<typename Function>
+static double Microseconds(Function function) {
+    std::vector<double> times;
+    for (int i = 0; i < 21; i++) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        times.emplace_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+int main() {
+    ResetCache("SongSortIndexesTest");
+    CHECK(SongDetailsContainer::TopSongs(SongSortKey::Bpm, 5).empty());
+    SongDetailsTestAccess::Process(MakeDatabase(20000, 1700000000, 1), true);
+    auto state = SongDetailsTestAccess::get_state();
+    const auto& songs = *state->columns.songs;
+
+    // The first query of a key sorts the songs once, after that a query is a binary search against the scan it replaces
+    const char* keyNames[] = { "upload time", "ranked change", "rating", "downloads", "bpm", "duration" };
+    static_assert(std::size(keyNames) == static_cast<std::size_t>(SongSortKey::Count));
+    for (int k = 0; k < static_cast<int>(SongSortKey::Count); k++) {
+        auto key = static_cast<SongSortKey>(k);
+        auto start = std::chrono::steady_clock::now();
+        SongDetailsContainer::TopSongs(key, 50);
+        double buildTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        auto sorted = Scan(songs, key, -INFINITY, INFINITY, songs.size(), false);
+        double min = Value(key, *sorted[songs.size() / 2]), max = Value(key, *sorted[songs.size() / 2 + 100]);
+        double topTime = Microseconds([&] { SongDetailsContainer::TopSongs(key, 50); });
+        double topScanTime = Microseconds([&] { Scan(songs, key, -INFINITY, INFINITY, 50, true); });
+        double rangeTime = Microseconds([&] { SongDetailsContainer::FindSongsInRange(key, min, max, 50); });
+        double rangeScanTime = Microseconds([&] { Scan(songs, key, min, max, 50, false); });
+        std::printf("%s: first query %.1f ms, top 50 %.1f us (scan %.0f us), 50 in range %.1f us (scan %.0f us)\n",
+            keyNames[k], buildTime, topTime, topScanTime, rangeTime, rangeScanTime);
+    }
+
+    std::mt19937 rng(5);
+    for (int k = 0; k < static_cast<int>(SongSortKey::Count); k++) {
+        auto key = static_cast<SongSortKey>(k);
+        for (int i = 0; i < 40; i++) {
+            double min = Value(key, songs[rng() % songs.size()]), max = Value(key, songs[rng() % songs.size()]);
+            if (min > max)
+                std::swap(min, max);
+            std::size_t limit = i % 3 == 0 ? std::numeric_limits<std::size_t>::max() : rng() % 200;
+            bool descending = i % 2;
+            CHECK(SongDetailsContainer::FindSongsInRange(key, min, max, limit, descending).get_songs() == Scan(songs, key, min, max, limit, descending));
+        }
+        CHECK(SongDetailsContainer::TopSongs(key, 50).get_songs() == Scan(songs, key, -INFINITY, INFINITY, 50, true));
+        CHECK(SongDetailsContainer::TopSongs(key, 50, false).get_songs() == Scan(songs, key, -INFINITY, INFINITY, 50, false));
+        CHECK(SongDetailsContainer::FindSongsInRange(key, 2, 1).empty());
+    }
+    CHECK(SongDetailsContainer::FindSongsInRange(SongSortKey::Count, -INFINITY, INFINITY).empty());
+
+    // A new database starts without orders, the lists of the old one still read the old songs
+    auto newest = SongDetailsContainer::TopSongs(SongSortKey::UploadTime, 10);
+    auto newestUploadTime = newest[0].uploadTimeUnix;
+    std::weak_ptr<const SongDetailsTestAccess::State> old = state;
+    state.reset();
+    SongDetailsTestAccess::Process(MakeDatabase(100, 1700000001, 2), true);
+    CHECK(SongDetailsTestAccess::get_state()->sortedIndexes->orders[static_cast<std::size_t>(SongSortKey::UploadTime)].empty());
+    // The next update unpins the old state, only the list holds it then
+    SongDetailsTestAccess::Process(MakeDatabase(100, 1700000002, 3), true);
+    CHECK(!old.expired() && newest[0].uploadTimeUnix == newestUploadTime && newest[0].songName().starts_with("Song number " + std::to_string(newest[0].mapId())));
+    CHECK(SongDetailsContainer::TopSongs(SongSortKey::UploadTime, 1000).size() == 100);
+    newest = SongList();
+    CHECK(old.expired());
+    std::printf("SongSortIndexes OK\n");
+}
@@ -0,0 +1,51 @@
+#include "Data/StringPool.hpp"
+#include "Check.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+
+using namespace SongDetailsCache;
+
+int main() {
+    StringPool pool;
+    CHECK(pool.size() == 0);
+    auto empty = pool.Intern(std::string_view());
+    auto camellia = pool.Intern(std::string_view("Camellia"));
+    CHECK(empty == 0 && camellia == 1 && pool.size() == 2);
+    CHECK(pool.Intern(std::string("Camellia")) == camellia && pool.Intern(std::string_view("")) == empty);
+    CHECK(pool.get(camellia) == "Camellia" && pool.get(empty).empty());
+    // Only equal strings share an id, a prefix or an embedded zero is another name
+    CHECK(pool.Intern(std::string_view("Camelli")) != camellia);
+    CHECK(pool.Intern(std::string_view("Camellia\0x", 10)) != camellia && pool.get(pool.Intern(std::string_view("Camellia\0x", 10))).size() == 10);
+
+    // Ids stay dense and stable while the table grows, against a std::unordered_map doing the same
+    StringPool names;
+    std::unordered_map<std::string, uint32_t> reference;
+    std::mt19937 rng(11);
+    std::size_t heapBytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 300000; i++) {
+        // Few distinct names that show up often, like mappers
+        auto name = "Mapper " + std::to_string(static_cast<int>(std::pow(50000.0, std::uniform_real_distribution<>(0, 1)(rng)))) + std::string(rng() % 24, 'x');
+        auto [entry, added] = reference.try_emplace(name, reference.size());
+        if (added && name.capacity() > std::string().capacity())
+            heapBytes += name.capacity() + 1;
+        auto id = i % 2 ? names.Intern(std::string(name)) : names.Intern(std::string_view(name));
+        CHECK(id == entry->second);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    CHECK(names.size() == reference.size());
+    for (const auto& [name, id] : reference)
+        CHECK(names.get(id) == name);
+    CHECK(names.get_byteSize() >= names.size() * sizeof(std::string) + heapBytes);
+    std::printf("300000 names, %zu distinct in %zu KB, interned in %lld ms\n", names.size(), names.get_byteSize() / 1024, static_cast<long long>(elapsed));
+
+    // Reserving up front doesn't change any id
+    StringPool reserved;
+    reserved.reserve(reference.size());
+    for (uint32_t id = 0; id < names.size(); id++)
+        CHECK(reserved.Intern(std::string_view(names.get(id))) == id);
+    std::printf("StringPool OK\n");
+}
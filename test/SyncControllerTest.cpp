@@ -0,0 +1,107 @@
+#include "VideoSync.hpp"
+#include "Check.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+using namespace Cinema;
+
+struct Result {
+    int seeks = 0;
+    int speedChanges = 0;
+    /// Corrections asked for while the song was at a part the video can't show
+    int unreachableCorrections = 0;
+    /// Largest distance of the video to where it should be once it had a second to lock on
+    double maxError = 0.0;
+};
+
+/// Runs a player next to a song at 72 fps with jittery frames and clock readings
+/// The player loops back to loopStart by itself like the coroutine and the unity VideoPlayer do
+static Result Simulate(SyncController::Settings settings, double songLength, double videoStart, double decoderRate, double songJump = -1.0) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> jitter(-0.002, 0.002);
+    SyncController controller(settings);
+    Result result;
+    double songTime = 0.0, videoTime = videoStart, lockedAt = 1.0;
+    float speed = 1.0f;
+    for(double frameTime = 1.0 / 72.0; songTime < songLength;) {
+        double deltaTime = frameTime + jitter(rng);
+        songTime += deltaTime;
+        if(songJump > 0.0 && songTime >= songJump && songTime - deltaTime < songJump) {
+            songTime += 10.0;
+            lockedAt = songTime + 1.0;
+        }
+        videoTime += deltaTime * speed * decoderRate;
+        if(settings.length > 0.0 && videoTime >= settings.length)
+            videoTime = settings.loop ? videoTime - settings.length + settings.loopStart : settings.length;
+
+        double target = songTime + settings.offset;
+        bool reachable = target >= 0.0 && (settings.loop || target <= settings.length);
+        auto correction = controller.Update(songTime, videoTime + jitter(rng), deltaTime);
+        if(correction.action == SyncController::Action::Seek) {
+            result.seeks++;
+            videoTime = correction.seekTime;
+            lockedAt = songTime + 1.0;
+        } else if(correction.action == SyncController::Action::SetSpeed) {
+            result.speedChanges++;
+            speed = correction.speed;
+        }
+        if(!reachable && correction.action != SyncController::Action::None && !(correction.action == SyncController::Action::SetSpeed && correction.speed == 1.0f))
+            result.unreachableCorrections++;
+        if(reachable && songTime >= lockedAt) {
+            if(settings.loop && target >= settings.length)
+                target = settings.loopStart + std::fmod(target - settings.loopStart, settings.length - settings.loopStart);
+            double error = std::abs(videoTime - target);
+            error = std::min(error, std::abs(error - (settings.length - settings.loopStart)));
+            result.maxError = std::max(result.maxError, error);
+        }
+    }
+    return result;
+}
+
+int main() {
+    SyncController::Settings looping;
+    looping.length = 30.0;
+
+    // The player starts over on its own every 30 s, the controller follows it instead of seeking back
+    auto result = Simulate(looping, 125.0, 0.05, 1.0);
+    std::printf("loop: %d seeks, %d speed changes, %.1f ms max error\n", result.seeks, result.speedChanges, result.maxError * 1000.0);
+    CHECK(result.seeks == 0 && result.maxError < looping.nudgeThreshold);
+
+    // A decoder a bit too fast is nudged back, through every loop
+    result = Simulate(looping, 125.0, 0.0, 1.004);
+    std::printf("fast decoder: %d seeks, %d speed changes, %.1f ms max error\n", result.seeks, result.speedChanges, result.maxError * 1000.0);
+    CHECK(result.seeks == 0 && result.speedChanges > 0 && result.maxError < looping.nudgeThreshold + 0.02);
+
+    // Looping a trimmed part, the target starts over at the start trim like the video
+    auto trimmed = looping;
+    trimmed.loopStart = 10.0;
+    trimmed.length = 20.0;
+    trimmed.offset = 10.0;
+    result = Simulate(trimmed, 60.0, 10.0, 1.0);
+    CHECK(result.seeks == 0 && result.maxError < trimmed.nudgeThreshold);
+
+    // Once the song is past the end of a video that doesn't loop there is nothing left to correct
+    auto once = looping;
+    once.loop = false;
+    result = Simulate(once, 60.0, 0.0, 1.004);
+    CHECK(result.seeks == 0 && result.unreachableCorrections == 0);
+
+    // A video that starts later than the song plays from its first frame right away, it is only moved once it should start
+    auto late = looping;
+    late.offset = -5.0;
+    result = Simulate(late, 40.0, 0.0, 1.0);
+    std::printf("negative offset: %d seeks, %.1f ms max error\n", result.seeks, result.maxError * 1000.0);
+    CHECK(result.seeks == 1 && result.unreachableCorrections == 0 && result.maxError < late.nudgeThreshold);
+
+    // A jump in the song is one seek, then it locks on again
+    result = Simulate(looping, 80.0, 0.0, 1.0, 20.0);
+    CHECK(result.seeks == 1 && result.maxError < looping.nudgeThreshold);
+
+    // Without a length yet it keeps the plain song time
+    SyncController::Settings unknown;
+    result = Simulate(unknown, 20.0, 0.1, 1.0);
+    CHECK(result.seeks == 0 && result.maxError < unknown.nudgeThreshold);
+    std::printf("SyncController OK\n");
+}
@@ -0,0 +1,110 @@
+#include "VLCPlayer.hpp"
+#include "Check.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Cinema;
+using namespace UnityEngine;
+
+Logger& getLogger() {
+    static Logger logger;
+    return logger;
+}
+
+static constexpr const int FRAME_RATE = 30;
+static constexpr const int FRAME_COUNT = 90;
+/// How often the game calls UploadFrame
+static constexpr const auto UPLOAD_INTERVAL = std::chrono::microseconds(1000000 / 90);
+static constexpr const auto TIMEOUT = std::chrono::seconds(10);
+
+/// Uncompressed 4:2:0 clip with a brightness ramp, libvlc demuxes it without any codec
+static std::string WriteClip(const char* name, int width, int height) {
+    auto path = std::filesystem::temp_directory_path() / "cinema_tests" / "VLCPlayerTest";
+    std::filesystem::create_directories(path);
+    path /= name;
+    std::ofstream file(path, std::ios::binary);
+    file << "YUV4MPEG2 W" << width << " H" << height << " F" << FRAME_RATE << ":1 Ip A1:1 C420jpeg\n";
+    std::vector<char> luma(width * height);
+    std::vector<char> chroma(width * height / 2, static_cast<char>(128));
+    for(int frame = 0; frame < FRAME_COUNT; frame++) {
+        std::fill(luma.begin(), luma.end(), static_cast<char>(16 + frame * 2));
+        file << "FRAME\n";
+        file.write(luma.data(), luma.size());
+        file.write(chroma.data(), chroma.size());
+    }
+    return path.string();
+}
+
+/// Calls UploadFrame like the game does until condition holds
+/// @return the number of uploaded frames
+template<typename Condition>
+static int Pump(VLCPlayer& player, Condition condition) {
+    int uploads = 0;
+    auto start = std::chrono::steady_clock::now();
+    while(!condition()) {
+        CHECK(std::chrono::steady_clock::now() - start < TIMEOUT);
+        if(player.UploadFrame())
+            uploads++;
+        std::this_thread::sleep_for(UPLOAD_INTERVAL);
+    }
+    return uploads;
+}
+
+int main() {
+    auto large = WriteClip("large.y4m", 320, 180);
+    auto small = WriteClip("small.y4m", 160, 90);
+
+    Renderer renderer;
+    {
+        VLCPlayer player;
+        player.set_renderer(&renderer);
+        auto& material = *renderer.get_sharedMaterial();
+
+        // Prepare decodes up to the first frame, its format goes through the main thread
+        player.set_url(large);
+        player.Prepare();
+        Pump(player, [&] { return player.get_isPrepared() && material.mainTexture && material.mainTexture->applied > 0; });
+        auto texture = material.mainTexture;
+        CHECK(texture->get_height() == 180 && texture->get_width() >= 320);
+        CHECK(material.mainTextureScale.x == 320.0f / texture->get_width());
+        // Opaque RGBA out of the vout
+        CHECK(texture->pixels.size() == static_cast<std::size_t>(texture->get_width() * 180 * 4) && static_cast<uint8_t>(texture->pixels[3]) == 255);
+
+        // The whole clip at the frame rate of the game
+        player.Play();
+        auto start = std::chrono::steady_clock::now();
+        int uploads = Pump(player, [&] {
+            return player.get_frameStats().publishedFrames >= FRAME_COUNT - 1 || std::chrono::steady_clock::now() - start > std::chrono::seconds(FRAME_COUNT / FRAME_RATE + 2);
+        });
+        auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        auto stats = player.get_frameStats();
+        CHECK(stats.publishedFrames > FRAME_COUNT / 2 && uploads > 0 && stats.presentedFrames <= stats.publishedFrames);
+        CHECK(stats.peakOccupancy >= 1 && stats.peakOccupancy <= FrameRing::SLOT_COUNT);
+        std::printf("320x180 clip: decoded %.1f fps, uploaded %.1f fps, dropped %llu, reused %llu slots, peak occupancy %u\n",
+            stats.publishedFrames / seconds, stats.presentedFrames / seconds,
+            (unsigned long long) stats.droppedFrames, (unsigned long long) stats.reusedSlots, stats.peakOccupancy);
+
+        // Another size replaces the texture and releases the old one
+        player.Stop();
+        player.set_url(small);
+        player.Prepare();
+        Pump(player, [&] { return player.get_isPrepared() && material.mainTexture && material.mainTexture->get_height() == 90 && material.mainTexture->applied > 0; });
+        CHECK(Texture2D::created == 2 && Object::destroyed == 1);
+
+        // The same size again keeps the texture
+        texture = material.mainTexture;
+        int applied = texture->applied;
+        player.Stop();
+        player.Prepare();
+        Pump(player, [&] { return player.get_isPrepared() && material.mainTexture->applied > applied; });
+        CHECK(material.mainTexture == texture && Texture2D::created == 2 && Object::destroyed == 1);
+        player.Stop();
+    }
+    std::printf("VLCPlayer OK\n");
+}
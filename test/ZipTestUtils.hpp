@@ -0,0 +1,92 @@
+#pragma once
+// Builds zips in memory for the tests that read them through the zip stand-in
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+struct ZipFile {
+    std::string name;
+    std::string data;
+    /// Libraries are stored like in the shipped zip, everything else is deflated
+    bool deflate = true;
+};
+
+inline void Write16(std::string& out, uint16_t value) {
+    out += static_cast<char>(value);
+    out += static_cast<char>(value >> 8);
+}
+
+inline void Write32(std::string& out, uint32_t value) {
+    Write16(out, value);
+    Write16(out, value >> 16);
+}
+
+inline std::string Deflate(const std::string& data) {
+    z_stream stream{};
+    deflateInit2(&stream, 6, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    std::string compressed(deflateBound(&stream, data.size()), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = data.size();
+    stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+    stream.avail_out = compressed.size();
+    deflate(&stream, Z_FINISH);
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    return compressed;
+}
+
+/// Zip with an entry for every directory of the files, like the shipped python.zip
+inline std::string MakeZip(const std::vector<ZipFile>& files) {
+    std::vector<ZipFile> entries;
+    for(auto& file : files) {
+        for(auto slash = file.name.find('/'); slash != std::string::npos; slash = file.name.find('/', slash + 1)) {
+            auto directory = file.name.substr(0, slash + 1);
+            if(std::none_of(entries.begin(), entries.end(), [&](auto& entry) { return entry.name == directory; }))
+                entries.push_back({ directory, "", false });
+        }
+        entries.emplace_back(file);
+    }
+    std::string zip, central;
+    for(auto& entry : entries) {
+        uint16_t method = entry.deflate ? Z_DEFLATED : 0;
+        auto data = entry.deflate ? Deflate(entry.data) : entry.data;
+        uint32_t crc = crc32(0, reinterpret_cast<const Bytef*>(entry.data.data()), entry.data.size());
+        std::size_t localOffset = zip.size();
+        for(auto out : { &zip, &central }) {
+            Write32(*out, out == &zip ? 0x04034b50 : 0x02014b50);
+            if(out == &central)
+                Write16(*out, 20);
+            Write16(*out, 20);
+            Write16(*out, 0);
+            Write16(*out, method);
+            Write32(*out, 0);
+            Write32(*out, crc);
+            Write32(*out, data.size());
+            Write32(*out, entry.data.size());
+            Write16(*out, entry.name.size());
+            Write16(*out, 0);
+            if(out == &central) {
+                Write16(*out, 0);
+                Write16(*out, 0);
+                Write16(*out, 0);
+                Write32(*out, entry.name.back() == '/' ? 0x10 : 0);
+                Write32(*out, localOffset);
+            }
+            *out += entry.name;
+        }
+        zip += data;
+    }
+    std::size_t centralOffset = zip.size();
+    zip += central;
+    Write32(zip, 0x06054b50);
+    Write16(zip, 0);
+    Write16(zip, 0);
+    Write16(zip, entries.size());
+    Write16(zip, entries.size());
+    Write32(zip, central.size());
+    Write32(zip, centralOffset);
+    Write16(zip, 0);
+    return zip;
+}
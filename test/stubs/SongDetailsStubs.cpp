@@ -0,0 +1,119 @@
+// Host stand-ins for the song-details and beatsaber-hook parts the tests link against.
+// Downloads never reach the network, the database comes from the cache directory and other requests from webResponses
+#include "song-details/shared/Data/Song.hpp"
+#include "Data/SongDetailsContainer.hpp"
+#include "Data/DataGetter.hpp"
+#include "Utils.hpp"
+#include "CustomLogger.hpp"
+#include "SongProto.pb.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+std::unordered_map<std::string, std::string> webResponses;
+
+Logger& getLogger() {
+    static Logger logger;
+    return logger;
+}
+
+namespace SongDetailsCache {
+    SongHash::SongHash() {}
+    SongHash::SongHash(const std::string& str) {
+        std::memcpy(const_cast<uint32_t*>(&c1), str.data(), std::min(str.size(), sizeof(SongHash)));
+    }
+
+    const SongDifficulty SongDifficulty::none(-1, nullptr);
+    SongDifficulty::SongDifficulty(std::size_t songIndex, const Structs::SongDifficultyProto* proto) noexcept :
+        songIndex(songIndex),
+        characteristic(static_cast<MapCharacteristic>(proto ? proto->characteristic() : 0)),
+        difficulty(static_cast<MapDifficulty>(proto ? proto->difficulty() : 0)),
+        stars(proto ? proto->starst100() / 100.0f : 0),
+        njs(proto ? proto->njst100() / 100.0f : 0),
+        bombs(proto ? proto->bombs() : 0),
+        notes(proto ? proto->notes() : 0),
+        obstacles(proto ? proto->obstacles() : 0),
+        mods(static_cast<MapMods>(proto ? proto->mods() : 0))
+        {}
+
+    bool parse(std::string_view string, MapCharacteristic& characteristic) {
+        static const std::pair<std::string_view, MapCharacteristic> names[] = {
+            { "Custom", MapCharacteristic::Custom }, { "Standard", MapCharacteristic::Standard }, { "OneSaber", MapCharacteristic::OneSaber },
+            { "NoArrows", MapCharacteristic::NoArrows }, { "NinetyDegree", MapCharacteristic::NinetyDegree },
+            { "ThreeSixtyDegree", MapCharacteristic::ThreeSixtyDegree }, { "LightShow", MapCharacteristic::LightShow }, { "Lawless", MapCharacteristic::Lawless }
+        };
+        for (auto& [name, value] : names) {
+            if (name == string) {
+                characteristic = value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string HexUtil::ByteArrayToHex(std::span<uint8_t> bytes) {
+        static constexpr const char digits[] = "0123456789ABCDEF";
+        std::string hex;
+        hex.reserve(bytes.size() * 2);
+        for (auto byte : bytes) {
+            hex += digits[byte >> 4];
+            hex += digits[byte & 15];
+        }
+        return hex;
+    }
+
+    static uint8_t HexDigit(char c) {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        throw std::invalid_argument("not a hex digit");
+    }
+
+    std::vector<uint8_t> HexUtil::ToBytes(std::string_view hex) {
+        std::vector<uint8_t> bytes(hex.size() / 2);
+        for (std::size_t i = 0; i < bytes.size(); i++)
+            bytes[i] = HexDigit(hex[i * 2]) << 4 | HexDigit(hex[i * 2 + 1]);
+        return bytes;
+    }
+
+    SongHash HexUtil::ToSongHash(std::string_view hex) {
+        auto bytes = ToBytes(hex);
+        return SongHash(std::string(bytes.begin(), bytes.end()));
+    }
+
+    std::filesystem::path DataGetter::basePath = std::filesystem::temp_directory_path() / "cinema_tests";
+
+    std::filesystem::path DataGetter::cachePath() {
+        return basePath / "SongDetailsCache.proto.gz";
+    }
+
+    std::optional<std::ifstream> DataGetter::ReadCachedDatabase() {
+        std::ifstream stream(cachePath(), std::ios::binary);
+        if (!stream.is_open())
+            return std::nullopt;
+        return stream;
+    }
+
+    bool DataGetter::HasCachedData(int) {
+        return std::filesystem::exists(cachePath());
+    }
+
+    std::future<std::optional<DataGetter::DownloadedDatabase>> DataGetter::UpdateAndReadDatabase(std::string_view) {
+        return std::async(std::launch::deferred, [] { return std::optional<DownloadedDatabase>(); });
+    }
+
+    std::future<void> DataGetter::WriteCachedDatabase(DownloadedDatabase&) {
+        return std::async(std::launch::deferred, [] {});
+    }
+
+    std::future<WebUtil::WebResponse> WebUtil::GetAsync(std::string_view url, uint32_t, const std::unordered_map<std::string, std::string>&) {
+        auto response = webResponses.find(std::string(url));
+        if (response == webResponses.end())
+            return std::async(std::launch::deferred, [] { return WebResponse{ 404, "", "" }; });
+        return std::async(std::launch::deferred, [content = response->second] { return WebResponse{ 200, "", content }; });
+    }
+}
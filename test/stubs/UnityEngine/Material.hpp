@@ -0,0 +1,15 @@
+#pragma once
+#include "UnityEngine/Object.hpp"
+#include "UnityEngine/Texture2D.hpp"
+#include "UnityEngine/Vector2.hpp"
+
+namespace UnityEngine {
+    class Material : public Object {
+        public:
+            void set_mainTexture(Texture2D* texture) { mainTexture = texture; }
+            void set_mainTextureScale(Vector2 scale) { mainTextureScale = scale; }
+
+            Texture2D* mainTexture = nullptr;
+            Vector2 mainTextureScale = { 1.0f, 1.0f };
+    };
+}
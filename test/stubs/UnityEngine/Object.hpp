@@ -0,0 +1,16 @@
+#pragma once
+// Host stand-in for the Unity object, counts what gets destroyed
+
+namespace UnityEngine {
+    class Object {
+        public:
+            virtual ~Object() = default;
+
+            static void Destroy(Object* object) {
+                destroyed++;
+                delete object;
+            }
+
+            static inline int destroyed = 0;
+    };
+}
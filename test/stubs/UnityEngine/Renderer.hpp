@@ -0,0 +1,11 @@
+#pragma once
+#include "UnityEngine/Material.hpp"
+
+namespace UnityEngine {
+    class Renderer : public Object {
+        public:
+            Material* get_sharedMaterial() { return &material; }
+
+            Material material;
+    };
+}
@@ -0,0 +1,41 @@
+#pragma once
+// Host stand-in for the Unity texture, keeps the last upload and counts the textures created
+#include "UnityEngine/Object.hpp"
+#include "UnityEngine/TextureFormat.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace UnityEngine {
+    class Texture2D : public Object {
+        public:
+            static Texture2D* New_ctor(int width, int height, TextureFormat, bool) {
+                created++;
+                return new Texture2D(width, height);
+            }
+
+            int get_width() const { return width; }
+            int get_height() const { return height; }
+            void Apply(bool, bool) { applied++; }
+
+            /// What the LoadRawTextureDataImpl icall does
+            static bool LoadRawTextureData(Texture2D* texture, void* data, int size) {
+                if(size != texture->width * texture->height * 4)
+                    return false;
+                texture->pixels.assign(static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + size);
+                return true;
+            }
+
+            std::vector<uint8_t> pixels;
+            int applied = 0;
+
+            static inline int created = 0;
+
+        private:
+            Texture2D(int width, int height) : width(width), height(height) {}
+
+            int width;
+            int height;
+    };
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace UnityEngine {
+    enum TextureFormat {
+        RGBA32 = 4
+    };
+}
@@ -0,0 +1,166 @@
+// Host stand-in for the read side of the zip library the mod ships, over zlib.
+// Only stored and deflated entries in memory, which is all ExtractZip and the AssetImporter open
+#include "zip.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+namespace {
+    constexpr const uint32_t CENTRAL_HEADER = 0x02014b50;
+    constexpr const uint32_t END_OF_CENTRAL_DIRECTORY = 0x06054b50;
+    constexpr const std::size_t CHUNK_SIZE = 64 * 1024;
+
+    struct Entry {
+        std::string name;
+        uint16_t method;
+        uint32_t crc;
+        uint64_t compressedSize;
+        uint64_t size;
+        uint64_t localOffset;
+    };
+
+    uint16_t Read16(const unsigned char* data) { return data[0] | data[1] << 8; }
+    uint32_t Read32(const unsigned char* data) { return Read16(data) | static_cast<uint32_t>(Read16(data + 2)) << 16; }
+}
+
+struct zip_t {
+    const unsigned char* data;
+    std::size_t size;
+    std::vector<Entry> entries;
+    const Entry* current = nullptr;
+};
+
+extern "C" {
+
+struct zip_t* zip_stream_open(const char* stream, size_t size, int, char mode) {
+    if(mode != 'r' || size < 22)
+        return nullptr;
+    auto data = reinterpret_cast<const unsigned char*>(stream);
+    // The end record is the last thing in the file, followed by a comment of up to 64 KB
+    std::size_t end = size - 22;
+    while(Read32(data + end) != END_OF_CENTRAL_DIRECTORY) {
+        if(end == 0 || size - end > 22 + 0xffff)
+            return nullptr;
+        end--;
+    }
+    auto zip = new zip_t{ data, size };
+    std::size_t offset = Read32(data + end + 16);
+    for(int i = Read16(data + end + 10); i > 0; i--) {
+        if(offset + 46 > size || Read32(data + offset) != CENTRAL_HEADER) {
+            delete zip;
+            return nullptr;
+        }
+        auto header = data + offset;
+        uint16_t nameLength = Read16(header + 28);
+        zip->entries.push_back({ std::string(reinterpret_cast<const char*>(header + 46), nameLength), Read16(header + 10), Read32(header + 16),
+            Read32(header + 20), Read32(header + 24), Read32(header + 42) });
+        offset += 46 + nameLength + Read16(header + 30) + Read16(header + 32);
+    }
+    return zip;
+}
+
+void zip_stream_close(struct zip_t* zip) {
+    delete zip;
+}
+
+ssize_t zip_entries_total(struct zip_t* zip) {
+    return zip->entries.size();
+}
+
+int zip_entry_openbyindex(struct zip_t* zip, size_t index) {
+    if(index >= zip->entries.size())
+        return -1;
+    zip->current = &zip->entries[index];
+    return 0;
+}
+
+int zip_entry_close(struct zip_t* zip) {
+    zip->current = nullptr;
+    return 0;
+}
+
+const char* zip_entry_name(struct zip_t* zip) {
+    return zip->current ? zip->current->name.c_str() : nullptr;
+}
+
+int zip_entry_isdir(struct zip_t* zip) {
+    return zip->current && !zip->current->name.empty() && zip->current->name.back() == '/';
+}
+
+unsigned long long zip_entry_size(struct zip_t* zip) {
+    return zip->current ? zip->current->size : 0;
+}
+
+unsigned int zip_entry_crc32(struct zip_t* zip) {
+    return zip->current ? zip->current->crc : 0;
+}
+
+int zip_entry_extract(struct zip_t* zip, size_t (*on_extract)(void* arg, uint64_t offset, const void* data, size_t size), void* arg) {
+    auto entry = zip->current;
+    if(!entry || entry->localOffset + 30 > zip->size)
+        return -1;
+    auto local = zip->data + entry->localOffset;
+    auto begin = entry->localOffset + 30 + Read16(local + 26) + Read16(local + 28);
+    if(begin + entry->compressedSize > zip->size)
+        return -1;
+    auto compressed = zip->data + begin;
+    uLong crc = crc32(0, nullptr, 0);
+    uint64_t written = 0;
+    auto emit = [&](const unsigned char* data, std::size_t size) {
+        crc = crc32(crc, data, size);
+        bool success = on_extract(arg, written, data, size) == size;
+        written += size;
+        return success;
+    };
+    if(entry->method == 0) {
+        for(uint64_t offset = 0; offset < entry->size; offset += CHUNK_SIZE) {
+            if(!emit(compressed + offset, std::min<uint64_t>(CHUNK_SIZE, entry->size - offset)))
+                return -1;
+        }
+    } else if(entry->method == Z_DEFLATED) {
+        z_stream stream{};
+        if(inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+            return -1;
+        stream.next_in = const_cast<Bytef*>(compressed);
+        stream.avail_in = entry->compressedSize;
+        std::vector<unsigned char> chunk(CHUNK_SIZE);
+        int result = Z_OK;
+        while(result == Z_OK) {
+            stream.next_out = chunk.data();
+            stream.avail_out = chunk.size();
+            result = inflate(&stream, Z_NO_FLUSH);
+            std::size_t produced = chunk.size() - stream.avail_out;
+            if((result != Z_OK && result != Z_STREAM_END) || (produced > 0 && !emit(chunk.data(), produced))) {
+                result = Z_DATA_ERROR;
+                break;
+            }
+        }
+        inflateEnd(&stream);
+        if(result != Z_STREAM_END)
+            return -1;
+    } else {
+        return -1;
+    }
+    return written == entry->size && crc == entry->crc ? 0 : -1;
+}
+
+ssize_t zip_entry_noallocread(struct zip_t* zip, void* buf, size_t bufsize) {
+    struct Buffer {
+        unsigned char* data;
+        std::size_t size;
+    } buffer = { static_cast<unsigned char*>(buf), bufsize };
+    auto copy = [](void* arg, uint64_t offset, const void* data, size_t size) -> size_t {
+        auto buffer = static_cast<Buffer*>(arg);
+        if(offset + size > buffer->size)
+            return 0;
+        std::memcpy(buffer->data + offset, data, size);
+        return size;
+    };
+    if(!zip->current || zip_entry_extract(zip, copy, &buffer) < 0)
+        return -1;
+    return zip->current->size;
+}
+
+}
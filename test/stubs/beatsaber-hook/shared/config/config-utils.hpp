@@ -0,0 +1,12 @@
+#pragma once
+// Host stand-in, the tests never read the config and keep their data in the temp directory
+#include "modloader/shared/modloader.hpp"
+
+#include <filesystem>
+#include <string>
+
+class Configuration;
+
+inline std::string getDataDir(const ModInfo& info) {
+    return (std::filesystem::temp_directory_path() / "cinema_tests" / info.id).string() + "/";
+}
@@ -0,0 +1,2 @@
+#pragma once
+// Host stand-in, nothing is hooked off the Quest
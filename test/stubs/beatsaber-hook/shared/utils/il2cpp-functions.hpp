@@ -0,0 +1,16 @@
+#pragma once
+// Host stand-in for the icall lookup, only the icalls the host tests go through resolve
+#include "UnityEngine/Texture2D.hpp"
+
+#include <string_view>
+
+template<typename R, typename... TArgs>
+using function_ptr_t = R(*)(TArgs...);
+
+struct il2cpp_functions {
+    static void* resolve_icall(const char* name) {
+        if(std::string_view(name) == "UnityEngine.Texture2D::LoadRawTextureDataImpl")
+            return reinterpret_cast<void*>(&UnityEngine::Texture2D::LoadRawTextureData);
+        return nullptr;
+    }
+};
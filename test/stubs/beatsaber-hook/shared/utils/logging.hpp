@@ -0,0 +1,2 @@
+#pragma once
+#include "beatsaber-hook/shared/utils/utils.h"
@@ -0,0 +1,30 @@
+#pragma once
+// Host stand-in for the beatsaber-hook event type
+#include <functional>
+#include <vector>
+
+template<typename... TArgs>
+class UnorderedEventCallback {
+    public:
+        UnorderedEventCallback& operator+=(std::function<void(TArgs...)> callback) {
+            callbacks.emplace_back(std::move(callback));
+            return *this;
+        }
+        /// Like beatsaber-hook, removes the first callback of the same type
+        UnorderedEventCallback& operator-=(const std::function<void(TArgs...)>& callback) {
+            for(auto itr = callbacks.begin(); itr != callbacks.end(); itr++) {
+                if(itr->target_type() == callback.target_type()) {
+                    callbacks.erase(itr);
+                    break;
+                }
+            }
+            return *this;
+        }
+        void invoke(TArgs... args) {
+            for(auto& callback : callbacks)
+                callback(args...);
+        }
+
+    private:
+        std::vector<std::function<void(TArgs...)>> callbacks;
+};
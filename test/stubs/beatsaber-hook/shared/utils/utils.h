@@ -0,0 +1,50 @@
+#pragma once
+// Host stand-in for the beatsaber-hook logger and file helpers, errors go to stderr and the rest is dropped
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+class Logger {
+    public:
+        template<typename... TArgs>
+        void info(const char* format, TArgs... args) { if(verbose) Print(stdout, format, args...); }
+        template<typename... TArgs>
+        void debug(const char*, TArgs...) {}
+        template<typename... TArgs>
+        void warning(const char* format, TArgs... args) { Print(stderr, format, args...); }
+        template<typename... TArgs>
+        void error(const char* format, TArgs... args) { Print(stderr, format, args...); }
+
+        bool verbose = false;
+
+    private:
+        template<typename... TArgs>
+        static void Print(std::FILE* file, const char* format, TArgs... args) {
+            if constexpr(sizeof...(TArgs) == 0)
+                std::fputs(format, file);
+            else
+                std::fprintf(file, format, args...);
+            std::fputc('\n', file);
+        }
+};
+
+template<typename... TArgs>
+std::string string_format(std::string_view format, TArgs... args) {
+    std::string formatString(format);
+    std::string result(std::snprintf(nullptr, 0, formatString.c_str(), args...), '\0');
+    std::snprintf(result.data(), result.size() + 1, formatString.c_str(), args...);
+    return result;
+}
+
+inline bool fileexists(std::string_view path) { return std::filesystem::is_regular_file(path); }
+inline bool direxists(std::string_view path) { return std::filesystem::is_directory(path); }
+inline int mkpath(std::string_view path) {
+    std::error_code error;
+    std::filesystem::create_directories(path, error);
+    return error ? -1 : 0;
+}
+inline bool deletefile(std::string_view path) {
+    std::error_code error;
+    return std::filesystem::remove(path, error);
+}
@@ -0,0 +1,5 @@
+#pragma once
+// Host stand-in for the mod's main header, only the logger is needed off the Quest
+#include "beatsaber-hook/shared/utils/utils.h"
+
+Logger& getLogger();
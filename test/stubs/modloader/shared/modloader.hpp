@@ -0,0 +1,8 @@
+#pragma once
+// Host stand-in, only the mod info is used off the Quest
+#include <string>
+
+struct ModInfo {
+    std::string id;
+    std::string version;
+};
@@ -0,0 +1,30 @@
+#pragma once
+// Host stand-in for the QuestUI scheduler, the test's main loop plays the Unity main thread by calling RunQueued
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace QuestUI {
+    class MainThreadScheduler {
+        public:
+            static void Schedule(std::function<void()> callback) {
+                std::lock_guard<std::mutex> lock(mutex);
+                callbacks.emplace_back(std::move(callback));
+            }
+
+            /// Runs everything scheduled so far on the calling thread
+            static void RunQueued() {
+                std::vector<std::function<void()>> queued;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    queued.swap(callbacks);
+                }
+                for(auto& callback : queued)
+                    callback();
+            }
+
+        private:
+            static inline std::mutex mutex;
+            static inline std::vector<std::function<void()>> callbacks;
+    };
+}
@@ -0,0 +1,79 @@
+#pragma once
+// Host stand-in for the song-details header, the same declarations without the package
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+#include <fmt/format.h>
+namespace SongDetailsCache {
+    namespace Structs { class SongProto; class SongDifficultyProto; }
+    enum class RankedStatus : uint8_t { Unranked = 0, Ranked = 1, Qualified = 2, Queued = 3 };
+    enum class MapCharacteristic : uint8_t { Custom = 0, Standard = 1, OneSaber = 2, NoArrows = 3, NinetyDegree = 4, ThreeSixtyDegree = 5, LightShow = 6, Lawless = 7 };
+    enum class MapDifficulty : uint8_t { Easy = 0, Normal, Hard, Expert, ExpertPlus };
+    enum class MapMods : uint8_t { None = 0, NoodleExtensions = 1, MappingExtensions = 2, Chroma = 4, Cinema = 8 };
+    bool parse(std::string_view s, MapCharacteristic& c);
+    struct Song;
+    struct SongDifficulty {
+        const std::size_t songIndex;
+        const MapCharacteristic characteristic;
+        const MapDifficulty difficulty;
+        const float stars;
+        const float njs;
+        const uint32_t bombs;
+        const uint32_t notes;
+        const uint32_t obstacles;
+        const MapMods mods;
+        static const SongDifficulty none;
+        bool ranked() const noexcept { return stars > 0; }
+        float approximatePpValue() const noexcept { return stars * 40.0f; }
+        const Song& song() const noexcept;
+        SongDifficulty(std::size_t songIndex, const Structs::SongDifficultyProto* proto) noexcept;
+    };
+    struct Song {
+        using difficulty_const_iterator = std::vector<SongDifficulty>::const_iterator;
+        const std::size_t index;
+        const std::size_t diffOffset;
+        const uint8_t diffCount;
+        const float bpm;
+        const uint32_t downloadCount;
+        const uint32_t upvotes;
+        const uint32_t downvotes;
+        const uint32_t uploadTimeUnix;
+        const uint32_t rankedChangeUnix;
+        const uint32_t songDurationSeconds;
+        const RankedStatus rankedStatus;
+        static const Song none;
+        float min(std::function<float(const SongDifficulty&)> func) const;
+        float max(std::function<float(const SongDifficulty&)> func) const;
+        float rating() const noexcept;
+        float minNJS() const noexcept;
+        float maxNJS() const noexcept;
+        float minStar() const noexcept;
+        float maxStar() const noexcept;
+        float minPP() const noexcept;
+        float maxPP() const noexcept;
+        std::chrono::sys_time<std::chrono::seconds> uploadTime() const noexcept;
+        std::chrono::seconds songDuration() const noexcept;
+        std::string key() const noexcept;
+        uint32_t mapId() const noexcept;
+        std::string hash() const noexcept;
+        const std::string& songName() const noexcept;
+        const std::string& songAuthorName() const noexcept;
+        const std::string& levelAuthorName() const noexcept;
+        const std::string& uploaderName() const noexcept;
+        std::string coverURL() const noexcept;
+        bool GetDifficulty(const SongDifficulty*& outDiff, MapDifficulty diff, MapCharacteristic characteristic = MapCharacteristic::Standard) const noexcept;
+        bool GetDifficulty(const SongDifficulty*& outDiff, MapDifficulty diff, std::string_view characteristic) const noexcept;
+        const SongDifficulty& GetDifficulty(MapDifficulty diff, MapCharacteristic characteristic = MapCharacteristic::Standard) const noexcept;
+        const SongDifficulty& GetDifficulty(MapDifficulty diff, std::string_view characteristic) const noexcept;
+        difficulty_const_iterator begin() const noexcept;
+        difficulty_const_iterator end() const noexcept;
+        Song(std::size_t index, std::size_t diffOffset, uint8_t diffCount, const Structs::SongProto* proto) noexcept;
+    };
+}
@@ -0,0 +1,26 @@
+#pragma once
+// Host stand-in for the song-details header
+#include "Data/Song.hpp"
+#include "beatsaber-hook/shared/utils/typedefs-wrappers.hpp"
+#include <future>
+#include <filesystem>
+namespace SongDetailsCache {
+    class SongDetails {
+        public:
+            using DifficultyFilterFunction = std::function<bool(const SongDifficulty&)>;
+            static std::future<SongDetails*> Init();
+            static std::future<SongDetails*> Init(int refreshIfOlderThanHours);
+            static void SetCacheDirectory(std::filesystem::path path);
+            static UnorderedEventCallback<> dataAvailableOrUpdated;
+            static UnorderedEventCallback<> dataLoadFailed;
+            const std::vector<std::size_t> FindSongIndexes(const DifficultyFilterFunction& check) const;
+            const std::vector<const Song*> FindSongs(const DifficultyFilterFunction& check) const;
+            std::size_t CountSongs(const DifficultyFilterFunction& check) const;
+        private:
+            SongDetails() noexcept;
+            static SongDetails instance;
+            static bool isLoading;
+            static void DataAvailableOrUpdated();
+            static void DataLoadFailed();
+    };
+}